@@ -40,16 +40,42 @@
 
 A3_INLINE a3ret a3vertexAttribGetElementsPerAttrib(const a3_VertexAttributeType attribType)
 {
-	static const a3byte elementsPerAttrib[] = { 0, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4 };
+	static const a3byte elementsPerAttrib[] = { 0, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4, 4, 4, 2, 2, 4 };
 	return elementsPerAttrib[attribType];
 }
 
 A3_INLINE a3ret a3vertexAttribGetBytesPerElement(const a3_VertexAttributeType attribType)
 {
-	static const a3byte bytesPerElement[] = { 0, 4, 4, 4, 4, 4, 4, 4, 4, 8, 8, 8, 8 };
+	static const a3byte bytesPerElement[] = { 0, 4, 4, 4, 4, 4, 4, 4, 4, 8, 8, 8, 8, 2, 2, 2, 2, 1 };
 	return bytesPerElement[attribType];
 }
 
+A3_INLINE a3ret a3vertexAttribGetPackedSourceSize(const a3_VertexAttributeType attribType)
+{
+	static const a3byte packedSourceSize[] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 12, 12, 12, 8, 16 };
+	return packedSourceSize[attribType];
+}
+
+A3_INLINE a3ret a3vertexAttribEncodeOctahedral(float encoded_out[2], const float v[3])
+{
+	if (encoded_out && v)
+	{
+		// project onto the octahedron, then fold the lower half outward
+		const float x = v[0] >= 0.0f ? v[0] : -v[0], y = v[1] >= 0.0f ? v[1] : -v[1], z = v[2] >= 0.0f ? v[2] : -v[2];
+		const float s = (x + y + z) > 0.0f ? 1.0f / (x + y + z) : 0.0f;
+		encoded_out[0] = v[0] * s;
+		encoded_out[1] = v[1] * s;
+		if (v[2] < 0.0f)
+		{
+			const float ex = 1.0f - y * s, ey = 1.0f - x * s;
+			encoded_out[0] = v[0] >= 0.0f ? ex : -ex;
+			encoded_out[1] = v[1] >= 0.0f ? ey : -ey;
+		}
+		return 1;
+	}
+	return -1;
+}
+
 A3_INLINE a3ret a3indexGetBytesPerIndex(const a3_IndexType indexType)
 {
 	static const a3byte bytesPerIndex[] = { 0, 1, 2, 4 };
@@ -76,6 +76,7 @@ extern "C"
 	//	param attribRawData: non-null array of vertex attribute data; should 
 	//		be aligned with the attributes described in the format descriptor
 	//		NOTE: THE DATA IS NOT INTERLEAVED; THIS FUNCTION DOES THAT FOR YOU!
+	//		packed attribute types take float data and are encoded here
 	//	param vertexCount: how many instances of this vertex (non-zero)
 	//	param offset_out_opt: optional pointer to get this storage's offset
 	//	return: size of data stored if success
@@ -123,6 +123,15 @@ extern "C"
 		a3attrib_dvec2,		// 2D double vector
 		a3attrib_dvec3,		// 3D double vector
 		a3attrib_dvec4,		// 4D double vector
+
+		// packed types: data is provided as floats and encoded when stored; 
+		//	all but octvec3 read as plain float vectors in shaders
+		a3attrib_hvec3,			// 3D float vector as 4 half floats (w = 1)
+		a3attrib_snorm16vec3,	// 3D unit vector as 4 signed normalized shorts (w = 0)
+		a3attrib_octvec3,		// 3D unit vector octahedral-encoded as 2 signed normalized 
+								//	shorts; decode in shader (see a3vertexAttribEncodeOctahedral)
+		a3attrib_unorm16vec2,	// 2D float vector in [0, 1] as 2 unsigned normalized shorts
+		a3attrib_unorm8vec4,	// 4D float vector in [0, 1] as 4 unsigned normalized bytes
 	};
 
 
@@ -208,6 +217,22 @@ extern "C"
 	//	return: number of bytes for a single element of this attribute
 	a3ret a3vertexAttribGetBytesPerElement(const a3_VertexAttributeType attribType);
 
+	// A3: Get the number of bytes of the float data a packed attribute type 
+	//		is encoded from.
+	//	param attribType: data type used to describe attribute
+	//	return: number of source bytes per attribute if type is packed
+	//	return: 0 if attribute is stored as provided
+	a3ret a3vertexAttribGetPackedSourceSize(const a3_VertexAttributeType attribType);
+
+	// A3: Encode a float 3D unit vector as octahedral coordinates in 
+	//		[-1, 1]; to decode: v = (e.x, e.y, 1 - |e.x| - |e.y|), 
+	//		t = max(-v.z, 0), v.xy -= sign(v.xy) * t, normalize(v).
+	//	param encoded_out: non-null pointer to 2 floats to store result
+	//	param v: non-null pointer to 3 floats of unit vector
+	//	return: 1 if success
+	//	return: -1 if invalid params
+	a3ret a3vertexAttribEncodeOctahedral(float encoded_out[2], const float v[3]);
+
 	// A3: Get the number of bytes per index of specified type.
 	//	param indexType: data type used to describe index
 	//	return: number of bytes contained in an index
@@ -0,0 +1,244 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3randomstream_impl.inl
+	Implementation of random number streams.
+*/
+
+#ifdef __ANIMAL3D_A3DM_RANDOM_H
+#ifndef __ANIMAL3D_A3DM_RANDOMSTREAM_IMPL_INL
+#define __ANIMAL3D_A3DM_RANDOMSTREAM_IMPL_INL
+
+
+#include <math.h>
+
+// bulk fill steps all four lanes at once with SSE2 when reals are single 
+//	precision (always available on x64)
+#if ((defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__) && !(defined A3_REAL_F64 || defined A3_REAL_F128))
+#define A3_RANDOMSTREAM_SSE
+#include <emmintrin.h>
+#endif	// SSE2
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal
+
+// 24 random bits to [0, 1)
+#define a3randomStreamInternalToNormalized(x)	((a3real)((x) >> 8) * (a3real)(1.0 / 16777216.0))
+
+static inline a3ui32 a3randomStreamInternalRotate(const a3ui32 x, const a3ui32 k)
+{
+	return ((x << k) | (x >> (32 - k)));
+}
+
+// advance all lanes one step, filling the buffer
+static inline void a3randomStreamInternalStep(a3_RandomStream *stream)
+{
+	a3ui32 (*const s)[4] = stream->state;
+	a3ui32 j, t;
+	for (j = 0; j < 4; ++j)
+	{
+		stream->buffer[j] = a3randomStreamInternalRotate(s[0][j] + s[3][j], 7) + s[0][j];
+		t = s[1][j] << 9;
+		s[2][j] ^= s[0][j];
+		s[3][j] ^= s[1][j];
+		s[1][j] ^= s[2][j];
+		s[0][j] ^= s[3][j];
+		s[2][j] ^= t;
+		s[3][j] = a3randomStreamInternalRotate(s[3][j], 11);
+	}
+	stream->used = 0;
+}
+
+// seed expansion
+static inline a3ui64 a3randomStreamInternalSplitMix(a3ui64 *x)
+{
+	a3ui64 z = (*x += 0x9e3779b97f4a7c15ull);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+	return (z ^ (z >> 31));
+}
+
+
+//-----------------------------------------------------------------------------
+
+static inline a3_RandomStream *a3randomStreamInit(a3_RandomStream *stream_out, const a3ui64 seed)
+{
+	a3ui64 x = seed, z;
+	a3ui32 i, j;
+	for (j = 0; j < 4; ++j)
+		for (i = 0; i < 4; i += 2)
+		{
+			z = a3randomStreamInternalSplitMix(&x);
+			stream_out->state[i][j] = (a3ui32)z;
+			stream_out->state[i + 1][j] = (a3ui32)(z >> 32);
+		}
+	stream_out->used = 4;
+	return stream_out;
+}
+
+static inline a3_RandomStream *a3randomStreamInitIndexed(a3_RandomStream *stream_out, const a3ui64 seed, const a3ui32 streamIndex)
+{
+	a3ui32 i;
+	a3randomStreamInit(stream_out, seed);
+	for (i = 0; i < streamIndex; ++i)
+		a3randomStreamJump(stream_out);
+	return stream_out;
+}
+
+static inline a3_RandomStream *a3randomStreamJump(a3_RandomStream *stream)
+{
+	static const a3ui32 jump[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+	a3ui32 s[4][4] = { 0 };
+	a3ui32 i, b, j, k;
+	for (i = 0; i < 4; ++i)
+		for (b = 0; b < 32; ++b)
+		{
+			if (jump[i] & (1u << b))
+				for (k = 0; k < 4; ++k)
+					for (j = 0; j < 4; ++j)
+						s[k][j] ^= stream->state[k][j];
+			a3randomStreamInternalStep(stream);
+		}
+	for (k = 0; k < 4; ++k)
+		for (j = 0; j < 4; ++j)
+			stream->state[k][j] = s[k][j];
+	stream->used = 4;
+	return stream;
+}
+
+static inline a3ui32 a3randomStreamInt(a3_RandomStream *stream)
+{
+	if (stream->used >= 4)
+		a3randomStreamInternalStep(stream);
+	return stream->buffer[stream->used++];
+}
+
+static inline a3real a3randomStreamNormalized(a3_RandomStream *stream)
+{
+	const a3ui32 x = a3randomStreamInt(stream);
+	return a3randomStreamInternalToNormalized(x);
+}
+
+static inline a3real a3randomStreamSymmetric(a3_RandomStream *stream)
+{
+	return (a3randomStreamNormalized(stream) * a3real_two - a3real_one);
+}
+
+static inline a3real a3randomStreamRange(a3_RandomStream *stream, const a3real nMin, const a3real nMax)
+{
+	return (nMin + (nMax - nMin) * a3randomStreamNormalized(stream));
+}
+
+static inline a3integer a3randomStreamRangeInt(a3_RandomStream *stream, const a3integer nMin, const a3integer nMax)
+{
+	// scale 32 random bits to the range width
+	const a3ui64 x = (a3ui64)a3randomStreamInt(stream) * (a3ui64)(a3ui32)(nMax - nMin);
+	return (nMin + (a3integer)(x >> 32));
+}
+
+static inline a3real a3randomStreamGaussian(a3_RandomStream *stream, const a3real mean, const a3real stddev)
+{
+	const a3real u0 = a3real_one - a3randomStreamNormalized(stream), u1 = a3randomStreamNormalized(stream);
+	return (mean + stddev * (a3real)(sqrt(-2.0 * log((double)u0)) * cos(a3real_twopi * (double)u1)));
+}
+
+static inline a3count a3randomStreamFillNormalized(a3_RandomStream *stream, a3real *values_out, const a3count count)
+{
+	a3count i = 0;
+
+	// finish the current step so the vector loop starts on lane 0
+	while (i < count && stream->used < 4)
+		values_out[i++] = a3randomStreamNormalized(stream);
+
+#ifdef A3_RANDOMSTREAM_SSE
+	if (i + 4 <= count)
+	{
+		__m128i s0 = _mm_loadu_si128((__m128i const *)stream->state[0]);
+		__m128i s1 = _mm_loadu_si128((__m128i const *)stream->state[1]);
+		__m128i s2 = _mm_loadu_si128((__m128i const *)stream->state[2]);
+		__m128i s3 = _mm_loadu_si128((__m128i const *)stream->state[3]);
+		__m128i r, t;
+		const __m128 scale = _mm_set1_ps((a3real)(1.0 / 16777216.0));
+		for (; i + 4 <= count; i += 4)
+		{
+			r = _mm_add_epi32(s0, s3);
+			r = _mm_add_epi32(_mm_or_si128(_mm_slli_epi32(r, 7), _mm_srli_epi32(r, 25)), s0);
+			t = _mm_slli_epi32(s1, 9);
+			s2 = _mm_xor_si128(s2, s0);
+			s3 = _mm_xor_si128(s3, s1);
+			s1 = _mm_xor_si128(s1, s2);
+			s0 = _mm_xor_si128(s0, s3);
+			s2 = _mm_xor_si128(s2, t);
+			s3 = _mm_or_si128(_mm_slli_epi32(s3, 11), _mm_srli_epi32(s3, 21));
+			_mm_storeu_ps(values_out + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(r, 8)), scale));
+		}
+		_mm_storeu_si128((__m128i *)stream->state[0], s0);
+		_mm_storeu_si128((__m128i *)stream->state[1], s1);
+		_mm_storeu_si128((__m128i *)stream->state[2], s2);
+		_mm_storeu_si128((__m128i *)stream->state[3], s3);
+	}
+#endif	// A3_RANDOMSTREAM_SSE
+
+	for (; i < count; ++i)
+		values_out[i] = a3randomStreamNormalized(stream);
+	return count;
+}
+
+static inline a3count a3randomStreamFillRange(a3_RandomStream *stream, a3real *values_out, const a3count count, const a3real nMin, const a3real nMax)
+{
+	const a3real d = nMax - nMin;
+	a3count i;
+	a3randomStreamFillNormalized(stream, values_out, count);
+	for (i = 0; i < count; ++i)
+		values_out[i] = nMin + d * values_out[i];
+	return count;
+}
+
+static inline a3count a3randomStreamFillGaussian(a3_RandomStream *stream, a3real *values_out, const a3count count, const a3real mean, const a3real stddev)
+{
+	double r, a;
+	a3count i;
+	a3randomStreamFillNormalized(stream, values_out, count);
+	for (i = 0; i < count; i += 2)
+	{
+		// odd count: last pair takes its second number from the stream
+		r = sqrt(-2.0 * log(1.0 - (double)values_out[i]));
+		a = a3real_twopi * (double)(i + 1 < count ? values_out[i + 1] : a3randomStreamNormalized(stream));
+		values_out[i] = mean + stddev * (a3real)(r * cos(a));
+		if (i + 1 < count)
+			values_out[i + 1] = mean + stddev * (a3real)(r * sin(a));
+	}
+	return count;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_RANDOMSTREAM_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_RANDOM_H
@@ -0,0 +1,292 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3statsstream_impl.inl
+	Implementation of online statistics.
+*/
+
+#ifdef __ANIMAL3D_A3DM_STATS_H
+#ifndef __ANIMAL3D_A3DM_STATSSTREAM_IMPL_INL
+#define __ANIMAL3D_A3DM_STATSSTREAM_IMPL_INL
+
+
+#include <math.h>
+
+
+A3_BEGIN_IMPL
+
+
+//-----------------------------------------------------------------------------
+// internal
+
+// histogram bucket for value
+static inline a3ui32 a3statsHistogramInternalBucket(const a3ui64 x)
+{
+	a3ui32 h = 0, shift;
+	a3ui64 v = x;
+	if (x < a3statsHistogram_subCount)
+		return (a3ui32)x;
+
+	// highest set bit
+	if (v >> 32) { v >>= 32; h += 32; }
+	if (v >> 16) { v >>= 16; h += 16; }
+	if (v >> 8) { v >>= 8; h += 8; }
+	if (v >> 4) { v >>= 4; h += 4; }
+	if (v >> 2) { v >>= 2; h += 2; }
+	if (v >> 1) { h += 1; }
+
+	// keep the top sub-bits - 1 bits below the leading one
+	shift = h - (a3statsHistogram_subBits - 1);
+	return (a3statsHistogram_subCount + (shift - 1) * (a3statsHistogram_subCount / 2) + 
+		(a3ui32)(x >> shift) - (a3statsHistogram_subCount / 2));
+}
+
+// middle value of histogram bucket
+static inline a3ui64 a3statsHistogramInternalBucketValue(const a3ui32 index)
+{
+	a3ui32 j, shift;
+	if (index < a3statsHistogram_subCount)
+		return index;
+	j = index - a3statsHistogram_subCount;
+	shift = j / (a3statsHistogram_subCount / 2) + 1;
+	return ((((a3ui64)(a3statsHistogram_subCount / 2 + j % (a3statsHistogram_subCount / 2))) << shift) + ((a3ui64)1 << (shift - 1)));
+}
+
+// P-square marker adjustment: parabolic prediction, linear if it would 
+//	break marker order
+static inline void a3statsQuantileInternalAdjust(a3_StatsQuantile *quantile, const a3ui32 i)
+{
+	a3f64 *const q = quantile->height, *const n = quantile->position;
+	const a3f64 d = quantile->desired[i] - n[i];
+	a3f64 s, h;
+	if ((d >= 1.0 && n[i + 1] - n[i] > 1.0) || (d <= -1.0 && n[i - 1] - n[i] < -1.0))
+	{
+		s = d > 0.0 ? 1.0 : -1.0;
+		h = q[i] + s / (n[i + 1] - n[i - 1]) * 
+			((n[i] - n[i - 1] + s) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) + 
+			(n[i + 1] - n[i] - s) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+		if (q[i - 1] < h && h < q[i + 1])
+			q[i] = h;
+		else if (s > 0.0)
+			q[i] += (q[i + 1] - q[i]) / (n[i + 1] - n[i]);
+		else
+			q[i] -= (q[i - 1] - q[i]) / (n[i - 1] - n[i]);
+		n[i] += s;
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+
+static inline a3_StatsAccumulator *a3statsAccumulatorReset(a3_StatsAccumulator *acc_out)
+{
+	acc_out->count = 0;
+	acc_out->mean = acc_out->m2 = 0.0;
+	acc_out->min = HUGE_VAL;
+	acc_out->max = -HUGE_VAL;
+	return acc_out;
+}
+
+static inline a3_StatsAccumulator *a3statsAccumulatorAdd(a3_StatsAccumulator *acc, const a3f64 x)
+{
+	const a3f64 d = x - acc->mean;
+	acc->mean += d / (a3f64)(++acc->count);
+	acc->m2 += d * (x - acc->mean);
+	if (x < acc->min)
+		acc->min = x;
+	if (x > acc->max)
+		acc->max = x;
+	return acc;
+}
+
+static inline a3_StatsAccumulator *a3statsAccumulatorMerge(a3_StatsAccumulator *acc, const a3_StatsAccumulator *other)
+{
+	if (other->count)
+	{
+		const a3bigcount count = acc->count + other->count;
+		const a3f64 d = other->mean - acc->mean;
+		acc->mean += d * (a3f64)other->count / (a3f64)count;
+		acc->m2 += other->m2 + d * d * (a3f64)acc->count * (a3f64)other->count / (a3f64)count;
+		acc->count = count;
+		if (other->min < acc->min)
+			acc->min = other->min;
+		if (other->max > acc->max)
+			acc->max = other->max;
+	}
+	return acc;
+}
+
+static inline a3f64 a3statsAccumulatorVariance(const a3_StatsAccumulator *acc)
+{
+	return (acc->count > 1 ? acc->m2 / (a3f64)(acc->count - 1) : 0.0);
+}
+
+static inline a3f64 a3statsAccumulatorStandardDeviation(const a3_StatsAccumulator *acc)
+{
+	return sqrt(a3statsAccumulatorVariance(acc));
+}
+
+
+//-----------------------------------------------------------------------------
+
+static inline a3_StatsQuantile *a3statsQuantileReset(a3_StatsQuantile *quantile_out, const a3f64 p)
+{
+	a3ui32 i;
+	for (i = 0; i < 5; ++i)
+	{
+		quantile_out->height[i] = 0.0;
+		quantile_out->position[i] = (a3f64)i;
+	}
+	quantile_out->desired[0] = 0.0;
+	quantile_out->desired[1] = 2.0 * p;
+	quantile_out->desired[2] = 4.0 * p;
+	quantile_out->desired[3] = 2.0 + 2.0 * p;
+	quantile_out->desired[4] = 4.0;
+	quantile_out->increment[0] = 0.0;
+	quantile_out->increment[1] = 0.5 * p;
+	quantile_out->increment[2] = p;
+	quantile_out->increment[3] = 0.5 + 0.5 * p;
+	quantile_out->increment[4] = 1.0;
+	quantile_out->p = p;
+	quantile_out->count = 0;
+	return quantile_out;
+}
+
+static inline a3_StatsQuantile *a3statsQuantileAdd(a3_StatsQuantile *quantile, const a3f64 x)
+{
+	a3f64 *const q = quantile->height;
+	a3ui32 i, k;
+
+	// first five samples are kept sorted
+	if (quantile->count < 5)
+	{
+		for (i = (a3ui32)quantile->count++; i > 0 && q[i - 1] > x; --i)
+			q[i] = q[i - 1];
+		q[i] = x;
+		return quantile;
+	}
+	++quantile->count;
+
+	// find cell, extending the extremes
+	if (x < q[0])
+	{
+		q[0] = x;
+		k = 0;
+	}
+	else if (x >= q[4])
+	{
+		q[4] = x;
+		k = 3;
+	}
+	else
+		for (k = 0; x >= q[k + 1]; ++k);
+
+	// shift positions above the cell, then move the middle markers
+	for (i = k + 1; i < 5; ++i)
+		quantile->position[i] += 1.0;
+	for (i = 0; i < 5; ++i)
+		quantile->desired[i] += quantile->increment[i];
+	for (i = 1; i < 4; ++i)
+		a3statsQuantileInternalAdjust(quantile, i);
+	return quantile;
+}
+
+static inline a3f64 a3statsQuantileGet(const a3_StatsQuantile *quantile)
+{
+	a3ui32 i;
+	if (quantile->count > 5)
+		return quantile->height[2];
+	if (quantile->count == 0)
+		return 0.0;
+
+	// nearest rank among the stored samples
+	i = (a3ui32)(quantile->p * (a3f64)quantile->count + 0.5);
+	return quantile->height[i > 0 ? i - 1 : 0];
+}
+
+
+//-----------------------------------------------------------------------------
+
+static inline a3_StatsHistogram *a3statsHistogramReset(a3_StatsHistogram *histogram_out)
+{
+	a3ui32 i;
+	for (i = 0; i < a3statsHistogram_bucketCount; ++i)
+		histogram_out->bucket[i] = 0;
+	histogram_out->count = 0;
+	histogram_out->min = ~(a3ui64)0;
+	histogram_out->max = 0;
+	return histogram_out;
+}
+
+static inline a3_StatsHistogram *a3statsHistogramAdd(a3_StatsHistogram *histogram, const a3ui64 x)
+{
+	++histogram->bucket[a3statsHistogramInternalBucket(x)];
+	++histogram->count;
+	if (x < histogram->min)
+		histogram->min = x;
+	if (x > histogram->max)
+		histogram->max = x;
+	return histogram;
+}
+
+static inline a3_StatsHistogram *a3statsHistogramMerge(a3_StatsHistogram *histogram, const a3_StatsHistogram *other)
+{
+	a3ui32 i;
+	for (i = 0; i < a3statsHistogram_bucketCount; ++i)
+		histogram->bucket[i] += other->bucket[i];
+	histogram->count += other->count;
+	if (other->min < histogram->min)
+		histogram->min = other->min;
+	if (other->max > histogram->max)
+		histogram->max = other->max;
+	return histogram;
+}
+
+static inline a3ui64 a3statsHistogramPercentile(const a3_StatsHistogram *histogram, const a3f64 p)
+{
+	a3bigcount rank, sum = 0;
+	a3ui64 value;
+	a3ui32 i;
+	if (!histogram->count)
+		return 0;
+
+	// rank of the sample at the percentile, in [1, count]
+	rank = (a3bigcount)ceil(p * (a3f64)histogram->count);
+	if (rank <= 1)
+		return histogram->min;
+	if (rank >= histogram->count)
+		return histogram->max;
+	for (i = 0; i < a3statsHistogram_bucketCount; ++i)
+		if ((sum += histogram->bucket[i]) >= rank)
+			break;
+	value = a3statsHistogramInternalBucketValue(i);
+	return (value < histogram->min ? histogram->min : value > histogram->max ? histogram->max : value);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+A3_END_IMPL
+
+
+#endif	// !__ANIMAL3D_A3DM_STATSSTREAM_IMPL_INL
+#endif	// __ANIMAL3D_A3DM_STATS_H
@@ -36,6 +36,29 @@
 A3_BEGIN_DECL
 
 
+//-----------------------------------------------------------------------------
+
+#ifndef __cplusplus
+typedef struct a3_RandomStream	a3_RandomStream;
+#endif	// !__cplusplus
+
+
+// A3: Random number stream: explicit generator state with no globals, so 
+//		each thread or job can own one; the same seed and stream index give 
+//		the same numbers on any thread count and instruction set.
+//	Generator is xoshiro128++ run as four interleaved lanes (period 2^128 
+//		per lane); numbers come out lane 0, 1, 2, 3, then the next step.
+struct a3_RandomStream
+{
+	// lane state: word i of lane j is state[i][j]
+	a3ui32 state[4][4];
+
+	// outputs of the last step and how many have been used
+	a3ui32 buffer[4];
+	a3ui32 used;
+};
+
+
 //-----------------------------------------------------------------------------
 
 // A3: Get maximum random number.
@@ -94,6 +117,97 @@ A3_INLINE a3real a3randomRange(const a3real nMin, const a3real nMax);
 A3_INLINE a3integer a3randomRangeInt(const a3integer nMin, const a3integer nMax);
 
 
+//-----------------------------------------------------------------------------
+// random number streams (implemented static inline; not part of the 
+//	precompiled library, so available in both open and closed source 
+//	builds, and each translation unit keeps its own copy)
+
+// A3: Initialize random stream from seed.
+//	param stream_out: stream to initialize
+//	param seed: seed; any value, including zero, is valid
+//	return: stream_out
+static inline a3_RandomStream *a3randomStreamInit(a3_RandomStream *stream_out, const a3ui64 seed);
+
+// A3: Initialize one of many independent streams from a shared seed; stream 
+//		i starts 2^64 steps after stream i-1, so streams never overlap in 
+//		practice; use e.g. the thread or job index.
+//	param stream_out: stream to initialize
+//	param seed: seed shared by all streams
+//	param streamIndex: index of this stream
+//	return: stream_out
+static inline a3_RandomStream *a3randomStreamInitIndexed(a3_RandomStream *stream_out, const a3ui64 seed, const a3ui32 streamIndex);
+
+// A3: Advance stream by 2^64 steps (jump ahead).
+//	param stream: stream to advance; unused buffered numbers are discarded
+//	return: stream
+static inline a3_RandomStream *a3randomStreamJump(a3_RandomStream *stream);
+
+// A3: Generate random unsigned integer.
+//	param stream: stream to draw from
+//	return: random integer in [0, 2^32)
+static inline a3ui32 a3randomStreamInt(a3_RandomStream *stream);
+
+// A3: Generate non-negative normalized random decimal number.
+//	param stream: stream to draw from
+//	return: random real number in [0, 1), 24 random bits
+static inline a3real a3randomStreamNormalized(a3_RandomStream *stream);
+
+// A3: Generate symmetric normalized random decimal number.
+//	param stream: stream to draw from
+//	return: random real number in [-1, 1)
+static inline a3real a3randomStreamSymmetric(a3_RandomStream *stream);
+
+// A3: Generate ranged random decimal number.
+//	param stream: stream to draw from
+//	param nMin: minimum real number in range
+//	param nMax: maximum real number in range
+//	return: random real number in [nMin, nMax)
+static inline a3real a3randomStreamRange(a3_RandomStream *stream, const a3real nMin, const a3real nMax);
+
+// A3: Generate ranged random integer.
+//	param stream: stream to draw from
+//	param nMin: minimum integer in range
+//	param nMax: maximum integer in range (greater than nMin)
+//	return: random integer in [nMin, nMax)
+static inline a3integer a3randomStreamRangeInt(a3_RandomStream *stream, const a3integer nMin, const a3integer nMax);
+
+// A3: Generate normally distributed random decimal number (Box-Muller; 
+//		draws two numbers from the stream).
+//	param stream: stream to draw from
+//	param mean: mean of distribution
+//	param stddev: standard deviation of distribution
+//	return: random real number
+static inline a3real a3randomStreamGaussian(a3_RandomStream *stream, const a3real mean, const a3real stddev);
+
+// A3: Fill array with normalized random decimal numbers; four lanes are 
+//		generated at once with SSE2; the values are the same as calling 
+//		a3randomStreamNormalized count times.
+//	param stream: stream to draw from
+//	param values_out: array of values to fill
+//	param count: number of values
+//	return: count
+static inline a3count a3randomStreamFillNormalized(a3_RandomStream *stream, a3real *values_out, const a3count count);
+
+// A3: Fill array with ranged random decimal numbers.
+//	param stream: stream to draw from
+//	param values_out: array of values to fill
+//	param count: number of values
+//	param nMin: minimum real number in range
+//	param nMax: maximum real number in range
+//	return: count
+static inline a3count a3randomStreamFillRange(a3_RandomStream *stream, a3real *values_out, const a3count count, const a3real nMin, const a3real nMax);
+
+// A3: Fill array with normally distributed random decimal numbers; each 
+//		pair of uniform numbers becomes a pair of normal numbers.
+//	param stream: stream to draw from
+//	param values_out: array of values to fill
+//	param count: number of values
+//	param mean: mean of distribution
+//	param stddev: standard deviation of distribution
+//	return: count
+static inline a3count a3randomStreamFillGaussian(a3_RandomStream *stream, a3real *values_out, const a3count count, const a3real mean, const a3real stddev);
+
+
 //-----------------------------------------------------------------------------
 
 
@@ -103,5 +217,6 @@ A3_END_DECL
 #ifdef A3_OPEN_SOURCE
 #include "_inl/a3random_impl.inl"
 #endif	// A3_OPEN_SOURCE
+#include "_inl/a3randomstream_impl.inl"
 
 #endif	// !__ANIMAL3D_A3DM_RANDOM_H
\ No newline at end of file
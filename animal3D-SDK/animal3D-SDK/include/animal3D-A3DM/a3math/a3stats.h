@@ -35,6 +35,54 @@
 A3_BEGIN_DECL
 
 
+//-----------------------------------------------------------------------------
+
+#ifndef __cplusplus
+typedef struct a3_StatsAccumulator	a3_StatsAccumulator;
+typedef struct a3_StatsQuantile		a3_StatsQuantile;
+typedef struct a3_StatsHistogram	a3_StatsHistogram;
+#endif	// !__cplusplus
+
+
+// A3: Histogram bucket layout: values below the sub-bucket count have one 
+//		bucket each; above that, each power of two is split into half as 
+//		many buckets, so every bucket spans at most 1/32 (about 3%) of its 
+//		values and the full 64-bit range fits in a fixed array.
+enum a3_StatsHistogramLayout
+{
+	a3statsHistogram_subBits = 6,
+	a3statsHistogram_subCount = 1 << a3statsHistogram_subBits,
+	a3statsHistogram_bucketCount = a3statsHistogram_subCount + (64 - a3statsHistogram_subBits) * (a3statsHistogram_subCount / 2),
+};
+
+
+// A3: Online count, mean, variance (Welford), minimum and maximum.
+struct a3_StatsAccumulator
+{
+	a3bigcount count;
+	a3f64 mean, m2;
+	a3f64 min, max;
+};
+
+// A3: Online estimate of one quantile (P-square algorithm: five markers 
+//		whose heights follow the quantile and its neighbors).
+struct a3_StatsQuantile
+{
+	a3f64 height[5], position[5], desired[5], increment[5];
+	a3f64 p;
+	a3bigcount count;
+};
+
+// A3: Fixed-size log-linear histogram of non-negative integer values 
+//		(e.g. durations in nanoseconds) for percentile queries.
+struct a3_StatsHistogram
+{
+	a3ui32 bucket[a3statsHistogram_bucketCount];
+	a3bigcount count;
+	a3ui64 min, max;
+};
+
+
 //-----------------------------------------------------------------------------
 // median, mean, variance, standard deviation (with options to return mean)
 
@@ -112,6 +160,84 @@ A3_INLINE a3biginteger a3permutations(const a3bigcount n, const a3bigindex k);
 A3_INLINE a3biginteger a3combinations(const a3bigcount n, const a3bigindex k);
 
 
+//-----------------------------------------------------------------------------
+// online statistics (implemented static inline; not part of the 
+//	precompiled library, so available in both open and closed source 
+//	builds, and each translation unit keeps its own copy)
+// each accumulator uses constant memory and costs O(1) per sample
+
+// A3: Reset accumulator.
+//	param acc_out: accumulator to reset
+//	return: acc_out
+static inline a3_StatsAccumulator *a3statsAccumulatorReset(a3_StatsAccumulator *acc_out);
+
+// A3: Add sample to accumulator.
+//	param acc: accumulator
+//	param x: sample value
+//	return: acc
+static inline a3_StatsAccumulator *a3statsAccumulatorAdd(a3_StatsAccumulator *acc, const a3f64 x);
+
+// A3: Merge another accumulator into accumulator (e.g. per-thread results).
+//	param acc: accumulator to merge into
+//	param other: accumulator to merge
+//	return: acc
+static inline a3_StatsAccumulator *a3statsAccumulatorMerge(a3_StatsAccumulator *acc, const a3_StatsAccumulator *other);
+
+// A3: Get sample variance of accumulated samples.
+//	param acc: accumulator
+//	return: variance (zero if fewer than two samples)
+static inline a3f64 a3statsAccumulatorVariance(const a3_StatsAccumulator *acc);
+
+// A3: Get sample standard deviation of accumulated samples.
+//	param acc: accumulator
+//	return: standard deviation (zero if fewer than two samples)
+static inline a3f64 a3statsAccumulatorStandardDeviation(const a3_StatsAccumulator *acc);
+
+
+// A3: Reset quantile estimator.
+//	param quantile_out: estimator to reset
+//	param p: quantile to track in (0, 1), e.g. 0.5 for median, 0.99
+//	return: quantile_out
+static inline a3_StatsQuantile *a3statsQuantileReset(a3_StatsQuantile *quantile_out, const a3f64 p);
+
+// A3: Add sample to quantile estimator.
+//	param quantile: estimator
+//	param x: sample value
+//	return: quantile
+static inline a3_StatsQuantile *a3statsQuantileAdd(a3_StatsQuantile *quantile, const a3f64 x);
+
+// A3: Get current quantile estimate (exact for five or fewer samples).
+//	param quantile: estimator
+//	return: estimate (zero if no samples)
+static inline a3f64 a3statsQuantileGet(const a3_StatsQuantile *quantile);
+
+
+// A3: Reset histogram.
+//	param histogram_out: histogram to reset
+//	return: histogram_out
+static inline a3_StatsHistogram *a3statsHistogramReset(a3_StatsHistogram *histogram_out);
+
+// A3: Add sample to histogram.
+//	param histogram: histogram
+//	param x: sample value
+//	return: histogram
+static inline a3_StatsHistogram *a3statsHistogramAdd(a3_StatsHistogram *histogram, const a3ui64 x);
+
+// A3: Merge another histogram into histogram.
+//	param histogram: histogram to merge into
+//	param other: histogram to merge
+//	return: histogram
+static inline a3_StatsHistogram *a3statsHistogramMerge(a3_StatsHistogram *histogram, const a3_StatsHistogram *other);
+
+// A3: Get value at percentile; result is the middle of the bucket holding 
+//		the sample of that rank, except that the first and last ranks give 
+//		the exact minimum and maximum.
+//	param histogram: histogram
+//	param p: percentile in [0, 1]
+//	return: value at percentile (zero if no samples)
+static inline a3ui64 a3statsHistogramPercentile(const a3_StatsHistogram *histogram, const a3f64 p);
+
+
 //-----------------------------------------------------------------------------
 
 
@@ -121,5 +247,6 @@ A3_END_DECL
 #ifdef A3_OPEN_SOURCE
 #include "_inl/a3stats_impl.inl"
 #endif	// A3_OPEN_SOURCE
+#include "_inl/a3statsstream_impl.inl"
 
 #endif	// !__ANIMAL3D_A3DM_STATS_H
\ No newline at end of file
@@ -0,0 +1,598 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	animal3D Math (A3DM) SDK
+	By Daniel S. Buckstein
+
+	a3vectormatrix.hpp
+	Header-only C++ (14 or later) vector and matrix templates over dimension
+		and scalar type, with optional C wrappers for the A3DM entry points.
+*/
+
+#ifndef __ANIMAL3D_A3DM_VECTORMATRIX_HPP
+#define __ANIMAL3D_A3DM_VECTORMATRIX_HPP
+
+
+#ifndef __cplusplus
+#error a3vectormatrix.hpp is a C++ header; C code uses a3vector.h and a3matrix.h
+#endif	// !__cplusplus
+
+
+#include "animal3D/a3/a3config.h"
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+
+#include <math.h>
+
+// A3: Runtime kernels use SSE2 for float (4 lanes) and double (2 lanes)
+//		when the compiler targets it (always on x64), otherwise scalar code.
+#if (defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__)
+#define A3_VECTORMATRIX_SSE
+#include <emmintrin.h>
+#endif	// SSE2
+
+
+//-----------------------------------------------------------------------------
+// A3: Two layers, both generated from templates over dimension and scalar
+//		type (a3f32 or a3f64):
+//	-> value types 'vec' and 'mat' with constexpr operations, usable in
+//		constant expressions (tables, unit tests with static_assert) and
+//		in ordinary code
+//	-> 'kernel' and 'matrixKernel' operating on raw arrays (the same memory
+//		as a3real3, a3real4x4 etc.) at run time; every size and type is
+//		served by the same lane abstraction, so one SIMD implementation
+//		covers all of them
+// matrices are column-major like the rest of A3DM: m[column][row]
+
+namespace a3dm
+{
+	//-------------------------------------------------------------------------
+	// value types
+
+	// A3: Vector of N scalars.
+	template <a3count N, typename T>
+	struct vec
+	{
+		T v[N];
+
+		constexpr T &operator [](const a3index i) { return v[i]; }
+		constexpr T const &operator [](const a3index i) const { return v[i]; }
+	};
+
+	// A3: Matrix of C columns, each a vector of R scalars.
+	template <a3count C, a3count R, typename T>
+	struct mat
+	{
+		vec<R, T> m[C];
+
+		constexpr vec<R, T> &operator [](const a3index i) { return m[i]; }
+		constexpr vec<R, T> const &operator [](const a3index i) const { return m[i]; }
+	};
+
+
+	//-------------------------------------------------------------------------
+	// constexpr scalar helpers
+
+	// A3: Square root by Newton's method; exact enough for constant tables,
+	//		run-time code should prefer the kernels (hardware sqrt).
+	//	param x: non-negative number
+	//	return: square root of x, zero if x is not positive
+	template <typename T>
+	constexpr T sqrtConst(const T x)
+	{
+		T r = x > T(1) ? x : T(1), prev = T(0);
+		if (!(x > T(0)))
+			return T(0);
+		while (r != prev)
+		{
+			prev = r;
+			r = (r + x / r) * T(0.5);
+			if (r >= prev)
+				break;
+		}
+		return r;
+	}
+
+
+	//-------------------------------------------------------------------------
+	// constexpr vector operations
+
+	template <a3count N, typename T>
+	constexpr vec<N, T> zero()
+	{
+		vec<N, T> r = {};
+		return r;
+	}
+
+	template <a3count N, typename T>
+	constexpr vec<N, T> sum(const vec<N, T> &vL, const vec<N, T> &vR)
+	{
+		vec<N, T> r = {};
+		for (a3index i = 0; i < N; ++i)
+			r[i] = vL[i] + vR[i];
+		return r;
+	}
+
+	template <a3count N, typename T>
+	constexpr vec<N, T> diff(const vec<N, T> &vL, const vec<N, T> &vR)
+	{
+		vec<N, T> r = {};
+		for (a3index i = 0; i < N; ++i)
+			r[i] = vL[i] - vR[i];
+		return r;
+	}
+
+	template <a3count N, typename T>
+	constexpr vec<N, T> productS(const vec<N, T> &v, const T s)
+	{
+		vec<N, T> r = {};
+		for (a3index i = 0; i < N; ++i)
+			r[i] = v[i] * s;
+		return r;
+	}
+
+	template <a3count N, typename T>
+	constexpr vec<N, T> quotientS(const vec<N, T> &v, const T s)
+	{
+		return productS(v, T(1) / s);
+	}
+
+	template <a3count N, typename T>
+	constexpr vec<N, T> productComp(const vec<N, T> &vL, const vec<N, T> &vR)
+	{
+		vec<N, T> r = {};
+		for (a3index i = 0; i < N; ++i)
+			r[i] = vL[i] * vR[i];
+		return r;
+	}
+
+	template <a3count N, typename T>
+	constexpr vec<N, T> quotientComp(const vec<N, T> &vL, const vec<N, T> &vR)
+	{
+		vec<N, T> r = {};
+		for (a3index i = 0; i < N; ++i)
+			r[i] = vL[i] / vR[i];
+		return r;
+	}
+
+	template <a3count N, typename T>
+	constexpr vec<N, T> negative(const vec<N, T> &v)
+	{
+		vec<N, T> r = {};
+		for (a3index i = 0; i < N; ++i)
+			r[i] = -v[i];
+		return r;
+	}
+
+	template <a3count N, typename T>
+	constexpr T dot(const vec<N, T> &vL, const vec<N, T> &vR)
+	{
+		T r = T(0);
+		for (a3index i = 0; i < N; ++i)
+			r += vL[i] * vR[i];
+		return r;
+	}
+
+	template <a3count N, typename T>
+	constexpr T lengthSquared(const vec<N, T> &v)
+	{
+		return dot(v, v);
+	}
+
+	template <a3count N, typename T>
+	constexpr T length(const vec<N, T> &v)
+	{
+		return sqrtConst(dot(v, v));
+	}
+
+	// zero vector stays zero
+	template <a3count N, typename T>
+	constexpr vec<N, T> unit(const vec<N, T> &v)
+	{
+		const T len = length(v);
+		return productS(v, len > T(0) ? T(1) / len : T(0));
+	}
+
+	template <a3count N, typename T>
+	constexpr vec<N, T> lerp(const vec<N, T> &v0, const vec<N, T> &v1, const T param)
+	{
+		vec<N, T> r = {};
+		for (a3index i = 0; i < N; ++i)
+			r[i] = v0[i] + (v1[i] - v0[i]) * param;
+		return r;
+	}
+
+	template <typename T>
+	constexpr vec<3, T> cross(const vec<3, T> &vL, const vec<3, T> &vR)
+	{
+		vec<3, T> r = {};
+		r[0] = vL[1] * vR[2] - vL[2] * vR[1];
+		r[1] = vL[2] * vR[0] - vL[0] * vR[2];
+		r[2] = vL[0] * vR[1] - vL[1] * vR[0];
+		return r;
+	}
+
+
+	//-------------------------------------------------------------------------
+	// constexpr matrix operations
+
+	template <a3count N, typename T>
+	constexpr mat<N, N, T> identity()
+	{
+		mat<N, N, T> r = {};
+		for (a3index i = 0; i < N; ++i)
+			r[i][i] = T(1);
+		return r;
+	}
+
+	template <a3count C, a3count R, typename T>
+	constexpr mat<R, C, T> transposed(const mat<C, R, T> &m)
+	{
+		mat<R, C, T> r = {};
+		for (a3index c = 0; c < C; ++c)
+			for (a3index i = 0; i < R; ++i)
+				r[i][c] = m[c][i];
+		return r;
+	}
+
+	// matrix times column vector: sum of columns weighted by the vector
+	template <a3count C, a3count R, typename T>
+	constexpr vec<R, T> transform(const mat<C, R, T> &m, const vec<C, T> &v)
+	{
+		vec<R, T> r = {};
+		for (a3index k = 0; k < C; ++k)
+			for (a3index i = 0; i < R; ++i)
+				r[i] += m[k][i] * v[k];
+		return r;
+	}
+
+	// mL (K columns of R) times mR (C columns of K)
+	template <a3count C, a3count K, a3count R, typename T>
+	constexpr mat<C, R, T> product(const mat<K, R, T> &mL, const mat<C, K, T> &mR)
+	{
+		mat<C, R, T> r = {};
+		for (a3index c = 0; c < C; ++c)
+			r[c] = transform(mL, mR[c]);
+		return r;
+	}
+
+	// product of affine 4x4 transforms: bottom row is taken to be (0, 0, 0, 1)
+	template <typename T>
+	constexpr mat<4, 4, T> productTransform(const mat<4, 4, T> &mL, const mat<4, 4, T> &mR)
+	{
+		mat<4, 4, T> r = {};
+		for (a3index c = 0; c < 4; ++c)
+		{
+			for (a3index i = 0; i < 3; ++i)
+				r[c][i] = mL[0][i] * mR[c][0] + mL[1][i] * mR[c][1] + mL[2][i] * mR[c][2];
+			r[c][3] = T(0);
+		}
+		r[3][0] += mL[3][0];
+		r[3][1] += mL[3][1];
+		r[3][2] += mL[3][2];
+		r[3][3] = T(1);
+		return r;
+	}
+
+
+	//-------------------------------------------------------------------------
+	// run-time lanes: one abstraction, specialized per scalar type
+
+	namespace detail
+	{
+		template <typename T>
+		struct scalarLanes
+		{
+			enum { width = 1 };
+			typedef T type;
+			static inline type load(const T *p) { return *p; }
+			static inline void store(T *p, const type a) { *p = a; }
+			static inline type set1(const T s) { return s; }
+			static inline type add(const type a, const type b) { return a + b; }
+			static inline type sub(const type a, const type b) { return a - b; }
+			static inline type mul(const type a, const type b) { return a * b; }
+			static inline type div(const type a, const type b) { return a / b; }
+			static inline T hsum(const type a) { return a; }
+		};
+
+		template <typename T>
+		struct lanes : scalarLanes<T> {};
+
+#ifdef A3_VECTORMATRIX_SSE
+		template <>
+		struct lanes<a3f32>
+		{
+			enum { width = 4 };
+			typedef __m128 type;
+			static inline type load(const a3f32 *p) { return _mm_loadu_ps(p); }
+			static inline void store(a3f32 *p, const type a) { _mm_storeu_ps(p, a); }
+			static inline type set1(const a3f32 s) { return _mm_set1_ps(s); }
+			static inline type add(const type a, const type b) { return _mm_add_ps(a, b); }
+			static inline type sub(const type a, const type b) { return _mm_sub_ps(a, b); }
+			static inline type mul(const type a, const type b) { return _mm_mul_ps(a, b); }
+			static inline type div(const type a, const type b) { return _mm_div_ps(a, b); }
+			static inline a3f32 hsum(const type a)
+			{
+				const __m128 s = _mm_add_ps(a, _mm_movehl_ps(a, a));
+				return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+			}
+		};
+
+		template <>
+		struct lanes<a3f64>
+		{
+			enum { width = 2 };
+			typedef __m128d type;
+			static inline type load(const a3f64 *p) { return _mm_loadu_pd(p); }
+			static inline void store(a3f64 *p, const type a) { _mm_storeu_pd(p, a); }
+			static inline type set1(const a3f64 s) { return _mm_set1_pd(s); }
+			static inline type add(const type a, const type b) { return _mm_add_pd(a, b); }
+			static inline type sub(const type a, const type b) { return _mm_sub_pd(a, b); }
+			static inline type mul(const type a, const type b) { return _mm_mul_pd(a, b); }
+			static inline type div(const type a, const type b) { return _mm_div_pd(a, b); }
+			static inline a3f64 hsum(const type a) { return _mm_cvtsd_f64(_mm_add_sd(a, _mm_unpackhi_pd(a, a))); }
+		};
+#endif	// A3_VECTORMATRIX_SSE
+
+		// element-wise operations: out = op(a, b, s), s broadcast
+		struct opSum { template <typename L> static inline typename L::type eval(const typename L::type a, const typename L::type b, const typename L::type) { return L::add(a, b); } };
+		struct opDiff { template <typename L> static inline typename L::type eval(const typename L::type a, const typename L::type b, const typename L::type) { return L::sub(a, b); } };
+		struct opProductComp { template <typename L> static inline typename L::type eval(const typename L::type a, const typename L::type b, const typename L::type) { return L::mul(a, b); } };
+		struct opQuotientComp { template <typename L> static inline typename L::type eval(const typename L::type a, const typename L::type b, const typename L::type) { return L::div(a, b); } };
+		struct opProductS { template <typename L> static inline typename L::type eval(const typename L::type a, const typename L::type, const typename L::type s) { return L::mul(a, s); } };
+		struct opMad { template <typename L> static inline typename L::type eval(const typename L::type a, const typename L::type b, const typename L::type s) { return L::add(a, L::mul(b, s)); } };
+		struct opLerp { template <typename L> static inline typename L::type eval(const typename L::type a, const typename L::type b, const typename L::type s) { return L::add(a, L::mul(L::sub(b, a), s)); } };
+
+		// full lanes first, scalar tail; N is a constant so loops unroll;
+		//	each block is loaded before it is stored, so out may alias a or b
+		template <a3count N, typename T, typename Op>
+		inline void elementwise(T *out, const T *a, const T *b, const T s)
+		{
+			typedef lanes<T> L;
+			typedef scalarLanes<T> S;
+			const typename L::type sv = L::set1(s);
+			a3index i = 0;
+			for (; i + L::width <= N; i += L::width)
+				L::store(out + i, Op::template eval<L>(L::load(a + i), L::load(b + i), sv));
+			for (; i < N; ++i)
+				out[i] = Op::template eval<S>(a[i], b[i], s);
+		}
+
+		inline a3f32 sqrtRuntime(const a3f32 x) { return sqrtf(x); }
+		inline a3f64 sqrtRuntime(const a3f64 x) { return sqrt(x); }
+	}
+
+
+	//-------------------------------------------------------------------------
+	// run-time kernels on raw arrays; outputs may alias inputs
+
+	// A3: Vector kernels for N scalars of type T.
+	template <a3count N, typename T>
+	struct kernel
+	{
+		static inline void copy(T *v_out, const T *v)
+		{
+			for (a3index i = 0; i < N; ++i)
+				v_out[i] = v[i];
+		}
+		static inline void sum(T *v_out, const T *vL, const T *vR) { detail::elementwise<N, T, detail::opSum>(v_out, vL, vR, T(0)); }
+		static inline void diff(T *v_out, const T *vL, const T *vR) { detail::elementwise<N, T, detail::opDiff>(v_out, vL, vR, T(0)); }
+		static inline void productComp(T *v_out, const T *vL, const T *vR) { detail::elementwise<N, T, detail::opProductComp>(v_out, vL, vR, T(0)); }
+		static inline void quotientComp(T *v_out, const T *vL, const T *vR) { detail::elementwise<N, T, detail::opQuotientComp>(v_out, vL, vR, T(0)); }
+		static inline void productS(T *v_out, const T *v, const T s) { detail::elementwise<N, T, detail::opProductS>(v_out, v, v, s); }
+		static inline void quotientS(T *v_out, const T *v, const T s) { productS(v_out, v, T(1) / s); }
+		static inline void negative(T *v_out, const T *v) { productS(v_out, v, T(-1)); }
+		static inline void mad(T *v_inout, const T *v, const T s) { detail::elementwise<N, T, detail::opMad>(v_inout, v_inout, v, s); }
+		static inline void lerp(T *v_out, const T *v0, const T *v1, const T param) { detail::elementwise<N, T, detail::opLerp>(v_out, v0, v1, param); }
+
+		static inline T dot(const T *vL, const T *vR)
+		{
+			typedef detail::lanes<T> L;
+			T r = T(0);
+			a3index i = 0;
+			if (N >= (a3count)L::width)
+			{
+				typename L::type acc = L::mul(L::load(vL), L::load(vR));
+				for (i = L::width; i + L::width <= N; i += L::width)
+					acc = L::add(acc, L::mul(L::load(vL + i), L::load(vR + i)));
+				r = L::hsum(acc);
+			}
+			for (; i < N; ++i)
+				r += vL[i] * vR[i];
+			return r;
+		}
+		static inline T lengthSquared(const T *v) { return dot(v, v); }
+		static inline T length(const T *v) { return detail::sqrtRuntime(dot(v, v)); }
+		static inline T distanceSquared(const T *v0, const T *v1)
+		{
+			T d[N];
+			diff(d, v1, v0);
+			return dot(d, d);
+		}
+		static inline T distance(const T *v0, const T *v1) { return detail::sqrtRuntime(distanceSquared(v0, v1)); }
+
+		// returns inverse length; zero vector stays zero
+		static inline T unit(T *v_out, const T *v)
+		{
+			const T len = length(v), lenInv = len > T(0) ? T(1) / len : T(0);
+			productS(v_out, v, lenInv);
+			return lenInv;
+		}
+
+		static inline void cross(T *v_out, const T *vL, const T *vR)
+		{
+			static_assert(N == 3, "cross product is defined for 3D vectors");
+			const T x = vL[1] * vR[2] - vL[2] * vR[1], y = vL[2] * vR[0] - vL[0] * vR[2], z = vL[0] * vR[1] - vL[1] * vR[0];
+			v_out[0] = x;
+			v_out[1] = y;
+			v_out[2] = z;
+		}
+	};
+
+	// A3: Matrix kernels for C columns of R scalars of type T, stored
+	//		contiguously column after column.
+	template <a3count C, a3count R, typename T>
+	struct matrixKernel
+	{
+		enum { size = C * R };
+
+		static inline void identity(T *m_out)
+		{
+			static_assert(C == R, "identity is defined for square matrices");
+			for (a3index c = 0; c < C; ++c)
+				for (a3index i = 0; i < R; ++i)
+					m_out[c * R + i] = T(c == i);
+		}
+
+		// m_out is R columns of C; may alias m when square
+		static inline void transposed(T *m_out, const T *m)
+		{
+			T t[size];
+			for (a3index c = 0; c < C; ++c)
+				for (a3index i = 0; i < R; ++i)
+					t[i * C + c] = m[c * R + i];
+			kernel<size, T>::copy(m_out, t);
+		}
+
+		// v_out (R) = m * v (C): columns weighted by v; v_out must not alias v
+		static inline void transform(T *v_out, const T *m, const T *v)
+		{
+			kernel<R, T>::productS(v_out, m, v[0]);
+			for (a3index k = 1; k < C; ++k)
+				kernel<R, T>::mad(v_out, m + k * R, v[k]);
+		}
+
+		// v_out (C) = v (R) * m: dot with each column; v_out must not alias v
+		static inline void transformL(T *v_out, const T *v, const T *m)
+		{
+			for (a3index c = 0; c < C; ++c)
+				v_out[c] = kernel<R, T>::dot(v, m + c * R);
+		}
+
+		// m_out (C columns of R) = mL (K columns of R) * mR (C columns of K)
+		template <a3count K>
+		static inline void product(T *m_out, const T *mL, const T *mR)
+		{
+			T t[size];
+			for (a3index c = 0; c < C; ++c)
+				matrixKernel<K, R, T>::transform(t + c * R, mL, mR + c * K);
+			kernel<size, T>::copy(m_out, t);
+		}
+
+		// product of affine 4x4 transforms: bottom row is taken to be (0, 0, 0, 1)
+		static inline void productTransform(T *m_out, const T *mL, const T *mR)
+		{
+			static_assert(C == 4 && R == 4, "transform product is defined for 4x4 matrices");
+			T t[size];
+			a3index c;
+			for (c = 0; c < 3; ++c)
+			{
+				kernel<4, T>::productS(t + c * 4, mL, mR[c * 4]);
+				kernel<4, T>::mad(t + c * 4, mL + 4, mR[c * 4 + 1]);
+				kernel<4, T>::mad(t + c * 4, mL + 8, mR[c * 4 + 2]);
+				t[c * 4 + 3] = T(0);
+			}
+			kernel<4, T>::productS(t + 12, mL, mR[12]);
+			kernel<4, T>::mad(t + 12, mL + 4, mR[13]);
+			kernel<4, T>::mad(t + 12, mL + 8, mR[14]);
+			kernel<4, T>::sum(t + 12, t + 12, mL + 12);
+			t[15] = T(1);
+			kernel<size, T>::copy(m_out, t);
+		}
+	};
+}
+
+
+//-----------------------------------------------------------------------------
+// A3: C wrappers: define A3_VECTORMATRIX_DEFINE_C_ABI in exactly one C++
+//		translation unit before including this header to emit the A3DM entry
+//		points below (a3real3Add etc.) as thin calls into the kernels, for
+//		builds that do not link the precompiled A3DM library. That unit must
+//		not include a3vector.h or a3matrix.h, which declare the same names.
+
+#ifdef A3_VECTORMATRIX_DEFINE_C_ABI
+
+#define a3vectormatrixInternalVector(n)	\
+	a3real##n##r a3real##n##Sum(a3real##n##p v_out, const a3real##n##p vL, const a3real##n##p vR) { a3dm::kernel<n, a3real>::sum(v_out, vL, vR); return v_out; }	\
+	a3real##n##r a3real##n##Diff(a3real##n##p v_out, const a3real##n##p vL, const a3real##n##p vR) { a3dm::kernel<n, a3real>::diff(v_out, vL, vR); return v_out; }	\
+	a3real##n##r a3real##n##ProductS(a3real##n##p v_out, const a3real##n##p v, const a3real s) { a3dm::kernel<n, a3real>::productS(v_out, v, s); return v_out; }	\
+	a3real##n##r a3real##n##QuotientS(a3real##n##p v_out, const a3real##n##p v, const a3real s) { a3dm::kernel<n, a3real>::quotientS(v_out, v, s); return v_out; }	\
+	a3real##n##r a3real##n##ProductComp(a3real##n##p v_out, const a3real##n##p vL, const a3real##n##p vR) { a3dm::kernel<n, a3real>::productComp(v_out, vL, vR); return v_out; }	\
+	a3real##n##r a3real##n##QuotientComp(a3real##n##p v_out, const a3real##n##p vL, const a3real##n##p vR) { a3dm::kernel<n, a3real>::quotientComp(v_out, vL, vR); return v_out; }	\
+	a3real##n##r a3real##n##Add(a3real##n##p vL_inout, const a3real##n##p vR) { a3dm::kernel<n, a3real>::sum(vL_inout, vL_inout, vR); return vL_inout; }	\
+	a3real##n##r a3real##n##Sub(a3real##n##p vL_inout, const a3real##n##p vR) { a3dm::kernel<n, a3real>::diff(vL_inout, vL_inout, vR); return vL_inout; }	\
+	a3real##n##r a3real##n##MulS(a3real##n##p v_inout, const a3real s) { a3dm::kernel<n, a3real>::productS(v_inout, v_inout, s); return v_inout; }	\
+	a3real##n##r a3real##n##DivS(a3real##n##p v_inout, const a3real s) { a3dm::kernel<n, a3real>::quotientS(v_inout, v_inout, s); return v_inout; }	\
+	a3real##n##r a3real##n##MulComp(a3real##n##p vL_inout, const a3real##n##p vR) { a3dm::kernel<n, a3real>::productComp(vL_inout, vL_inout, vR); return vL_inout; }	\
+	a3real##n##r a3real##n##DivComp(a3real##n##p vL_inout, const a3real##n##p vR) { a3dm::kernel<n, a3real>::quotientComp(vL_inout, vL_inout, vR); return vL_inout; }	\
+	a3real##n##r a3real##n##GetNegative(a3real##n##p v_out, const a3real##n##p v) { a3dm::kernel<n, a3real>::negative(v_out, v); return v_out; }	\
+	a3real##n##r a3real##n##Negate(a3real##n##p v_inout) { a3dm::kernel<n, a3real>::negative(v_inout, v_inout); return v_inout; }	\
+	a3real a3real##n##Dot(const a3real##n##p vL, const a3real##n##p vR) { return a3dm::kernel<n, a3real>::dot(vL, vR); }	\
+	a3real a3real##n##LengthSquared(const a3real##n##p v) { return a3dm::kernel<n, a3real>::lengthSquared(v); }	\
+	a3real a3real##n##Length(const a3real##n##p v) { return a3dm::kernel<n, a3real>::length(v); }	\
+	a3real a3real##n##DistanceSquared(const a3real##n##p v0, const a3real##n##p v1) { return a3dm::kernel<n, a3real>::distanceSquared(v0, v1); }	\
+	a3real a3real##n##Distance(const a3real##n##p v0, const a3real##n##p v1) { return a3dm::kernel<n, a3real>::distance(v0, v1); }	\
+	a3real##n##r a3real##n##GetUnit(a3real##n##p v_out, const a3real##n##p v) { a3dm::kernel<n, a3real>::unit(v_out, v); return v_out; }	\
+	a3real##n##r a3real##n##Normalize(a3real##n##p v_inout) { a3dm::kernel<n, a3real>::unit(v_inout, v_inout); return v_inout; }	\
+	a3real##n##r a3real##n##GetUnitInvLength(a3real##n##p v_out, const a3real##n##p v, a3real *invLength_out) { *invLength_out = a3dm::kernel<n, a3real>::unit(v_out, v); return v_out; }	\
+	a3real##n##r a3real##n##NormalizeGetInvLength(a3real##n##p v_inout, a3real *invLength_out) { *invLength_out = a3dm::kernel<n, a3real>::unit(v_inout, v_inout); return v_inout; }	\
+	a3real##n##r a3real##n##Lerp(a3real##n##p v_out, const a3real##n##p v0, const a3real##n##p v1, const a3real param) { a3dm::kernel<n, a3real>::lerp(v_out, v0, v1, param); return v_out; }
+
+#define a3vectormatrixInternalMatrix(n)	\
+	a3real##n##x##n##r a3real##n##x##n##SetIdentity(a3real##n##x##n##p m_out) { a3dm::matrixKernel<n, n, a3real>::identity(*m_out); return m_out; }	\
+	a3real##n##x##n##r a3real##n##x##n##GetTransposed(a3real##n##x##n##p m_out, const a3real##n##x##n##p m) { a3dm::matrixKernel<n, n, a3real>::transposed(*m_out, *m); return m_out; }	\
+	a3real##n##x##n##r a3real##n##x##n##Transpose(a3real##n##x##n##p m_inout) { a3dm::matrixKernel<n, n, a3real>::transposed(*m_inout, *m_inout); return m_inout; }	\
+	a3real##n##x##n##r a3real##n##x##n##Sum(a3real##n##x##n##p m_out, const a3real##n##x##n##p mL, const a3real##n##x##n##p mR) { a3dm::kernel<n * n, a3real>::sum(*m_out, *mL, *mR); return m_out; }	\
+	a3real##n##x##n##r a3real##n##x##n##Diff(a3real##n##x##n##p m_out, const a3real##n##x##n##p mL, const a3real##n##x##n##p mR) { a3dm::kernel<n * n, a3real>::diff(*m_out, *mL, *mR); return m_out; }	\
+	a3real##n##x##n##r a3real##n##x##n##ProductS(a3real##n##x##n##p m_out, const a3real##n##x##n##p m, const a3real s) { a3dm::kernel<n * n, a3real>::productS(*m_out, *m, s); return m_out; }	\
+	a3real##n##x##n##r a3real##n##x##n##Add(a3real##n##x##n##p mL_inout, const a3real##n##x##n##p mR) { a3dm::kernel<n * n, a3real>::sum(*mL_inout, *mL_inout, *mR); return mL_inout; }	\
+	a3real##n##x##n##r a3real##n##x##n##Sub(a3real##n##x##n##p mL_inout, const a3real##n##x##n##p mR) { a3dm::kernel<n * n, a3real>::diff(*mL_inout, *mL_inout, *mR); return mL_inout; }	\
+	a3real##n##x##n##r a3real##n##x##n##MulS(a3real##n##x##n##p m_inout, const a3real s) { a3dm::kernel<n * n, a3real>::productS(*m_inout, *m_inout, s); return m_inout; }	\
+	a3real##n##x##n##r a3real##n##x##n##Product(a3real##n##x##n##p m_out, const a3real##n##x##n##p mL, const a3real##n##x##n##p mR) { a3dm::matrixKernel<n, n, a3real>::product<n>(*m_out, *mL, *mR); return m_out; }	\
+	a3real##n##x##n##r a3real##n##x##n##ConcatL(a3real##n##x##n##p mL_inout, const a3real##n##x##n##p mR) { a3dm::matrixKernel<n, n, a3real>::product<n>(*mL_inout, *mL_inout, *mR); return mL_inout; }	\
+	a3real##n##x##n##r a3real##n##x##n##ConcatR(const a3real##n##x##n##p mL, a3real##n##x##n##p mR_inout) { a3dm::matrixKernel<n, n, a3real>::product<n>(*mR_inout, *mL, *mR_inout); return mR_inout; }	\
+	a3real##n##r a3real##n##Real##n##x##n##ProductR(a3real##n##p v_out, const a3real##n##x##n##p m, const a3real##n##p v) { a3real##n t; a3dm::matrixKernel<n, n, a3real>::transform(t, *m, v); a3dm::kernel<n, a3real>::copy(v_out, t); return v_out; }	\
+	a3real##n##r a3real##n##Real##n##x##n##ProductL(a3real##n##p v_out, const a3real##n##p v, const a3real##n##x##n##p m) { a3real##n t; a3dm::matrixKernel<n, n, a3real>::transformL(t, v, *m); a3dm::kernel<n, a3real>::copy(v_out, t); return v_out; }	\
+	a3real##n##r a3real##n##Real##n##x##n##MulR(const a3real##n##x##n##p m, a3real##n##p v_inout) { return a3real##n##Real##n##x##n##ProductR(v_inout, m, v_inout); }	\
+	a3real##n##r a3real##n##Real##n##x##n##MulL(a3real##n##p v_inout, const a3real##n##x##n##p m) { return a3real##n##Real##n##x##n##ProductL(v_inout, v_inout, m); }
+
+extern "C"
+{
+	a3vectormatrixInternalVector(2)
+	a3vectormatrixInternalVector(3)
+	a3vectormatrixInternalVector(4)
+
+	a3real3r a3real3Cross(a3real3p v_out, const a3real3p vL, const a3real3p vR) { a3dm::kernel<3, a3real>::cross(v_out, vL, vR); return v_out; }
+
+	a3vectormatrixInternalMatrix(2)
+	a3vectormatrixInternalMatrix(3)
+	a3vectormatrixInternalMatrix(4)
+
+	a3real4x4r a3real4x4ProductTransform(a3real4x4p m_out, const a3real4x4p mL, const a3real4x4p mR) { a3dm::matrixKernel<4, 4, a3real>::productTransform(*m_out, *mL, *mR); return m_out; }
+	a3real4x4r a3real4x4MulTransform(a3real4x4p mL_inout, const a3real4x4p mR) { return a3real4x4ProductTransform(mL_inout, mL_inout, mR); }
+	a3real4x4r a3real4x4TransformMul(const a3real4x4p mL, a3real4x4p mR_inout) { return a3real4x4ProductTransform(mR_inout, mL, mR_inout); }
+}
+
+#undef a3vectormatrixInternalVector
+#undef a3vectormatrixInternalMatrix
+
+#endif	// A3_VECTORMATRIX_DEFINE_C_ABI
+
+
+#endif	// !__ANIMAL3D_A3DM_VECTORMATRIX_HPP
@@ -0,0 +1,108 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	passTangentBasis_morph_transform_vs4x.glsl
+	Calculate and pass tangent basis with sparse weighted morph targets.
+*/
+
+#version 450
+
+#define MAX_MORPH_TARGETS 64
+
+// base shape only; targets are read from the data texture
+//	normal and tangent are octahedral-encoded unit vectors
+//	(see a3vertexAttribEncodeOctahedral)
+layout (location = 0) in vec4 aPosition;
+layout (location = 2) in vec2 aNormal;
+layout (location = 8) in vec4 aTexcoord;
+layout (location = 10) in vec2 aTangent;
+
+uniform mat4 uP;
+uniform mat4 uMV, uMV_nrm;
+uniform mat4 uAtlas;
+
+// sparse morph deltas (see a3morphTargetStoreTexture): 
+//	texel v holds the first entry texel and entry count for vertex v, 
+//	then each entry is three texels: position delta with target index in w, 
+//	normal delta, tangent delta
+uniform sampler2D uImage07;
+
+// weight per target; inactive targets are zero
+uniform float uMorphWeight[MAX_MORPH_TARGETS];
+
+out vbVertexData {
+	mat4 vTangentBasis_view;
+	vec4 vTexcoord_atlas;
+};
+
+flat out int vVertexID;
+flat out int vInstanceID;
+
+vec4 fetchMorph(in int texel, in int width)
+{
+	return texelFetch(uImage07, ivec2(texel % width, texel / width), 0);
+}
+
+vec3 decodeOctahedral(in vec2 e)
+{
+	vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-v.z, 0.0);
+	v.xy += mix(vec2(t), vec2(-t), greaterThanEqual(v.xy, vec2(0.0)));
+	return normalize(v);
+}
+
+void main()
+{
+	int width = textureSize(uImage07, 0).x;
+	vec4 header = fetchMorph(gl_VertexID, width);
+	int entry = int(header.x), entryEnd = entry + int(header.y) * 3;
+
+	vec4 position = aPosition;
+	vec3 normal = decodeOctahedral(aNormal), tangent = decodeOctahedral(aTangent);
+	vec4 delta;
+	float weight;
+
+	// only targets that move this vertex are visited, and only those 
+	//	with non-zero weight read their normal and tangent deltas
+	for (; entry < entryEnd; entry += 3)
+	{
+		delta = fetchMorph(entry, width);
+		weight = uMorphWeight[int(delta.w)];
+		if (weight != 0.0)
+		{
+			position.xyz += weight * delta.xyz;
+			normal += weight * fetchMorph(entry + 1, width).xyz;
+			tangent += weight * fetchMorph(entry + 2, width).xyz;
+		}
+	}
+	normal = normalize(normal);
+	tangent = normalize(tangent - normal * dot(tangent, normal));
+	vec3 bitangent = cross(normal, tangent);
+	
+	vTangentBasis_view = uMV_nrm * mat4(vec4(tangent, 0.0), vec4(bitangent, 0.0), vec4(normal, 0.0), vec4(0.0));
+	vTangentBasis_view[3] = uMV * position;
+	gl_Position = uP * vTangentBasis_view[3];
+	
+	vTexcoord_atlas = uAtlas * aTexcoord;
+
+	vVertexID = gl_VertexID;
+	vInstanceID = gl_InstanceID;
+}
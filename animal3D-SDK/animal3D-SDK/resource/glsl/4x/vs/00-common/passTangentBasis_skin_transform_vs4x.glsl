@@ -24,15 +24,74 @@
 
 #version 450
 
+#define MAX_JOINTS 128
+
 layout (location = 0) in vec4 aPosition;
+layout (location = 1) in vec4 aBlendWeights;
+layout (location = 2) in vec4 aNormal;
+layout (location = 7) in ivec4 aBlendIndices;
+layout (location = 8) in vec4 aTexcoord;
+layout (location = 10) in vec4 aTangent;
+layout (location = 11) in vec4 aBitangent;
+
+// skinning palette as unit dual quaternions: column 0 is the real part 
+//	(rotation), column 1 is the dual part (translation); same layout as 
+//	a3dualquat, 32 bytes per joint instead of 64 for a matrix
+uniform ubTransformBlend {
+	mat2x4 uSkinDQ[MAX_JOINTS];
+};
+
+uniform mat4 uP;
+uniform mat4 uMV, uMV_nrm;
+uniform mat4 uAtlas;
+
+out vbVertexData {
+	mat4 vTangentBasis_view;
+	vec4 vTexcoord_atlas;
+};
 
 flat out int vVertexID;
 flat out int vInstanceID;
 
+// dual quaternion linear blend: weights are negated for joints whose real 
+//	part is in the opposite hemisphere from the first influence
+mat2x4 blendDualQuat(in ivec4 j, in vec4 w)
+{
+	mat2x4 dq0 = uSkinDQ[j.x];
+	mat2x4 dq = dq0 * w.x;
+	dq += uSkinDQ[j.y] * (dot(dq0[0], uSkinDQ[j.y][0]) < 0.0 ? -w.y : w.y);
+	dq += uSkinDQ[j.z] * (dot(dq0[0], uSkinDQ[j.z][0]) < 0.0 ? -w.z : w.z);
+	dq += uSkinDQ[j.w] * (dot(dq0[0], uSkinDQ[j.w][0]) < 0.0 ? -w.w : w.w);
+	return (dq / length(dq[0]));
+}
+
+// rotate vector by real part
+vec3 rotateDualQuat(in mat2x4 dq, in vec3 v)
+{
+	return (v + 2.0 * cross(dq[0].xyz, cross(dq[0].xyz, v) + dq[0].w * v));
+}
+
+// rotate and translate point by unit dual quaternion
+vec3 transformDualQuat(in mat2x4 dq, in vec3 p)
+{
+	vec3 t = 2.0 * (dq[0].w * dq[1].xyz - dq[1].w * dq[0].xyz + cross(dq[0].xyz, dq[1].xyz));
+	return (rotateDualQuat(dq, p) + t);
+}
+
 void main()
 {
-	// DUMMY OUTPUT: directly assign input position to output position
-	gl_Position = aPosition;
+	mat2x4 dq = blendDualQuat(aBlendIndices, aBlendWeights);
+
+	vec4 position = vec4(transformDualQuat(dq, aPosition.xyz), 1.0);
+	vec4 normal = vec4(rotateDualQuat(dq, aNormal.xyz), 0.0);
+	vec4 tangent = vec4(rotateDualQuat(dq, aTangent.xyz), 0.0);
+	vec4 bitangent = vec4(rotateDualQuat(dq, aBitangent.xyz), 0.0);
+
+	vTangentBasis_view = uMV_nrm * mat4(tangent, bitangent, normal, vec4(0.0));
+	vTangentBasis_view[3] = uMV * position;
+	gl_Position = uP * vTangentBasis_view[3];
+
+	vTexcoord_atlas = uAtlas * aTexcoord;
 
 	vVertexID = gl_VertexID;
 	vInstanceID = gl_InstanceID;
@@ -35,6 +35,7 @@
 // internal utility declarations
 
 void a3vertexArrayInternalReleaseFunc(a3i32 count, a3ui32 *handlePtr);
+a3ui16 a3vertexInternalGetType(const a3_VertexAttributeType type);
 
 
 //-----------------------------------------------------------------------------
@@ -48,6 +49,90 @@ inline a3ret a3indexInternalStore(a3_IndexBuffer *indexBuffer, const a3ui32 stor
 }
 
 
+// find the packed type an attribute in a format was described with
+inline a3_VertexAttributeType a3vertexInternalGetPackedType(const a3_VertexFormatDescriptor *vertexFormat, const a3ui32 attribIndex)
+{
+	a3_VertexAttributeType type;
+	for (type = a3attrib_hvec3; type <= a3attrib_unorm8vec4; ++type)
+		if (vertexFormat->attribType[attribIndex] == a3vertexInternalGetType(type) &&
+			vertexFormat->attribElements[attribIndex] == a3vertexAttribGetElementsPerAttrib(type))
+			return type;
+	return a3attrib_disable;
+}
+
+// float to half float, rounding to nearest even
+inline a3ui16 a3vertexInternalEncodeHalf(const float value)
+{
+	union { float f; a3ui32 u; } bits, magic;
+	a3ui32 sign, half, odd;
+	bits.f = value;
+	sign = (bits.u >> 16) & 0x8000;
+	bits.u &= 0x7fffffff;
+	if (bits.u >= (127 + 16) << 23)
+		half = bits.u > (255 << 23) ? 0x7e00 : 0x7c00;
+	else if (bits.u < (127 - 14) << 23)
+	{
+		// subnormal: let float addition do the rounding
+		magic.u = ((127 - 15) + (23 - 10) + 1) << 23;
+		bits.f += magic.f;
+		half = bits.u - magic.u;
+	}
+	else
+	{
+		odd = (bits.u >> 13) & 1;
+		bits.u += ((a3ui32)(15 - 127) << 23) + 0xfff + odd;
+		half = bits.u >> 13;
+	}
+	return (a3ui16)(sign | half);
+}
+
+inline a3i16 a3vertexInternalEncodeSnorm16(const float value)
+{
+	const float v = (value > 1.0f ? 1.0f : value < -1.0f ? -1.0f : value) * 32767.0f;
+	return (a3i16)(v >= 0.0f ? v + 0.5f : v - 0.5f);
+}
+
+inline a3ui32 a3vertexInternalEncodeUnorm(const float value, const float scale)
+{
+	return (a3ui32)((value > 1.0f ? 1.0f : value < 0.0f ? 0.0f : value) * scale + 0.5f);
+}
+
+// encode one attribute from float source data
+inline void a3vertexInternalEncode(a3byte *dst, const float *src, const a3_VertexAttributeType type)
+{
+	float oct[2];
+	a3ui32 i;
+	switch (type)
+	{
+	case a3attrib_hvec3:
+		for (i = 0; i < 3; ++i)
+			((a3ui16 *)dst)[i] = a3vertexInternalEncodeHalf(src[i]);
+		((a3ui16 *)dst)[3] = 0x3c00;
+		break;
+	case a3attrib_snorm16vec3:
+		for (i = 0; i < 3; ++i)
+			((a3i16 *)dst)[i] = a3vertexInternalEncodeSnorm16(src[i]);
+		((a3i16 *)dst)[3] = 0;
+		break;
+	case a3attrib_octvec3:
+		a3vertexAttribEncodeOctahedral(oct, src);
+		((a3i16 *)dst)[0] = a3vertexInternalEncodeSnorm16(oct[0]);
+		((a3i16 *)dst)[1] = a3vertexInternalEncodeSnorm16(oct[1]);
+		break;
+	case a3attrib_unorm16vec2:
+		for (i = 0; i < 2; ++i)
+			((a3ui16 *)dst)[i] = (a3ui16)a3vertexInternalEncodeUnorm(src[i], 65535.0f);
+		break;
+	case a3attrib_unorm8vec4:
+		for (i = 0; i < 4; ++i)
+			((a3ubyte *)dst)[i] = (a3ubyte)a3vertexInternalEncodeUnorm(src[i], 255.0f);
+		break;
+	default:
+		break;
+	}
+}
+
+
 //-----------------------------------------------------------------------------
 
 a3ret a3vertexBufferStore(a3_VertexBuffer *vertexBuffer, const a3_VertexFormatDescriptor *vertexFormat, const a3_VertexAttributeDataDescriptor *attribRawData, const a3ui32 vertexCount, a3ui32 *offset_out_opt)
@@ -58,6 +143,7 @@ a3ret a3vertexBufferStore(a3_VertexBuffer *vertexBuffer, const a3_VertexFormatDe
 	a3byte *interleaved, *interleavedPtr;
 	const a3byte *attribData[a3attrib_nameMax] = { 0 }, *attribDataPtr;
 	a3ui32 attribSize;
+	a3_VertexAttributeType packedType;
 
 	// ALGORITHM: 
 	//	- generate CPU-side array to hold the data before shipping to GPU
@@ -81,7 +167,7 @@ a3ret a3vertexBufferStore(a3_VertexBuffer *vertexBuffer, const a3_VertexFormatDe
 	// contiguous memory means faster access for drawing!
 
 	// validate params
-	if (vertexBuffer && vertexFormat && attribData && vertexCount)
+	if (vertexBuffer && vertexFormat && attribRawData && vertexCount)
 	{
 		// validate initialized
 		if (vertexBuffer->handle->handle)
@@ -118,7 +204,20 @@ a3ret a3vertexBufferStore(a3_VertexBuffer *vertexBuffer, const a3_VertexFormatDe
 								interleavedPtr = interleaved + vertexFormat->attribOffset[attribIndex];
 								attribDataPtr = attribData[attribIndex];
 								attribSize = vertexFormat->attribSize[attribIndex];
-								for (vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+
+								// packed attributes are encoded from floats
+								packedType = a3vertexInternalGetPackedType(vertexFormat, attribIndex);
+								if (packedType)
+								{
+									attribSize = a3vertexAttribGetPackedSourceSize(packedType);
+									for (vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
+									{
+										a3vertexInternalEncode(interleavedPtr, (const float *)attribDataPtr, packedType);
+										interleavedPtr += vertexFormat->vertexSize;
+										attribDataPtr += attribSize;
+									}
+								}
+								else for (vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex)
 								{
 									memcpy(interleavedPtr, attribDataPtr, attribSize);
 									interleavedPtr += vertexFormat->vertexSize;
@@ -0,0 +1,131 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_AnimationBenchmark-A3DM.c
+	Portable definitions of the A3DM entry points used by the animation 
+		sources, for platforms without the precompiled math library.
+	These are stand-ins written against the A3DM declarations, not copies 
+		of the library: the library only ships for Windows, so they have 
+		not been checked against its output, and stage times measured 
+		with them are not A3DM numbers.
+*/
+
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+#include <math.h>
+
+
+//-----------------------------------------------------------------------------
+
+a3f32 a3sqrtf(const a3f32 x)
+{
+	return sqrtf(x);
+}
+
+a3f32 a3sqrtfInverse(const a3f32 x)
+{
+	return (1.0f / sqrtf(x));
+}
+
+a3f64 a3sqrtd(const a3f64 x)
+{
+	return sqrt(x);
+}
+
+a3f64 a3sqrtdInverse(const a3f64 x)
+{
+	return (1.0 / sqrt(x));
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3real4r a3quatProduct(a3real4p q_out, const a3real4p qL, const a3real4p qR)
+{
+	const a3real x = qL[3] * qR[0] + qL[0] * qR[3] + qL[1] * qR[2] - qL[2] * qR[1];
+	const a3real y = qL[3] * qR[1] - qL[0] * qR[2] + qL[1] * qR[3] + qL[2] * qR[0];
+	const a3real z = qL[3] * qR[2] + qL[0] * qR[1] - qL[1] * qR[0] + qL[2] * qR[3];
+	const a3real w = qL[3] * qR[3] - qL[0] * qR[0] - qL[1] * qR[1] - qL[2] * qR[2];
+	q_out[0] = x;
+	q_out[1] = y;
+	q_out[2] = z;
+	q_out[3] = w;
+	return q_out;
+}
+
+a3real4r a3quatConcatR(const a3real4p qL, a3real4p qR_inout)
+{
+	return a3quatProduct(qR_inout, qL, qR_inout);
+}
+
+a3real4r a3quatConcatL(a3real4p qL_inout, const a3real4p qR)
+{
+	return a3quatProduct(qL_inout, qL_inout, qR);
+}
+
+// XYZ order: rotate about X first, then Y, then Z
+a3real4r a3quatSetEulerXYZ(a3real4p q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	const a3real hx = degrees_x * a3real_deg2rad * a3real_half, hy = degrees_y * a3real_deg2rad * a3real_half, hz = degrees_z * a3real_deg2rad * a3real_half;
+	a3real4 qx = { sinf(hx), 0, 0, cosf(hx) }, qy = { 0, sinf(hy), 0, cosf(hy) }, qz = { 0, 0, sinf(hz), cosf(hz) };
+	a3quatProduct(q_out, qy, qx);
+	return a3quatProduct(q_out, qz, q_out);
+}
+
+// ZYX order: rotate about Z first, then Y, then X
+a3real4r a3quatSetEulerZYX(a3real4p q_out, const a3real degrees_x, const a3real degrees_y, const a3real degrees_z)
+{
+	const a3real hx = degrees_x * a3real_deg2rad * a3real_half, hy = degrees_y * a3real_deg2rad * a3real_half, hz = degrees_z * a3real_deg2rad * a3real_half;
+	a3real4 qx = { sinf(hx), 0, 0, cosf(hx) }, qy = { 0, sinf(hy), 0, cosf(hy) }, qz = { 0, 0, sinf(hz), cosf(hz) };
+	a3quatProduct(q_out, qy, qz);
+	return a3quatProduct(q_out, qx, q_out);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3real4x4r a3real4x4TransformInverse(a3real4x4p m_out, const a3real4x4p m)
+{
+	// inverse of upper 3x3 by cofactors, then translation
+	const a3real
+		c00 = m[1][1] * m[2][2] - m[2][1] * m[1][2],
+		c01 = m[2][1] * m[0][2] - m[0][1] * m[2][2],
+		c02 = m[0][1] * m[1][2] - m[1][1] * m[0][2],
+		c10 = m[2][0] * m[1][2] - m[1][0] * m[2][2],
+		c11 = m[0][0] * m[2][2] - m[2][0] * m[0][2],
+		c12 = m[1][0] * m[0][2] - m[0][0] * m[1][2],
+		c20 = m[1][0] * m[2][1] - m[2][0] * m[1][1],
+		c21 = m[2][0] * m[0][1] - m[0][0] * m[2][1],
+		c22 = m[0][0] * m[1][1] - m[1][0] * m[0][1],
+		det = m[0][0] * c00 + m[1][0] * c01 + m[2][0] * c02,
+		invDet = det != a3real_zero ? a3real_one / det : a3real_zero,
+		tx = m[3][0], ty = m[3][1], tz = m[3][2];
+	m_out[0][0] = c00 * invDet;	m_out[0][1] = c01 * invDet;	m_out[0][2] = c02 * invDet;	m_out[0][3] = a3real_zero;
+	m_out[1][0] = c10 * invDet;	m_out[1][1] = c11 * invDet;	m_out[1][2] = c12 * invDet;	m_out[1][3] = a3real_zero;
+	m_out[2][0] = c20 * invDet;	m_out[2][1] = c21 * invDet;	m_out[2][2] = c22 * invDet;	m_out[2][3] = a3real_zero;
+	m_out[3][0] = -(m_out[0][0] * tx + m_out[1][0] * ty + m_out[2][0] * tz);
+	m_out[3][1] = -(m_out[0][1] * tx + m_out[1][1] * ty + m_out[2][1] * tz);
+	m_out[3][2] = -(m_out[0][2] * tx + m_out[1][2] * ty + m_out[2][2] * tz);
+	m_out[3][3] = a3real_one;
+	return m_out;
+}
+
+
+//-----------------------------------------------------------------------------
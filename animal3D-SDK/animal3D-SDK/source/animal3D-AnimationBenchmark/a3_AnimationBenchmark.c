@@ -0,0 +1,610 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_AnimationBenchmark.c
+	Headless benchmark for the animation pipeline: loads a skeleton and clip
+		from HTR and times sampling, retargeting, blending, forward 
+		kinematics, recovering local matrices from object matrices and 
+		skinning palette updates over a sweep of character and thread 
+		counts. Results are printed as one JSON object per line.
+	No IK solver runs here: the "local" stage is only the object-to-local 
+		pass that follows one.
+	Math entry points come from stand-ins, not the precompiled A3DM 
+		library (see a3_AnimationBenchmark-A3DM.c), so the numbers are 
+		not A3DM numbers.
+	The clip is retargeted onto a renamed copy of its skeleton with longer 
+		bones, which is the skeleton the later stages run on.
+	Playback is driven by a playback log: each frame's time step and its
+		clip and rate events are replayed before the frame is timed. The
+		log is loaded with -replay or generated, and -record saves it.
+	Characters are split into groups that share a playback clock, like a
+		crowd, and sampled poses are shared through a pose cache; -nocache
+		samples every character instead.
+
+	usage: a3_AnimationBenchmark [file.htr] [-frames N] [-characters N]
+		[-threads N] [-groups N] [-replay file.a3pl] [-record file.a3pl]
+		[-nocache]
+*/
+
+#include "_animation/a3_HierarchyStateBlend.h"
+#include "_animation/a3_Kinematics.h"
+#include "_animation/a3_PlaybackLog.h"
+#include "_animation/a3_PoseCache.h"
+#include "_animation/a3_Retarget.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+
+//-----------------------------------------------------------------------------
+
+#define A3_BENCHMARK_DEFAULT_FILE	"../../resource/animdata/egnaro/egnaro_skel_anim.htr"
+
+// generated log: frames at 60 Hz, a rate change every 'rate' frames and 
+//	a clip restart every 'clip' frames, each for the next controller
+enum a3_BenchmarkLog
+{
+	a3benchmarkLog_frames = 600,
+	a3benchmarkLog_rate = 45,
+	a3benchmarkLog_clip = 240,
+	a3benchmarkLog_events = 8,		// controller events handled per frame
+};
+
+// pose cache: default number of playback groups, poses kept per group and 
+//	time quantization
+enum a3_BenchmarkCache
+{
+	a3benchmarkCache_groups = 32,
+	a3benchmarkCache_posesPerGroup = 4,
+	a3benchmarkCache_ticksPerSecond = 120,
+};
+
+// retarget skeleton: source names with a prefix, bones scaled
+#define A3_BENCHMARK_RETARGET_PREFIX	"r_"
+#define A3_BENCHMARK_RETARGET_SCALE		((a3real)1.2)
+
+enum a3_BenchmarkStage
+{
+	a3benchmark_sample,
+	a3benchmark_retarget,
+	a3benchmark_blend,
+	a3benchmark_fk,
+	a3benchmark_local,
+	a3benchmark_palette,
+	a3benchmark_total,
+
+	a3benchmark_stageMax
+};
+
+static const a3byte *a3benchmarkStageName[a3benchmark_stageMax] = {
+	"sample", "retarget", "blend", "fk", "local", "palette", "total",
+};
+
+
+// data shared by all workers for one configuration
+typedef struct a3_Benchmark
+{
+	const a3_Hierarchy *hierarchy;
+	const a3_HierarchyPoseGroup *poseGroup;
+	a3real frameRate;
+
+	// playback: one controller per group, character i belongs to group 
+	//	(i mod groups) and events for controller i apply to group 
+	//	(i mod groups)
+	a3_PlaybackLog *log;
+	a3real *time, *rate;
+	a3ui32 numGroups;
+
+	// sampled poses shared by characters in the same group (optional)
+	a3_PoseCache *cache;
+
+	// clip skeleton to character skeleton; both have the same node count
+	const a3_RetargetMap *retarget;
+
+	// per-character streams: sampled (clip skeleton), retargeted and 
+	//	second blend input (character skeleton)
+	a3_SpatialPoseSoA poseA, poseR, poseB;
+	a3mat4 *objectMat, *localMat, *palette;
+	const a3mat4 *objectBindInverse;
+
+	// configuration
+	a3ui32 numCharacters, numThreads, numFrames, numWarmup;
+
+	// per-frame stage times in nanoseconds
+	a3ui64 *stageTime[a3benchmark_stageMax];
+
+	pthread_barrier_t barrier;
+} a3_Benchmark;
+
+typedef struct a3_BenchmarkWorker
+{
+	a3_Benchmark *benchmark;
+	a3ui32 index;
+	pthread_t thread;
+} a3_BenchmarkWorker;
+
+
+//-----------------------------------------------------------------------------
+
+inline a3ui64 a3benchmarkInternalTime()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((a3ui64)ts.tv_sec * 1000000000ull + (a3ui64)ts.tv_nsec);
+}
+
+// view of a range of poses in a stream
+inline a3_SpatialPoseSoA *a3benchmarkInternalPoseView(a3_SpatialPoseSoA *view_out, const a3_SpatialPoseSoA *pose, const a3ui32 first, const a3ui32 count)
+{
+	a3ui32 i;
+	for (i = 0; i < 4; ++i)
+		view_out->orientation[i] = pose->orientation[i] + first;
+	for (i = 0; i < 3; ++i)
+	{
+		view_out->translation[i] = pose->translation[i] + first;
+		view_out->scale[i] = pose->scale[i] + first;
+	}
+	view_out->count = count;
+	view_out->data = pose->data;
+	return view_out;
+}
+
+int a3benchmarkInternalCompare(void const *a, void const *b)
+{
+	const a3ui64 lhs = *(const a3ui64 *)a, rhs = *(const a3ui64 *)b;
+	return (lhs > rhs) - (lhs < rhs);
+}
+
+// run one stage for this worker's characters
+inline void a3benchmarkInternalStage(const a3_Benchmark *b, const a3ui32 stage, const a3ui32 c0, const a3ui32 c1)
+{
+	const a3ui32 n = b->hierarchy->numNodes;
+	const a3ui32 numKeys = b->poseGroup->poseCount - 1;
+	a3_PoseCacheKey key;
+	a3_SpatialPoseSoA viewA, viewR;
+	a3ui32 c, first;
+	a3real t, u;
+	a3ui32 k;
+
+	for (c = c0, first = c0 * n; c < c1; ++c, first += n)
+	{
+		switch (stage)
+		{
+		case a3benchmark_sample:
+			// with the cache, sample at the quantized time and share the 
+			//	result with the rest of the group
+			t = b->time[c % b->numGroups];
+			if (b->cache)
+			{
+				a3poseCacheKeyInit(&key, b->poseGroup, 0, a3poseCacheQuantizeTime(b->cache, t));
+				if (a3poseCacheLookup(b->cache, &key, &b->poseA, first) > 0)
+					break;
+				t = (a3real)key.timeTick / b->cache->ticksPerSecond;
+			}
+
+			// keys loop, so the spline neighbors wrap around
+			t *= b->frameRate;
+			k = (a3ui32)t;
+			u = t - (a3real)k;
+			a3hierarchyPoseGroupSampleCubic(&b->poseA, first, b->poseGroup, 1 + (k + numKeys - 1) % numKeys, 1 + k % numKeys, 1 + (k + 1) % numKeys, 1 + (k + 2) % numKeys, u);
+			if (b->cache)
+				a3poseCacheStore(b->cache, &key, &b->poseA, first);
+			break;
+		case a3benchmark_retarget:
+			a3retargetPoseTransfer(b->retarget, a3benchmarkInternalPoseView(&viewR, &b->poseR, first, n), a3benchmarkInternalPoseView(&viewA, &b->poseA, first, n), 1);
+			break;
+		case a3benchmark_blend:
+			a3spatialPoseSoALerp(&b->poseR, first, &b->poseR, first, &b->poseB, first, n, (a3real)0.25);
+			break;
+		case a3benchmark_fk:
+			a3kinematicsSolveForwardSoA(b->hierarchy, b->objectMat + first, b->localMat + first, &b->poseR, first);
+			break;
+		case a3benchmark_local:
+			a3kinematicsSolveInverseMat(b->hierarchy, b->localMat + first, b->objectMat + first);
+			break;
+		case a3benchmark_palette:
+			a3kinematicsUpdateSkinPalette(b->palette + first, b->objectMat + first, b->objectBindInverse, n);
+			break;
+		}
+	}
+}
+
+// replay the next frame of the log into the group clocks; the log loops 
+//	when it runs out; also starts the cache's frame
+void a3benchmarkInternalReplayFrame(a3_Benchmark *b)
+{
+	a3_PlaybackEvent event[a3benchmarkLog_events];
+	a3ui32 numEvents, i, c;
+	a3real dt;
+
+	if (a3playbackLogReplayFrame(b->log, &dt, event, &numEvents, a3benchmarkLog_events) <= 0)
+	{
+		a3playbackLogRewind(b->log);
+		if (a3playbackLogReplayFrame(b->log, &dt, event, &numEvents, a3benchmarkLog_events) <= 0)
+			return;
+	}
+	for (i = 0; i < numEvents; ++i)
+	{
+		c = event[i].controllerIndex % b->numGroups;
+		switch (event[i].type)
+		{
+		case a3playbackEvent_clip:
+			// the HTR file is a single clip, so switching restarts it
+			b->time[c] = a3real_zero;
+			break;
+		case a3playbackEvent_rate:
+			b->rate[c] = event[i].rate;
+			break;
+		}
+	}
+	for (c = 0; c < b->numGroups; ++c)
+		b->time[c] += dt * b->rate[c];
+	if (b->cache)
+		a3poseCacheBeginFrame(b->cache);
+}
+
+void *a3benchmarkInternalWorker(void *arg)
+{
+	const a3_BenchmarkWorker *worker = (const a3_BenchmarkWorker *)arg;
+	a3_Benchmark *b = worker->benchmark;
+	const a3ui32 c0 = (a3ui32)((a3ui64)b->numCharacters * worker->index / b->numThreads);
+	const a3ui32 c1 = (a3ui32)((a3ui64)b->numCharacters * (worker->index + 1) / b->numThreads);
+	a3ui32 frame, stage, record;
+	a3ui64 t0 = 0, t1, tFrame = 0;
+
+	for (frame = 0; frame < b->numWarmup + b->numFrames; ++frame)
+	{
+		record = frame >= b->numWarmup;
+		if (worker->index == 0)
+			a3benchmarkInternalReplayFrame(b);
+		for (stage = 0; stage < a3benchmark_total; ++stage)
+		{
+			pthread_barrier_wait(&b->barrier);
+			if (worker->index == 0)
+			{
+				t0 = a3benchmarkInternalTime();
+				if (stage == 0)
+					tFrame = t0;
+			}
+			a3benchmarkInternalStage(b, stage, c0, c1);
+			pthread_barrier_wait(&b->barrier);
+			if (worker->index == 0 && record)
+			{
+				t1 = a3benchmarkInternalTime();
+				b->stageTime[stage][frame - b->numWarmup] = t1 - t0;
+				if (stage == a3benchmark_total - 1)
+					b->stageTime[a3benchmark_total][frame - b->numWarmup] = t1 - tFrame;
+			}
+		}
+	}
+	return 0;
+}
+
+// run one configuration and print results
+void a3benchmarkInternalRun(a3_Benchmark *b, a3_BenchmarkWorker *workers)
+{
+	const a3ui64 bonesPerFrame = (a3ui64)b->numCharacters * b->hierarchy->numNodes;
+	a3ui64 *t, sum;
+	a3ui32 i, stage;
+
+	// every configuration replays the same log from the start; groups are 
+	//	offset in time so that samples differ
+	a3playbackLogRewind(b->log);
+	for (i = 0; i < b->numGroups; ++i)
+	{
+		b->time[i] = (a3real)i * (a3real)0.0137;
+		b->rate[i] = a3real_one;
+	}
+
+	pthread_barrier_init(&b->barrier, 0, b->numThreads);
+	for (i = 0; i < b->numThreads; ++i)
+	{
+		workers[i].benchmark = b;
+		workers[i].index = i;
+	}
+	for (i = 1; i < b->numThreads; ++i)
+		pthread_create(&workers[i].thread, 0, a3benchmarkInternalWorker, workers + i);
+	a3benchmarkInternalWorker(workers);
+	for (i = 1; i < b->numThreads; ++i)
+		pthread_join(workers[i].thread, 0);
+	pthread_barrier_destroy(&b->barrier);
+
+	for (stage = 0; stage < a3benchmark_stageMax; ++stage)
+	{
+		t = b->stageTime[stage];
+		for (i = 0, sum = 0; i < b->numFrames; ++i)
+			sum += t[i];
+		qsort(t, b->numFrames, sizeof(a3ui64), a3benchmarkInternalCompare);
+		printf("{\"stage\":\"%s\",\"characters\":%u,\"threads\":%u,\"frames\":%u,\"bones\":%u,"
+			"\"ns_per_bone\":%.3f,\"bones_per_sec\":%.0f,"
+			"\"frame_ns_min\":%llu,\"frame_ns_p50\":%llu,\"frame_ns_p90\":%llu,\"frame_ns_p99\":%llu,\"frame_ns_max\":%llu}\n",
+			a3benchmarkStageName[stage], b->numCharacters, b->numThreads, b->numFrames, b->hierarchy->numNodes,
+			(double)sum / (double)(bonesPerFrame * b->numFrames),
+			(double)(bonesPerFrame * b->numFrames) * 1.0e9 / (double)(sum ? sum : 1),
+			(unsigned long long)t[0],
+			(unsigned long long)t[b->numFrames * 50 / 100],
+			(unsigned long long)t[b->numFrames * 90 / 100],
+			(unsigned long long)t[b->numFrames * 99 / 100],
+			(unsigned long long)t[b->numFrames - 1]);
+	}
+	fflush(stdout);
+}
+
+
+// open a log file for reading or writing
+inline a3i32 a3benchmarkInternalLogFile(a3_PlaybackLog *log, const a3byte *filePath, const a3boolean save)
+{
+	a3_FileStream fileStream = { 0 };
+	a3i32 result = -1;
+	fileStream.stream = fopen(filePath, save ? "wb" : "rb");
+	if (fileStream.stream)
+	{
+		result = save ? a3playbackLogSaveBinary(log, &fileStream) : a3playbackLogLoadBinary(log, &fileStream);
+		fclose((FILE *)fileStream.stream);
+	}
+	return result;
+}
+
+// generate the default log: steady 60 Hz frames with playback rate 
+//	changes and clip restarts spread over the controllers
+inline a3i32 a3benchmarkInternalLogGenerate(a3_PlaybackLog *log)
+{
+	a3ui32 frame;
+	if (a3playbackLogCreate(log, a3benchmarkLog_frames * 2) <= 0)
+		return 0;
+	for (frame = 0; frame < a3benchmarkLog_frames; ++frame)
+	{
+		if (a3playbackLogRecordFrame(log, (a3real)1 / (a3real)60) <= 0)
+			return 0;
+		if (frame % a3benchmarkLog_rate == 0)
+			a3playbackLogRecordRate(log, frame / a3benchmarkLog_rate, (a3real)(frame / a3benchmarkLog_rate % 5 + 3) / (a3real)4);
+		if (frame % a3benchmarkLog_clip == a3benchmarkLog_clip - 1)
+			a3playbackLogRecordClip(log, frame / a3benchmarkLog_clip, 0);
+	}
+	return log->numFrames;
+}
+
+
+//-----------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+	const a3byte *filePath = A3_BENCHMARK_DEFAULT_FILE;
+	const a3byte *replayPath = 0, *recordPath = 0;
+	a3_PlaybackLog log = { 0 };
+	a3_PoseCache cache = { 0 };
+	a3boolean useCache = a3true;
+	a3ui32 numFrames = 60, maxCharacters = 10000, maxThreads = 0, maxGroups = a3benchmarkCache_groups;
+	a3_Hierarchy hierarchy = { 0 }, character = { 0 };
+	a3_HierarchyPoseGroup poseGroup = { 0 };
+	a3_SpatialPoseSoA characterRest = { 0 };
+	a3_RetargetMap retarget = { 0 };
+	const a3_RetargetRule retargetRule = { a3retargetRule_prefixTarget, A3_BENCHMARK_RETARGET_PREFIX, 0 };
+	a3byte name[a3node_nameSize];
+	a3_Benchmark b = { 0 };
+	a3_BenchmarkWorker *workers;
+	a3mat4 *bindObject, *bindLocal, *bindInverse;
+	a3ui32 n, i, stage, numCharacters, numThreads;
+	a3real frameRate = (a3real)30;
+	int arg;
+
+	for (arg = 1; arg < argc; ++arg)
+	{
+		if (!strcmp(argv[arg], "-frames") && arg + 1 < argc)
+			numFrames = (a3ui32)atoi(argv[++arg]);
+		else if (!strcmp(argv[arg], "-characters") && arg + 1 < argc)
+			maxCharacters = (a3ui32)atoi(argv[++arg]);
+		else if (!strcmp(argv[arg], "-threads") && arg + 1 < argc)
+			maxThreads = (a3ui32)atoi(argv[++arg]);
+		else if (!strcmp(argv[arg], "-replay") && arg + 1 < argc)
+			replayPath = argv[++arg];
+		else if (!strcmp(argv[arg], "-record") && arg + 1 < argc)
+			recordPath = argv[++arg];
+		else if (!strcmp(argv[arg], "-groups") && arg + 1 < argc)
+			maxGroups = (a3ui32)atoi(argv[++arg]);
+		else if (!strcmp(argv[arg], "-nocache"))
+			useCache = a3false;
+		else if (argv[arg][0] != '-')
+			filePath = argv[arg];
+		else
+		{
+			fprintf(stderr, "usage: %s [file.htr] [-frames N] [-characters N] [-threads N] [-groups N] [-replay file.a3pl] [-record file.a3pl] [-nocache]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (!numFrames)
+		numFrames = 1;
+	if (!maxCharacters)
+		maxCharacters = 1;
+	if (!maxGroups)
+		maxGroups = 1;
+	if (!maxThreads)
+	{
+		const long numCores = sysconf(_SC_NPROCESSORS_ONLN);
+		maxThreads = numCores > 0 ? (a3ui32)numCores : 1;
+	}
+
+	// load skeleton and clip
+	if (a3hierarchyPoseGroupLoadHTR(&poseGroup, &hierarchy, filePath, &frameRate) <= 1)
+	{
+		fprintf(stderr, "could not load animation from '%s'\n", filePath);
+		return 1;
+	}
+	n = hierarchy.numNodes;
+	fprintf(stderr, "loaded '%s': %u bones, %u poses, %g fps\n", filePath, n, poseGroup.poseCount, (double)frameRate);
+
+	// playback log to replay
+	if (replayPath)
+	{
+		if (a3benchmarkInternalLogFile(&log, replayPath, a3false) <= 0 || !log.numFrames)
+		{
+			fprintf(stderr, "could not load playback log from '%s'\n", replayPath);
+			return 1;
+		}
+		fprintf(stderr, "replaying '%s': %u frames, %u events\n", replayPath, log.numFrames, log.count);
+	}
+	else if (a3benchmarkInternalLogGenerate(&log) <= 0)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	if (recordPath && a3benchmarkInternalLogFile(&log, recordPath, a3true) <= 0)
+	{
+		fprintf(stderr, "could not save playback log to '%s'\n", recordPath);
+		return 1;
+	}
+
+	// character skeleton: renamed copy of the clip skeleton with longer bones
+	if (a3hierarchyCreate(&character, n, 0) <= 0 || a3spatialPoseSoACreate(&characterRest, n) < 0)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	for (i = 0; i < n; ++i)
+	{
+		snprintf(name, sizeof(name), A3_BENCHMARK_RETARGET_PREFIX "%.*s", (int)(sizeof(name) - sizeof(A3_BENCHMARK_RETARGET_PREFIX)), hierarchy.nodes[i].name);
+		a3hierarchySetNode(&character, i, hierarchy.nodes[i].parentIndex, name);
+	}
+	a3spatialPoseSoACopy(&characterRest, 0, &poseGroup.pose, 0, n);
+	for (stage = 0; stage < 3; ++stage)
+		for (i = 0; i < n; ++i)
+			characterRest.translation[stage][i] *= A3_BENCHMARK_RETARGET_SCALE;
+	if (a3retargetMapCreate(&retarget, &character, &characterRest, &hierarchy, &poseGroup.pose, &retargetRule, 1) <= 0)
+	{
+		fprintf(stderr, "could not create retargeting map\n");
+		return 1;
+	}
+	fprintf(stderr, "retargeting onto character skeleton: %u of %u nodes mapped\n", retarget.numMapped, n);
+
+	// bind pose: character rest pose in object space, inverted
+	bindObject = (a3mat4 *)malloc(sizeof(a3mat4) * n * 3);
+	bindLocal = bindObject + n;
+	bindInverse = bindLocal + n;
+	a3kinematicsSolveForwardSoA(&character, bindObject, bindLocal, &characterRest, 0);
+	for (i = 0; i < n; ++i)
+		a3real4x4TransformInverse(bindInverse[i].m, bindObject[i].m);
+
+	// per-character data for the largest configuration
+	b.hierarchy = &character;
+	b.retarget = &retarget;
+	b.poseGroup = &poseGroup;
+	b.frameRate = frameRate;
+	b.log = &log;
+	b.objectBindInverse = bindInverse;
+	b.numFrames = numFrames;
+	b.numWarmup = numFrames < 10 ? numFrames : 10;
+	if (a3spatialPoseSoACreate(&b.poseA, maxCharacters * n) < 0 ||
+		a3spatialPoseSoACreate(&b.poseR, maxCharacters * n) < 0 ||
+		a3spatialPoseSoACreate(&b.poseB, maxCharacters * n) < 0)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	b.objectMat = (a3mat4 *)malloc(sizeof(a3mat4) * maxCharacters * n * 3);
+	b.localMat = b.objectMat + maxCharacters * n;
+	b.palette = b.localMat + maxCharacters * n;
+	b.stageTime[0] = (a3ui64 *)malloc(sizeof(a3ui64) * numFrames * a3benchmark_stageMax);
+	b.time = (a3real *)malloc(sizeof(a3real) * maxGroups * 2);
+	b.rate = b.time + maxGroups;
+	workers = (a3_BenchmarkWorker *)malloc(sizeof(a3_BenchmarkWorker) * maxThreads);
+	if (!b.objectMat || !b.stageTime[0] || !b.time || !workers)
+	{
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	if (useCache)
+	{
+		if (a3poseCacheCreate(&cache, &hierarchy, maxGroups * a3benchmarkCache_posesPerGroup, (a3real)a3benchmarkCache_ticksPerSecond) <= 0)
+		{
+			fprintf(stderr, "out of memory\n");
+			return 1;
+		}
+		b.cache = &cache;
+	}
+	memset(b.objectMat, 0, sizeof(a3mat4) * maxCharacters * n * 3);
+	for (stage = 1; stage < a3benchmark_stageMax; ++stage)
+		b.stageTime[stage] = b.stageTime[stage - 1] + numFrames;
+
+	// second blend input: a fixed pose from the middle of the clip
+	for (i = 0; i < maxCharacters; ++i)
+		a3hierarchyPoseGroupSample(&b.poseA, i * n, &poseGroup, poseGroup.poseCount / 2, poseGroup.poseCount / 2, a3real_zero);
+	a3retargetPoseTransfer(&retarget, &b.poseB, &b.poseA, maxCharacters);
+
+	// sweep characters by decade, ending at the maximum, and threads by 
+	//	powers of two
+	for (numCharacters = 1; ; numCharacters = numCharacters <= maxCharacters / 10 ? numCharacters * 10 : maxCharacters)
+	{
+		for (numThreads = 1; ; numThreads *= 2)
+		{
+			if (numThreads > maxThreads)
+				numThreads = maxThreads;
+			b.numCharacters = numCharacters;
+			b.numGroups = numCharacters < maxGroups ? numCharacters : maxGroups;
+			b.numThreads = numThreads < numCharacters ? numThreads : numCharacters;
+			a3benchmarkInternalRun(&b, workers);
+			if (numThreads >= maxThreads || numThreads >= numCharacters)
+				break;
+		}
+		if (numCharacters == maxCharacters)
+			break;
+	}
+
+	free(workers);
+	a3poseCacheRelease(&cache);
+	free(b.time);
+	free(b.stageTime[0]);
+	free(b.objectMat);
+	a3spatialPoseSoARelease(&b.poseB);
+	a3spatialPoseSoARelease(&b.poseR);
+	a3spatialPoseSoARelease(&b.poseA);
+	free(bindObject);
+	a3retargetMapRelease(&retarget);
+	a3spatialPoseSoARelease(&characterRest);
+	a3hierarchyRelease(&character);
+	a3hierarchyPoseGroupRelease(&poseGroup);
+	a3hierarchyRelease(&hierarchy);
+	a3playbackLogRelease(&log);
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// animation sources: their headers define inline functions with external 
+//	linkage, which MSVC merges across translation units but GCC and Clang 
+//	emit in each one, so the sources are built as part of this unit
+
+#include "_animation/_src/a3_Hierarchy.c"
+#include "_animation/_src/a3_HierarchyState.c"
+#include "_animation/_src/a3_HierarchyStateBlend.c"
+#include "_animation/_src/a3_Kinematics.c"
+#include "_animation/_src/a3_MatrixBatch.c"
+#include "_animation/_src/a3_PlaybackLog.c"
+#include "_animation/_src/a3_PoseCache.c"
+#include "_animation/_src/a3_QuaternionBatch.c"
+#include "_animation/_src/a3_Retarget.c"
+#include "_animation/_src/a3_SpatialPose.c"
+#include "_animation/_src/a3_TrigBatch.c"
+
+
+//-----------------------------------------------------------------------------
@@ -332,6 +332,8 @@ A3DYLIBSYMBOL a3i32 a3demoCB_idle(a3_DemoState *demoState)
 				demoState->dt_timer = demoState->timer_display->totalTime - demoState->t_timer;
 				demoState->dt_timer_tot += demoState->dt_timer;
 				demoState->t_timer = demoState->timer_display->totalTime;
+				a3statsAccumulatorAdd(demoState->dt_timer_stats, demoState->dt_timer);
+				a3statsQuantileAdd(demoState->dt_timer_p99, demoState->dt_timer);
 			}
 			else
 			{
@@ -339,6 +341,8 @@ A3DYLIBSYMBOL a3i32 a3demoCB_idle(a3_DemoState *demoState)
 				demoState->dt_timer = demoState->timer_display->totalTime;
 				demoState->dt_timer_tot = 0.0;
 				demoState->t_timer = demoState->timer_display->totalTime;
+				a3statsAccumulatorReset(demoState->dt_timer_stats);
+				a3statsQuantileReset(demoState->dt_timer_p99, 0.99);
 			}
 
 			// main idle loop
@@ -0,0 +1,639 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoBVH.c
+	Dynamic bounding volume hierarchy implementation.
+*/
+
+#include "../a3_DemoBVH.h"
+
+#include "animal3D/a3utility/a3_Thread.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+// subtrees refit by one worker thread: every stride-th root of the cut,
+//	starting at the first
+typedef struct a3_DemoBVHRefitJob
+{
+	a3_DemoBVH *bvh;
+	a3_DemoCullingBounds const *bounds;
+	a3ui32 const *root;
+	a3ui32 first, count, stride;
+	a3real cost;
+} a3_DemoBVHRefitJob;
+
+// SAH candidate bin
+typedef struct a3_DemoBVHBin
+{
+	a3real boxMin[3], boxMax[3];
+	a3ui32 count;
+} a3_DemoBVHBin;
+
+
+//-----------------------------------------------------------------------------
+
+// half surface area of box, proportional to the chance a ray hits it
+inline a3real a3demoBVHInternalArea(const a3real *boxMin, const a3real *boxMax)
+{
+	const a3real dx = boxMax[0] - boxMin[0], dy = boxMax[1] - boxMin[1], dz = boxMax[2] - boxMin[2];
+	return (dx * dy + dy * dz + dz * dx);
+}
+
+// set box to one object's box
+inline void a3demoBVHInternalSetObject(a3real *boxMin, a3real *boxMax, a3_DemoCullingBounds const *bounds, const a3ui32 index)
+{
+	a3ui32 r;
+	for (r = 0; r < 3; ++r)
+	{
+		boxMin[r] = bounds->center[r][index] - bounds->extent[r][index];
+		boxMax[r] = bounds->center[r][index] + bounds->extent[r][index];
+	}
+}
+
+// grow box to include one object's box
+inline void a3demoBVHInternalGrowObject(a3real *boxMin, a3real *boxMax, a3_DemoCullingBounds const *bounds, const a3ui32 index)
+{
+	a3ui32 r;
+	a3real v;
+	for (r = 0; r < 3; ++r)
+	{
+		v = bounds->center[r][index] - bounds->extent[r][index];
+		boxMin[r] = v < boxMin[r] ? v : boxMin[r];
+		v = bounds->center[r][index] + bounds->extent[r][index];
+		boxMax[r] = v > boxMax[r] ? v : boxMax[r];
+	}
+}
+
+// set box to the union of two boxes
+inline void a3demoBVHInternalUnion(a3real *boxMin, a3real *boxMax, const a3real *boxMinA, const a3real *boxMaxA, const a3real *boxMinB, const a3real *boxMaxB)
+{
+	a3ui32 r;
+	for (r = 0; r < 3; ++r)
+	{
+		boxMin[r] = boxMinA[r] < boxMinB[r] ? boxMinA[r] : boxMinB[r];
+		boxMax[r] = boxMaxA[r] > boxMaxB[r] ? boxMaxA[r] : boxMaxB[r];
+	}
+}
+
+// refit one node from its objects or children; returns its cost term
+inline a3real a3demoBVHInternalRefitNode(a3_DemoBVH *bvh, a3_DemoCullingBounds const *bounds, const a3ui32 index)
+{
+	a3_DemoBVHNode *node = bvh->node + index;
+	a3ui32 i;
+	if (node->right)
+	{
+		a3_DemoBVHNode const *left = node + 1, *right = bvh->node + node->right;
+		a3demoBVHInternalUnion(node->boxMin, node->boxMax, left->boxMin, left->boxMax, right->boxMin, right->boxMax);
+		return a3demoBVHInternalArea(node->boxMin, node->boxMax);
+	}
+	a3demoBVHInternalSetObject(node->boxMin, node->boxMax, bounds, bvh->object[node->first]);
+	for (i = 1; i < node->count; ++i)
+		a3demoBVHInternalGrowObject(node->boxMin, node->boxMax, bounds, bvh->object[node->first + i]);
+	return a3demoBVHInternalArea(node->boxMin, node->boxMax) * (a3real)node->count;
+}
+
+// refit a whole subtree; children follow their parents, so walking the
+//	node range backward visits every child before its parent
+inline a3real a3demoBVHInternalRefitSubtree(a3_DemoBVH *bvh, a3_DemoCullingBounds const *bounds, const a3ui32 root)
+{
+	a3real cost = a3real_zero;
+	a3ui32 i;
+	for (i = bvh->node[root].skip; i > root; --i)
+		cost += a3demoBVHInternalRefitNode(bvh, bounds, i - 1);
+	return cost;
+}
+
+// worker thread entry
+a3ret a3demoBVHInternalRefitThread(void *args)
+{
+	a3_DemoBVHRefitJob *job = (a3_DemoBVHRefitJob *)args;
+	a3ui32 i;
+	job->cost = a3real_zero;
+	for (i = job->first; i < job->count; i += job->stride)
+		job->cost += a3demoBVHInternalRefitSubtree(job->bvh, job->bounds, job->root[i]);
+	return job->count;
+}
+
+// cost normalized by the root area so it compares across frames
+inline a3real a3demoBVHInternalNormalizeCost(a3_DemoBVH const *bvh, const a3real cost)
+{
+	const a3real area = a3demoBVHInternalArea(bvh->node->boxMin, bvh->node->boxMax);
+	return area > a3real_zero ? cost / area : a3real_zero;
+}
+
+// build subtree at node over a range of the object list; returns the
+//	next free node and accumulates the cost
+inline a3ui32 a3demoBVHInternalBuild(a3_DemoBVH *bvh, a3_DemoCullingBounds const *bounds, const a3ui32 index, const a3ui32 first, const a3ui32 count, const a3ui32 depth, a3real *cost)
+{
+	a3_DemoBVHNode *node = bvh->node + index;
+	a3ui32 *object = bvh->object + first;
+	a3real centerMin[3], centerMax[3], c;
+	a3real area, extent = a3real_zero, scale;
+	a3ui32 i, r, axis = 0, numLeft = count / 2, next;
+
+	// node box and bounds of object centers
+	a3demoBVHInternalSetObject(node->boxMin, node->boxMax, bounds, object[0]);
+	for (r = 0; r < 3; ++r)
+		centerMin[r] = centerMax[r] = bounds->center[r][object[0]];
+	for (i = 1; i < count; ++i)
+	{
+		a3demoBVHInternalGrowObject(node->boxMin, node->boxMax, bounds, object[i]);
+		for (r = 0; r < 3; ++r)
+		{
+			c = bounds->center[r][object[i]];
+			centerMin[r] = c < centerMin[r] ? c : centerMin[r];
+			centerMax[r] = c > centerMax[r] ? c : centerMax[r];
+		}
+	}
+	for (r = 0; r < 3; ++r)
+		if (centerMax[r] - centerMin[r] > extent)
+		{
+			extent = centerMax[r] - centerMin[r];
+			axis = r;
+		}
+	area = a3demoBVHInternalArea(node->boxMin, node->boxMax);
+	node->first = first;
+	node->count = count;
+
+	if (count > 1 && extent > a3real_zero && depth < a3demo_bvhDepthMax)
+	{
+		// bin centers along the widest axis and sweep for the cheapest split
+		a3_DemoBVHBin bin[a3demo_bvhBinCount];
+		a3real areaLeft[a3demo_bvhBinCount], boxMin[3], boxMax[3], splitCost, bestCost = a3real_zero;
+		a3ui32 countLeft[a3demo_bvhBinCount], b, best = 0, total;
+		scale = (a3real)a3demo_bvhBinCount / extent;
+		for (b = 0; b < a3demo_bvhBinCount; ++b)
+			bin[b].count = 0;
+		for (i = 0; i < count; ++i)
+		{
+			b = (a3ui32)((bounds->center[axis][object[i]] - centerMin[axis]) * scale);
+			b = b < a3demo_bvhBinCount ? b : a3demo_bvhBinCount - 1;
+			if (bin[b].count++)
+				a3demoBVHInternalGrowObject(bin[b].boxMin, bin[b].boxMax, bounds, object[i]);
+			else
+				a3demoBVHInternalSetObject(bin[b].boxMin, bin[b].boxMax, bounds, object[i]);
+		}
+
+		// left sweep stores area and count left of each boundary, right
+		//	sweep evaluates the split there
+		for (b = 0, total = 0; b < a3demo_bvhBinCount - 1; ++b)
+		{
+			if (bin[b].count)
+			{
+				if (total)
+					a3demoBVHInternalUnion(boxMin, boxMax, boxMin, boxMax, bin[b].boxMin, bin[b].boxMax);
+				else
+					memcpy(boxMin, bin[b].boxMin, sizeof(boxMin)), memcpy(boxMax, bin[b].boxMax, sizeof(boxMax));
+				total += bin[b].count;
+			}
+			countLeft[b + 1] = total;
+			areaLeft[b + 1] = total ? a3demoBVHInternalArea(boxMin, boxMax) : a3real_zero;
+		}
+		for (b = a3demo_bvhBinCount - 1, total = 0; b > 0; --b)
+		{
+			if (bin[b].count)
+			{
+				if (total)
+					a3demoBVHInternalUnion(boxMin, boxMax, boxMin, boxMax, bin[b].boxMin, bin[b].boxMax);
+				else
+					memcpy(boxMin, bin[b].boxMin, sizeof(boxMin)), memcpy(boxMax, bin[b].boxMax, sizeof(boxMax));
+				total += bin[b].count;
+			}
+			if (total && countLeft[b])
+			{
+				splitCost = areaLeft[b] * (a3real)countLeft[b] + a3demoBVHInternalArea(boxMin, boxMax) * (a3real)total;
+				if (!best || splitCost < bestCost)
+				{
+					bestCost = splitCost;
+					best = b;
+				}
+			}
+		}
+
+		// small nodes stay leaves when splitting (plus one traversal step)
+		//	costs more than testing every object
+		if (best && count <= a3demo_bvhLeafMax && bestCost + area >= area * (a3real)count)
+			best = 0, numLeft = 0;
+		else if (best)
+		{
+			// partition objects left of the chosen boundary to the front
+			for (i = 0, numLeft = 0; i < count; ++i)
+			{
+				b = (a3ui32)((bounds->center[axis][object[i]] - centerMin[axis]) * scale);
+				b = b < a3demo_bvhBinCount ? b : a3demo_bvhBinCount - 1;
+				if (b < best)
+				{
+					r = object[numLeft];
+					object[numLeft++] = object[i];
+					object[i] = r;
+				}
+			}
+		}
+	}
+	else if (count <= a3demo_bvhLeafMax)
+		numLeft = 0;
+
+	// coincident centers or too deep: split by count if too many for a leaf
+	if (numLeft == 0 && count > a3demo_bvhLeafMax)
+		numLeft = count / 2;
+
+	if (numLeft)
+	{
+		*cost += area;
+		next = a3demoBVHInternalBuild(bvh, bounds, index + 1, first, numLeft, depth + 1, cost);
+		node->right = next;
+		next = a3demoBVHInternalBuild(bvh, bounds, next, first + numLeft, count - numLeft, depth + 1, cost);
+		node->skip = next;
+		return next;
+	}
+
+	*cost += area * (a3real)count;
+	node->right = 0;
+	node->skip = index + 1;
+	return node->skip;
+}
+
+// scalar test of one object box against frustum
+inline a3boolean a3demoBVHInternalBoxOutside(a3_DemoCullingBounds const *bounds, a3_DemoCullingFrustum const *frustum, const a3ui32 i)
+{
+	const a3real x = bounds->center[0][i], y = bounds->center[1][i], z = bounds->center[2][i];
+	const a3real ex = bounds->extent[0][i], ey = bounds->extent[1][i], ez = bounds->extent[2][i];
+	a3ui32 p;
+	for (p = 0; p < 6; ++p)
+	{
+		const a3real *plane = frustum->plane[p].v;
+		const a3real reach = a3absolute(plane[0]) * ex + a3absolute(plane[1]) * ey + a3absolute(plane[2]) * ez;
+		if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] + reach < a3real_zero)
+			return a3true;
+	}
+	return a3false;
+}
+
+// classify node box against frustum: -1 outside, +1 inside, 0 crossing
+inline a3i32 a3demoBVHInternalNodeFrustum(a3_DemoBVHNode const *node, a3_DemoCullingFrustum const *frustum)
+{
+	a3real center[3], extent[3], d, reach;
+	a3i32 result = +1;
+	a3ui32 r, p;
+	for (r = 0; r < 3; ++r)
+	{
+		center[r] = (node->boxMax[r] + node->boxMin[r]) * a3real_half;
+		extent[r] = (node->boxMax[r] - node->boxMin[r]) * a3real_half;
+	}
+	for (p = 0; p < 6; ++p)
+	{
+		const a3real *plane = frustum->plane[p].v;
+		d = plane[0] * center[0] + plane[1] * center[1] + plane[2] * center[2] + plane[3];
+		reach = a3absolute(plane[0]) * extent[0] + a3absolute(plane[1]) * extent[1] + a3absolute(plane[2]) * extent[2];
+		if (d + reach < a3real_zero)
+			return -1;
+		if (d - reach < a3real_zero)
+			result = 0;
+	}
+	return result;
+}
+
+// box overlap and containment
+inline a3boolean a3demoBVHInternalOverlap(const a3real *boxMinA, const a3real *boxMaxA, const a3real *boxMinB, const a3real *boxMaxB)
+{
+	return (boxMinA[0] <= boxMaxB[0] && boxMaxA[0] >= boxMinB[0] &&
+		boxMinA[1] <= boxMaxB[1] && boxMaxA[1] >= boxMinB[1] &&
+		boxMinA[2] <= boxMaxB[2] && boxMaxA[2] >= boxMinB[2]);
+}
+
+inline a3boolean a3demoBVHInternalContains(const a3real *boxMinOuter, const a3real *boxMaxOuter, const a3real *boxMinInner, const a3real *boxMaxInner)
+{
+	return (boxMinOuter[0] <= boxMinInner[0] && boxMaxOuter[0] >= boxMaxInner[0] &&
+		boxMinOuter[1] <= boxMinInner[1] && boxMaxOuter[1] >= boxMaxInner[1] &&
+		boxMinOuter[2] <= boxMinInner[2] && boxMaxOuter[2] >= boxMaxInner[2]);
+}
+
+// slab test: entry distance of ray into box, if it enters at all and,
+//	when there is a nearest hit already, before that hit
+inline a3boolean a3demoBVHInternalRay(a3real *distance_out, const a3real *boxMin, const a3real *boxMax, const a3real *origin, const a3real *directionInv, const a3boolean limited, const a3real nearest)
+{
+	a3real tMin = a3real_zero, tMax = a3real_zero, t0, t1, t;
+	a3ui32 r;
+	for (r = 0; r < 3; ++r)
+	{
+		t0 = (boxMin[r] - origin[r]) * directionInv[r];
+		t1 = (boxMax[r] - origin[r]) * directionInv[r];
+		if (t0 > t1)
+			t = t0, t0 = t1, t1 = t;
+		tMin = (r == 0 || t0 > tMin) ? t0 : tMin;
+		tMax = (r == 0 || t1 < tMax) ? t1 : tMax;
+	}
+	tMin = tMin > a3real_zero ? tMin : a3real_zero;
+	if (tMin > tMax || (limited && tMin > nearest))
+		return a3false;
+	*distance_out = tMin;
+	return a3true;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3demo_createBVH(a3_DemoBVH *bvh_out, const a3ui32 capacity)
+{
+	if (bvh_out && !bvh_out->node && capacity)
+	{
+		const a3ui32 nodeCapacity = capacity * 2 - 1;
+		const size_t nodeSize = sizeof(a3_DemoBVHNode) * nodeCapacity;
+		a3byte *data = (a3byte *)malloc(nodeSize + sizeof(a3ui32) * capacity);
+		if (data)
+		{
+			memset(bvh_out, 0, sizeof(a3_DemoBVH));
+			bvh_out->node = (a3_DemoBVHNode *)data;
+			bvh_out->object = (a3ui32 *)(data + nodeSize);
+			bvh_out->capacity = capacity;
+			bvh_out->rebuildRatio = a3real_one + a3real_half;
+			bvh_out->refitMax = 120;
+			return capacity;
+		}
+	}
+	return -1;
+}
+
+a3i32 a3demo_releaseBVH(a3_DemoBVH *bvh)
+{
+	if (bvh && bvh->node)
+	{
+		// object list shares the node allocation
+		free(bvh->node);
+		memset(bvh, 0, sizeof(a3_DemoBVH));
+		return 1;
+	}
+	return -1;
+}
+
+a3i32 a3demo_buildBVH(a3_DemoBVH *bvh, a3_DemoCullingBounds const *bounds)
+{
+	if (bvh && bvh->node && bounds && bounds->radius && bounds->count <= bvh->capacity)
+	{
+		a3real cost = a3real_zero;
+		a3ui32 i;
+
+		// keep the previous leaf order when rebuilding the same objects;
+		//	it is already nearly partitioned
+		if (bvh->objectCount != bounds->count)
+			for (i = 0; i < bounds->count; ++i)
+				bvh->object[i] = i;
+		bvh->objectCount = bounds->count;
+		bvh->nodeCount = bounds->count ? a3demoBVHInternalBuild(bvh, bounds, 0, 0, bounds->count, 0, &cost) : 0;
+		bvh->cost = bvh->cost_build = bvh->nodeCount ? a3demoBVHInternalNormalizeCost(bvh, cost) : a3real_zero;
+		bvh->refitCount = 0;
+		return bvh->nodeCount;
+	}
+	return -1;
+}
+
+a3i32 a3demo_refitBVH(a3_DemoBVH *bvh, a3_DemoCullingBounds const *bounds, const a3ui32 numThreads)
+{
+	if (bvh && bvh->node && bounds && bounds->radius && bounds->count == bvh->objectCount && numThreads)
+	{
+		a3_Thread thread[a3demo_bvhThreadMax] = { 0 };
+		a3_DemoBVHRefitJob job[a3demo_bvhThreadMax];
+		a3boolean launched[a3demo_bvhThreadMax];
+		a3ui32 root[a3demo_bvhThreadMax * 2], top[a3demo_bvhThreadMax * 2];
+		a3ui32 n = numThreads < a3demo_bvhThreadMax ? numThreads : a3demo_bvhThreadMax;
+		a3ui32 numRoots = 1, numTop = 0, i, j, largest;
+		a3real cost = a3real_zero;
+
+		if (!bvh->nodeCount)
+			return 0;
+
+		// don't bother with threads for small trees
+		if (n > bvh->nodeCount / 512)
+			n = bvh->nodeCount / 512 + 1;
+
+		// cut the tree into subtrees for the workers by repeatedly splitting
+		//	the largest remaining subtree; split nodes are refit afterward
+		root[0] = 0;
+		while (n > 1 && numRoots < n * 2)
+		{
+			for (i = 0, largest = numRoots; i < numRoots; ++i)
+				if (bvh->node[root[i]].right && (largest == numRoots || bvh->node[root[i]].count > bvh->node[root[largest]].count))
+					largest = i;
+			if (largest == numRoots)
+				break;
+			top[numTop++] = root[largest];
+			root[numRoots++] = bvh->node[root[largest]].right;
+			root[largest] += 1;
+		}
+
+		for (i = 0; i < n; ++i)
+		{
+			job[i].bvh = bvh;
+			job[i].bounds = bounds;
+			job[i].root = root;
+			job[i].first = i;
+			job[i].count = numRoots;
+			job[i].stride = n;
+		}
+		// if a thread fails to launch, its subtrees are refit here instead
+		for (i = 1; i < n; ++i)
+			if ((launched[i] = (a3threadLaunch(thread + i, a3demoBVHInternalRefitThread, job + i, 0) > 0)) == 0)
+				a3demoBVHInternalRefitThread(job + i);
+		a3demoBVHInternalRefitThread(job);
+		for (i = 1; i < n; ++i)
+			if (launched[i])
+				a3threadWait(thread + i);
+		for (i = 0; i < n; ++i)
+			cost += job[i].cost;
+
+		// split nodes, deepest (highest index) first
+		for (i = 1; i < numTop; ++i)
+			for (j = i; j > 0 && top[j] > top[j - 1]; --j)
+				largest = top[j], top[j] = top[j - 1], top[j - 1] = largest;
+		for (i = 0; i < numTop; ++i)
+			cost += a3demoBVHInternalRefitNode(bvh, bounds, top[i]);
+
+		bvh->cost = a3demoBVHInternalNormalizeCost(bvh, cost);
+		++bvh->refitCount;
+		return bvh->nodeCount;
+	}
+	return -1;
+}
+
+a3i32 a3demo_updateBVH(a3_DemoBVH *bvh, a3_DemoCullingBounds const *bounds, const a3ui32 numThreads)
+{
+	if (bvh && bvh->node && bounds && bounds->radius && numThreads)
+	{
+		if (bounds->count == bvh->objectCount && bvh->nodeCount &&
+			a3demo_refitBVH(bvh, bounds, numThreads) >= 0 &&
+			bvh->cost <= bvh->cost_build * bvh->rebuildRatio &&
+			(!bvh->refitMax || bvh->refitCount < bvh->refitMax))
+			return 0;
+		return (a3demo_buildBVH(bvh, bounds) >= 0);
+	}
+	return -1;
+}
+
+a3i32 a3demo_queryBVHFrustum(a3ui32 *visible_out, a3_DemoBVH const *bvh, a3_DemoCullingBounds const *bounds, a3_DemoCullingFrustum const *frustum)
+{
+	if (visible_out && bvh && bvh->node && bounds && bounds->radius && bounds->count == bvh->objectCount && frustum)
+	{
+		a3_DemoBVHNode const *node;
+		a3ui32 i = 0, k, numVisible = 0;
+		a3i32 result;
+
+		// walk nodes in order, skipping subtrees that are decided
+		while (i < bvh->nodeCount)
+		{
+			node = bvh->node + i;
+			result = a3demoBVHInternalNodeFrustum(node, frustum);
+			if (result > 0)
+			{
+				memcpy(visible_out + numVisible, bvh->object + node->first, sizeof(a3ui32) * node->count);
+				numVisible += node->count;
+				i = node->skip;
+			}
+			else if (result < 0)
+				i = node->skip;
+			else if (!node->right)
+			{
+				for (k = node->first; k < node->first + node->count; ++k)
+					if (!a3demoBVHInternalBoxOutside(bounds, frustum, bvh->object[k]))
+						visible_out[numVisible++] = bvh->object[k];
+				i = node->skip;
+			}
+			else
+				++i;
+		}
+		return numVisible;
+	}
+	return -1;
+}
+
+a3i32 a3demo_queryBVHOverlap(a3ui32 *overlap_out, const a3ui32 overlapMax, a3_DemoBVH const *bvh, a3_DemoCullingBounds const *bounds, const a3real3p boxMin, const a3real3p boxMax)
+{
+	if (overlap_out && bvh && bvh->node && bounds && bounds->radius && bounds->count == bvh->objectCount && boxMin && boxMax)
+	{
+		a3_DemoBVHNode const *node;
+		a3real objectMin[3], objectMax[3];
+		a3ui32 i = 0, k, numOverlap = 0;
+
+		while (i < bvh->nodeCount && numOverlap < overlapMax)
+		{
+			node = bvh->node + i;
+			if (!a3demoBVHInternalOverlap(node->boxMin, node->boxMax, boxMin, boxMax))
+				i = node->skip;
+			else if (a3demoBVHInternalContains(boxMin, boxMax, node->boxMin, node->boxMax))
+			{
+				k = overlapMax - numOverlap < node->count ? overlapMax - numOverlap : node->count;
+				memcpy(overlap_out + numOverlap, bvh->object + node->first, sizeof(a3ui32) * k);
+				numOverlap += k;
+				i = node->skip;
+			}
+			else if (!node->right)
+			{
+				for (k = node->first; k < node->first + node->count && numOverlap < overlapMax; ++k)
+				{
+					a3demoBVHInternalSetObject(objectMin, objectMax, bounds, bvh->object[k]);
+					if (a3demoBVHInternalOverlap(objectMin, objectMax, boxMin, boxMax))
+						overlap_out[numOverlap++] = bvh->object[k];
+				}
+				i = node->skip;
+			}
+			else
+				++i;
+		}
+		return numOverlap;
+	}
+	return -1;
+}
+
+a3i32 a3demo_queryBVHRay(a3ui32 *hitIndex_out, a3real *hitDistance_out_opt, a3_DemoBVH const *bvh, a3_DemoCullingBounds const *bounds, const a3real3p origin, const a3real3p direction)
+{
+	if (hitIndex_out && bvh && bvh->node && bounds && bounds->radius && bounds->count == bvh->objectCount && origin && direction)
+	{
+		a3_DemoBVHNode const *node;
+		a3real directionInv[3], objectMin[3], objectMax[3], nearest = a3real_zero, t;
+		a3ui32 i = 0, k, r;
+		a3boolean hit = a3false;
+
+		// a zero component gives an infinite slab, as intended
+		for (r = 0; r < 3; ++r)
+			directionInv[r] = a3recip(direction[r]);
+
+		// boxes entered past the nearest hit so far are skipped; before
+		//	the first hit any distance is accepted
+		while (i < bvh->nodeCount)
+		{
+			node = bvh->node + i;
+			if (!a3demoBVHInternalRay(&t, node->boxMin, node->boxMax, origin, directionInv, hit, nearest))
+				i = node->skip;
+			else if (!node->right)
+			{
+				for (k = node->first; k < node->first + node->count; ++k)
+				{
+					a3demoBVHInternalSetObject(objectMin, objectMax, bounds, bvh->object[k]);
+					if (a3demoBVHInternalRay(&t, objectMin, objectMax, origin, directionInv, hit, nearest))
+					{
+						*hitIndex_out = bvh->object[k];
+						nearest = t;
+						hit = a3true;
+					}
+				}
+				i = node->skip;
+			}
+			else
+				++i;
+		}
+		if (hit && hitDistance_out_opt)
+			*hitDistance_out_opt = nearest;
+		return hit;
+	}
+	return -1;
+}
+
+a3i32 a3demo_getPickRay(a3real3p origin_out, a3real3p direction_out, a3_MouseInput const *mouse, const a3i32 frameBorder, const a3real frameWidthInv, const a3real frameHeightInv, const a3real4x4p projectionMatInv, const a3real4x4p cameraMat)
+{
+	if (origin_out && direction_out && mouse && projectionMatInv && cameraMat)
+	{
+		// window coordinates to NDC on the near and far planes
+		const a3i32 x = a3mouseGetX(mouse) + frameBorder;
+		const a3i32 y = a3mouseGetY(mouse) + frameBorder;
+		a3vec4 coord[2];
+		a3ui32 i;
+		for (i = 0; i < 2; ++i)
+		{
+			coord[i].x = +((a3real)x * frameWidthInv * a3real_two - a3real_one);
+			coord[i].y = -((a3real)y * frameHeightInv * a3real_two - a3real_one);
+			coord[i].z = i ? +a3real_one : -a3real_one;
+			coord[i].w = a3real_one;
+
+			// to view space, then world space
+			a3real4Real4x4Mul(projectionMatInv, coord[i].v);
+			a3real4DivS(coord[i].v, coord[i].w);
+			a3real4Real4x4Mul(cameraMat, coord[i].v);
+		}
+		a3real3SetReal3(origin_out, coord[0].v);
+		a3real3Diff(direction_out, coord[1].v, coord[0].v);
+		a3real3Normalize(direction_out);
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,298 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoCulling.c
+	Batch view frustum culling implementation.
+*/
+
+#include "../a3_DemoCulling.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+// vector operations for the selected instruction set
+
+#if (defined A3_DEMOCULLING_AVX)
+typedef __m256 a3demoCullingInternalVec;
+#define a3demoCullingInternalWidth			8
+#define a3demoCullingInternalSet1(x)		_mm256_set1_ps(x)
+#define a3demoCullingInternalLoad(p)		_mm256_loadu_ps(p)
+#define a3demoCullingInternalAdd(a, b)		_mm256_add_ps(a, b)
+#define a3demoCullingInternalMul(a, b)		_mm256_mul_ps(a, b)
+#define a3demoCullingInternalOr(a, b)		_mm256_or_ps(a, b)
+#define a3demoCullingInternalLess(a, b)		_mm256_cmp_ps(a, b, _CMP_LT_OQ)
+#define a3demoCullingInternalMask(a)		_mm256_movemask_ps(a)
+#elif (defined A3_DEMOCULLING_SSE)
+typedef __m128 a3demoCullingInternalVec;
+#define a3demoCullingInternalWidth			4
+#define a3demoCullingInternalSet1(x)		_mm_set1_ps(x)
+#define a3demoCullingInternalLoad(p)		_mm_loadu_ps(p)
+#define a3demoCullingInternalAdd(a, b)		_mm_add_ps(a, b)
+#define a3demoCullingInternalMul(a, b)		_mm_mul_ps(a, b)
+#define a3demoCullingInternalOr(a, b)		_mm_or_ps(a, b)
+#define a3demoCullingInternalLess(a, b)		_mm_cmplt_ps(a, b)
+#define a3demoCullingInternalMask(a)		_mm_movemask_ps(a)
+#else	// scalar
+#define a3demoCullingInternalWidth			0
+#endif	// AVX, SSE2
+
+// number of objects handled by the vector loop
+#if (a3demoCullingInternalWidth)
+#define a3demoCullingInternalMad(a, b, c)		a3demoCullingInternalAdd(a3demoCullingInternalMul(a, b), c)
+#define a3demoCullingInternalVectorCount(count)	((count) / a3demoCullingInternalWidth * a3demoCullingInternalWidth)
+#define a3demoCullingInternalAllMask			((1 << a3demoCullingInternalWidth) - 1)
+#else	// !a3demoCullingInternalWidth
+#define a3demoCullingInternalVectorCount(count)	0
+#endif	// a3demoCullingInternalWidth
+
+
+//-----------------------------------------------------------------------------
+
+// signed distance from plane to point
+inline a3real a3demoCullingInternalDistance(const a3real4p plane, const a3real x, const a3real y, const a3real z)
+{
+	return (plane[0] * x + plane[1] * y + plane[2] * z + plane[3]);
+}
+
+// append indices of the lanes whose mask bit is clear; branch-free, the
+//	slot after the last visible index may be written but never past i + lane
+inline a3ui32 a3demoCullingInternalCompact(a3ui32 *visible_out, a3ui32 numVisible, const a3ui32 i, const a3ui32 width, const a3i32 outsideMask)
+{
+	a3ui32 lane;
+	for (lane = 0; lane < width; ++lane)
+	{
+		visible_out[numVisible] = i + lane;
+		numVisible += ((outsideMask >> lane) & 1) ^ 1;
+	}
+	return numVisible;
+}
+
+// scalar tests of one object
+inline a3boolean a3demoCullingInternalBoxOutside(a3_DemoCullingBounds const *bounds, a3_DemoCullingFrustum const *frustum, const a3ui32 i)
+{
+	const a3real x = bounds->center[0][i], y = bounds->center[1][i], z = bounds->center[2][i];
+	const a3real ex = bounds->extent[0][i], ey = bounds->extent[1][i], ez = bounds->extent[2][i];
+	a3ui32 p;
+	for (p = 0; p < 6; ++p)
+	{
+		const a3real *plane = frustum->plane[p].v;
+		const a3real reach = a3absolute(plane[0]) * ex + a3absolute(plane[1]) * ey + a3absolute(plane[2]) * ez;
+		if (a3demoCullingInternalDistance(plane, x, y, z) + reach < a3real_zero)
+			return a3true;
+	}
+	return a3false;
+}
+
+inline a3boolean a3demoCullingInternalSphereOutside(a3_DemoCullingBounds const *bounds, a3_DemoCullingFrustum const *frustum, const a3ui32 i)
+{
+	const a3real x = bounds->center[0][i], y = bounds->center[1][i], z = bounds->center[2][i];
+	const a3real r = bounds->radius[i];
+	a3ui32 p;
+	for (p = 0; p < 6; ++p)
+		if (a3demoCullingInternalDistance(frustum->plane[p].v, x, y, z) + r < a3real_zero)
+			return a3true;
+	return a3false;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3demo_createCullingBounds(a3_DemoCullingBounds *bounds_out, const a3ui32 count)
+{
+	if (bounds_out && !bounds_out->radius && count)
+	{
+		a3real *data = (a3real *)malloc(sizeof(a3real) * 7 * count);
+		if (data)
+		{
+			memset(data, 0, sizeof(a3real) * 7 * count);
+			bounds_out->center[0] = data + count * 0;
+			bounds_out->center[1] = data + count * 1;
+			bounds_out->center[2] = data + count * 2;
+			bounds_out->extent[0] = data + count * 3;
+			bounds_out->extent[1] = data + count * 4;
+			bounds_out->extent[2] = data + count * 5;
+			bounds_out->radius = data + count * 6;
+			bounds_out->count = count;
+			return count;
+		}
+	}
+	return -1;
+}
+
+a3i32 a3demo_releaseCullingBounds(a3_DemoCullingBounds *bounds)
+{
+	if (bounds && bounds->radius)
+	{
+		// all streams share the first allocation
+		free(bounds->center[0]);
+		memset(bounds, 0, sizeof(a3_DemoCullingBounds));
+		return 1;
+	}
+	return -1;
+}
+
+a3i32 a3demo_setCullingBoundsTransformed(a3_DemoCullingBounds const *bounds, const a3ui32 index, const a3real4x4p modelMat, const a3real3p center_local, const a3real3p extent_local)
+{
+	if (bounds && bounds->radius && index < bounds->count && modelMat && center_local && extent_local)
+	{
+		a3ui32 r;
+		a3real e, radiusSq = a3real_zero;
+
+		// center transforms as a point; each world half-size is the sum of
+		//	the local half-sizes projected onto that axis
+		for (r = 0; r < 3; ++r)
+		{
+			bounds->center[r][index] = modelMat[0][r] * center_local[0] + modelMat[1][r] * center_local[1] + modelMat[2][r] * center_local[2] + modelMat[3][r];
+			e = a3absolute(modelMat[0][r]) * extent_local[0] + a3absolute(modelMat[1][r]) * extent_local[1] + a3absolute(modelMat[2][r]) * extent_local[2];
+			bounds->extent[r][index] = e;
+			radiusSq += e * e;
+		}
+		bounds->radius[index] = a3sqrt(radiusSq);
+		return index;
+	}
+	return -1;
+}
+
+a3i32 a3demo_extractCullingFrustum(a3_DemoCullingFrustum *frustum_out, const a3real4x4p viewProjectionMat)
+{
+	if (frustum_out && viewProjectionMat)
+	{
+		// rows of the matrix (stored by column); clip-space planes are
+		//	w +/- x, w +/- y and w +/- z
+		a3ui32 p, c;
+		a3real len;
+		for (p = 0; p < 6; ++p)
+		{
+			const a3ui32 row = p / 2;
+			const a3real sign = (p & 1) ? -a3real_one : +a3real_one;
+			for (c = 0; c < 4; ++c)
+				frustum_out->plane[p].v[c] = viewProjectionMat[c][3] + sign * viewProjectionMat[c][row];
+			len = a3real3Length(frustum_out->plane[p].v);
+			if (len > a3real_zero)
+				a3real4DivS(frustum_out->plane[p].v, len);
+		}
+		return 6;
+	}
+	return -1;
+}
+
+a3i32 a3demo_cullBoxes(a3ui32 *visible_out, a3_DemoCullingBounds const *bounds, a3_DemoCullingFrustum const *frustum)
+{
+	if (visible_out && bounds && bounds->radius && frustum)
+	{
+		const a3ui32 count = bounds->count, countVector = a3demoCullingInternalVectorCount(count);
+		a3ui32 i = 0, p, numVisible = 0;
+
+#if (a3demoCullingInternalWidth)
+		const a3demoCullingInternalVec zero = a3demoCullingInternalSet1(a3real_zero);
+		a3demoCullingInternalVec nx[6], ny[6], nz[6], nw[6], ax[6], ay[6], az[6];
+		a3demoCullingInternalVec cx, cy, cz, ex, ey, ez, d, outside;
+		a3i32 mask;
+		for (p = 0; p < 6; ++p)
+		{
+			const a3real *plane = frustum->plane[p].v;
+			nx[p] = a3demoCullingInternalSet1(plane[0]);
+			ny[p] = a3demoCullingInternalSet1(plane[1]);
+			nz[p] = a3demoCullingInternalSet1(plane[2]);
+			nw[p] = a3demoCullingInternalSet1(plane[3]);
+			ax[p] = a3demoCullingInternalSet1(a3absolute(plane[0]));
+			ay[p] = a3demoCullingInternalSet1(a3absolute(plane[1]));
+			az[p] = a3demoCullingInternalSet1(a3absolute(plane[2]));
+		}
+		for (; i < countVector; i += a3demoCullingInternalWidth)
+		{
+			cx = a3demoCullingInternalLoad(bounds->center[0] + i);
+			cy = a3demoCullingInternalLoad(bounds->center[1] + i);
+			cz = a3demoCullingInternalLoad(bounds->center[2] + i);
+			ex = a3demoCullingInternalLoad(bounds->extent[0] + i);
+			ey = a3demoCullingInternalLoad(bounds->extent[1] + i);
+			ez = a3demoCullingInternalLoad(bounds->extent[2] + i);
+			outside = a3demoCullingInternalSet1(a3real_zero);
+			for (p = 0; p < 6; ++p)
+			{
+				// center distance plus how far the box reaches toward the plane
+				d = a3demoCullingInternalMad(nx[p], cx, a3demoCullingInternalMad(ny[p], cy, a3demoCullingInternalMad(nz[p], cz, nw[p])));
+				d = a3demoCullingInternalMad(ax[p], ex, a3demoCullingInternalMad(ay[p], ey, a3demoCullingInternalMad(az[p], ez, d)));
+				outside = a3demoCullingInternalOr(outside, a3demoCullingInternalLess(d, zero));
+			}
+			mask = a3demoCullingInternalMask(outside);
+			if (mask != a3demoCullingInternalAllMask)
+				numVisible = a3demoCullingInternalCompact(visible_out, numVisible, i, a3demoCullingInternalWidth, mask);
+		}
+#endif	// a3demoCullingInternalWidth
+
+		for (; i < count; ++i)
+			if (!a3demoCullingInternalBoxOutside(bounds, frustum, i))
+				visible_out[numVisible++] = i;
+		return numVisible;
+	}
+	return -1;
+}
+
+a3i32 a3demo_cullSpheres(a3ui32 *visible_out, a3_DemoCullingBounds const *bounds, a3_DemoCullingFrustum const *frustum)
+{
+	if (visible_out && bounds && bounds->radius && frustum)
+	{
+		const a3ui32 count = bounds->count, countVector = a3demoCullingInternalVectorCount(count);
+		a3ui32 i = 0, p, numVisible = 0;
+
+#if (a3demoCullingInternalWidth)
+		const a3demoCullingInternalVec zero = a3demoCullingInternalSet1(a3real_zero);
+		a3demoCullingInternalVec nx[6], ny[6], nz[6], nw[6];
+		a3demoCullingInternalVec cx, cy, cz, r, d, outside;
+		a3i32 mask;
+		for (p = 0; p < 6; ++p)
+		{
+			const a3real *plane = frustum->plane[p].v;
+			nx[p] = a3demoCullingInternalSet1(plane[0]);
+			ny[p] = a3demoCullingInternalSet1(plane[1]);
+			nz[p] = a3demoCullingInternalSet1(plane[2]);
+			nw[p] = a3demoCullingInternalSet1(plane[3]);
+		}
+		for (; i < countVector; i += a3demoCullingInternalWidth)
+		{
+			cx = a3demoCullingInternalLoad(bounds->center[0] + i);
+			cy = a3demoCullingInternalLoad(bounds->center[1] + i);
+			cz = a3demoCullingInternalLoad(bounds->center[2] + i);
+			r = a3demoCullingInternalLoad(bounds->radius + i);
+			outside = a3demoCullingInternalSet1(a3real_zero);
+			for (p = 0; p < 6; ++p)
+			{
+				d = a3demoCullingInternalMad(nx[p], cx, a3demoCullingInternalMad(ny[p], cy, a3demoCullingInternalMad(nz[p], cz, a3demoCullingInternalAdd(nw[p], r))));
+				outside = a3demoCullingInternalOr(outside, a3demoCullingInternalLess(d, zero));
+			}
+			mask = a3demoCullingInternalMask(outside);
+			if (mask != a3demoCullingInternalAllMask)
+				numVisible = a3demoCullingInternalCompact(visible_out, numVisible, i, a3demoCullingInternalWidth, mask);
+		}
+#endif	// a3demoCullingInternalWidth
+
+		for (; i < count; ++i)
+			if (!a3demoCullingInternalSphereOutside(bounds, frustum, i))
+				visible_out[numVisible++] = i;
+		return numVisible;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,433 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMeshOptimizer.c
+	Mesh optimizer implementation.
+*/
+
+#include "../a3_DemoMeshOptimizer.h"
+
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+#define a3demoMeshOptimizerInternalNone		0xffffffff
+
+
+// run of triangles kept together by the overdraw pass
+typedef struct a3_DemoMeshOptimizerCluster
+{
+	a3f32 key;
+	a3ui32 first, count;
+} a3_DemoMeshOptimizerCluster;
+
+
+//-----------------------------------------------------------------------------
+
+inline a3ui32 a3demoMeshOptimizerInternalGetIndex(const void *indexData, const a3ui32 indexSize, const a3ui32 i)
+{
+	switch (indexSize)
+	{
+	case 1: return ((const a3ui8 *)indexData)[i];
+	case 2: return ((const a3ui16 *)indexData)[i];
+	}
+	return ((const a3ui32 *)indexData)[i];
+}
+
+inline void a3demoMeshOptimizerInternalSetIndices(void *indexData, const a3ui32 indexSize, const a3ui32 *index, const a3ui32 numIndices)
+{
+	a3ui32 i;
+	switch (indexSize)
+	{
+	case 1:
+		for (i = 0; i < numIndices; ++i)
+			((a3ui8 *)indexData)[i] = (a3ui8)index[i];
+		break;
+	case 2:
+		for (i = 0; i < numIndices; ++i)
+			((a3ui16 *)indexData)[i] = (a3ui16)index[i];
+		break;
+	default:
+		memcpy(indexData, index, sizeof(a3ui32) * numIndices);
+		break;
+	}
+}
+
+// FIFO cache simulation: misses per triangle, optionally stored
+inline a3ui32 a3demoMeshOptimizerInternalSimulate(a3ui32 *miss_out_opt, a3ui32 *stamp, const a3ui32 *index, const a3ui32 numTriangles, const a3ui32 numVertices, const a3ui32 cacheSize)
+{
+	a3ui32 t, k, misses, total = 0, time = cacheSize + 1;
+	memset(stamp, 0, sizeof(a3ui32) * numVertices);
+	for (t = 0; t < numTriangles; ++t, index += 3)
+	{
+		for (k = misses = 0; k < 3; ++k)
+			if (time - stamp[index[k]] > cacheSize)
+			{
+				stamp[index[k]] = time++;
+				++misses;
+			}
+		if (miss_out_opt)
+			miss_out_opt[t] = misses;
+		total += misses;
+	}
+	return total;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// Forsyth score of a vertex from its cache position (-1 if not cached) and
+//	number of triangles still to be emitted that use it
+inline a3f32 a3demoMeshOptimizerInternalVertexScore(const a3i32 cachePos, const a3ui32 live)
+{
+	a3f32 score = 0.0f;
+	if (live == 0)
+		return -1.0f;
+	if (cachePos >= 3)
+		score = powf(1.0f - (a3f32)(cachePos - 3) / (a3f32)(a3demo_meshOptimizerCacheSize - 3), 1.5f);
+	else if (cachePos >= 0)
+		score = 0.75f;
+	return (score + 2.0f / sqrtf((a3f32)live));
+}
+
+// vertex cache pass: index_out receives the reordered triangles
+inline a3boolean a3demoMeshOptimizerInternalVertexCache(a3ui32 *index_out, const a3ui32 *index, const a3ui32 numTriangles, const a3ui32 numVertices)
+{
+	const a3ui32 cacheMax = a3demo_meshOptimizerCacheSize + 3;
+	a3ui32 cache[2][a3demo_meshOptimizerCacheSize + 3], cacheCount = 0, newCount;
+	a3ui32 *live, *adjFirst, *adjTri, *buffer;
+	a3i32 *cachePos;
+	a3f32 *vertexScore, *triangleScore, bestScore;
+	a3ui8 *emitted;
+	a3ui32 t, v, k, j, i, best = 0, cursor = 0, n;
+
+	buffer = (a3ui32 *)malloc(sizeof(a3ui32) * (numVertices * 3 + 1 + numTriangles * 3) + sizeof(a3f32) * (numVertices + numTriangles) + numTriangles);
+	if (!buffer)
+		return a3false;
+	live = buffer;
+	adjFirst = live + numVertices;
+	adjTri = adjFirst + numVertices + 1;
+	cachePos = (a3i32 *)(adjTri + numTriangles * 3);
+	vertexScore = (a3f32 *)(cachePos + numVertices);
+	triangleScore = vertexScore + numVertices;
+	emitted = (a3ui8 *)(triangleScore + numTriangles);
+
+	// triangles using each vertex
+	memset(live, 0, sizeof(a3ui32) * numVertices);
+	for (i = 0; i < numTriangles * 3; ++i)
+		++live[index[i]];
+	for (v = 0, adjFirst[0] = 0; v < numVertices; ++v)
+		adjFirst[v + 1] = adjFirst[v] + live[v];
+	memset(live, 0, sizeof(a3ui32) * numVertices);
+	for (i = 0; i < numTriangles * 3; ++i)
+		adjTri[adjFirst[index[i]] + live[index[i]]++] = i / 3;
+	for (v = 0; v < numVertices; ++v)
+	{
+		cachePos[v] = -1;
+		vertexScore[v] = a3demoMeshOptimizerInternalVertexScore(-1, live[v]);
+	}
+	for (t = 0; t < numTriangles; ++t)
+		triangleScore[t] = vertexScore[index[t * 3]] + vertexScore[index[t * 3 + 1]] + vertexScore[index[t * 3 + 2]];
+	memset(emitted, 0, numTriangles);
+
+	for (n = 0; n < numTriangles; ++n)
+	{
+		// nothing in cache touches a triangle left: take the next in order
+		if (best == a3demoMeshOptimizerInternalNone || emitted[best])
+		{
+			while (emitted[cursor])
+				++cursor;
+			best = cursor;
+		}
+		t = best;
+		emitted[t] = 1;
+		memcpy(index_out + n * 3, index + t * 3, sizeof(a3ui32) * 3);
+
+		// drop the triangle from its vertices' lists, and put its vertices
+		//	at the front of the cache
+		for (k = newCount = 0; k < 3; ++k)
+		{
+			v = index[t * 3 + k];
+			for (j = adjFirst[v]; adjTri[j] != t; ++j);
+			adjTri[j] = adjTri[adjFirst[v] + --live[v]];
+			for (j = 0; j < newCount && cache[1][j] != v; ++j);
+			if (j == newCount)
+				cache[1][newCount++] = v;
+		}
+		for (j = 0, k = newCount; j < cacheCount && newCount < cacheMax; ++j)
+		{
+			v = cache[0][j];
+			if (v != cache[1][0] && (k < 2 || v != cache[1][1]) && (k < 3 || v != cache[1][2]))
+				cache[1][newCount++] = v;
+		}
+
+		// rescore what changed and pick the best triangle they touch; the
+		//	entries past the cache size have just been pushed out
+		bestScore = -1.0f;
+		best = a3demoMeshOptimizerInternalNone;
+		for (j = 0; j < newCount; ++j)
+		{
+			v = cache[1][j];
+			cachePos[v] = j < a3demo_meshOptimizerCacheSize ? (a3i32)j : -1;
+			vertexScore[v] = a3demoMeshOptimizerInternalVertexScore(cachePos[v], live[v]);
+		}
+		for (j = 0; j < newCount; ++j)
+		{
+			v = cache[1][j];
+			for (i = adjFirst[v]; i < adjFirst[v] + live[v]; ++i)
+			{
+				t = adjTri[i];
+				triangleScore[t] = vertexScore[index[t * 3]] + vertexScore[index[t * 3 + 1]] + vertexScore[index[t * 3 + 2]];
+				if (triangleScore[t] > bestScore)
+				{
+					bestScore = triangleScore[t];
+					best = t;
+				}
+			}
+		}
+		cacheCount = newCount < a3demo_meshOptimizerCacheSize ? newCount : a3demo_meshOptimizerCacheSize;
+		memcpy(cache[0], cache[1], sizeof(a3ui32) * cacheCount);
+	}
+
+	free(buffer);
+	return a3true;
+}
+
+
+//-----------------------------------------------------------------------------
+
+int a3demoMeshOptimizerInternalCompareCluster(const void *a, const void *b)
+{
+	const a3_DemoMeshOptimizerCluster *ca = (const a3_DemoMeshOptimizerCluster *)a, *cb = (const a3_DemoMeshOptimizerCluster *)b;
+	if (ca->key != cb->key)
+		return (ca->key > cb->key ? -1 : +1);
+	return (ca->first < cb->first ? -1 : ca->first > cb->first);
+}
+
+// overdraw pass: cluster the cache-ordered triangles and sort clusters so
+//	that those facing away from the center, likely in front, draw first
+inline a3boolean a3demoMeshOptimizerInternalOverdraw(a3ui32 *index_out, const a3ui32 *index, const a3f32 *position, const a3ui32 numTriangles, const a3ui32 numVertices, const a3f32 threshold)
+{
+	a3_DemoMeshOptimizerCluster *cluster;
+	a3ui32 *miss, *stamp, numClusters = 0;
+	a3f32 center[3] = { 0.0f }, c[3], nrm[3], e1[3], e2[3], x[3], area, len;
+	a3ui32 t, i, k, r, end, misses, runMisses, runCount, time;
+
+	miss = (a3ui32 *)malloc(sizeof(a3ui32) * (numTriangles + numVertices) + sizeof(a3_DemoMeshOptimizerCluster) * numTriangles);
+	if (!miss)
+		return a3false;
+	stamp = miss + numTriangles;
+	cluster = (a3_DemoMeshOptimizerCluster *)(stamp + numVertices);
+	a3demoMeshOptimizerInternalSimulate(miss, stamp, index, numTriangles, numVertices, a3demo_meshOptimizerCacheSize);
+
+	// hard boundaries where the cache ordering restarted (all misses),
+	//	then soft ones inside once a run started on a cold cache is already
+	//	as cheap as the threshold allows
+	memset(stamp, 0, sizeof(a3ui32) * numVertices);
+	for (t = 0, time = 0; t < numTriangles; t = end)
+	{
+		for (end = t + 1, misses = miss[t]; end < numTriangles && miss[end] < 3; ++end)
+			misses += miss[end];
+		for (i = t, runMisses = runCount = 0; i < end; ++i)
+		{
+			if (!runCount)
+				time += a3demo_meshOptimizerCacheSize + 1;
+			for (k = 0; k < 3; ++k)
+				if (time - stamp[index[i * 3 + k]] > a3demo_meshOptimizerCacheSize)
+				{
+					stamp[index[i * 3 + k]] = time++;
+					++runMisses;
+				}
+			++runCount;
+			if (i + 1 == end || (a3f32)runMisses * (a3f32)(end - t) <= threshold * (a3f32)misses * (a3f32)runCount)
+			{
+				cluster[numClusters].first = i + 1 - runCount;
+				cluster[numClusters++].count = runCount;
+				runMisses = runCount = 0;
+			}
+		}
+	}
+
+	// key: area-weighted cluster center offset from the mesh center along
+	//	the cluster's average normal
+	for (i = 0; i < numVertices; ++i)
+		for (r = 0; r < 3; ++r)
+			center[r] += position[i * 3 + r];
+	for (r = 0; r < 3; ++r)
+		center[r] /= (a3f32)(numVertices ? numVertices : 1);
+	for (k = 0; k < numClusters; ++k)
+	{
+		c[0] = c[1] = c[2] = nrm[0] = nrm[1] = nrm[2] = area = 0.0f;
+		for (t = cluster[k].first; t < cluster[k].first + cluster[k].count; ++t)
+		{
+			const a3f32 *p0 = position + index[t * 3] * 3, *p1 = position + index[t * 3 + 1] * 3, *p2 = position + index[t * 3 + 2] * 3;
+			for (r = 0; r < 3; ++r)
+			{
+				e1[r] = p1[r] - p0[r];
+				e2[r] = p2[r] - p0[r];
+			}
+			x[0] = e1[1] * e2[2] - e1[2] * e2[1];
+			x[1] = e1[2] * e2[0] - e1[0] * e2[2];
+			x[2] = e1[0] * e2[1] - e1[1] * e2[0];
+			len = sqrtf(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+			area += len;
+			for (r = 0; r < 3; ++r)
+			{
+				c[r] += (p0[r] + p1[r] + p2[r]) * len;
+				nrm[r] += x[r];
+			}
+		}
+		len = sqrtf(nrm[0] * nrm[0] + nrm[1] * nrm[1] + nrm[2] * nrm[2]);
+		cluster[k].key = 0.0f;
+		if (area > 0.0f && len > 0.0f)
+			for (r = 0; r < 3; ++r)
+				cluster[k].key += (c[r] / (area * 3.0f) - center[r]) * nrm[r] / len;
+	}
+	qsort(cluster, numClusters, sizeof(a3_DemoMeshOptimizerCluster), a3demoMeshOptimizerInternalCompareCluster);
+	for (k = 0, i = 0; k < numClusters; ++k, i += cluster[k - 1].count * 3)
+		memcpy(index_out + i, index + cluster[k].first * 3, sizeof(a3ui32) * 3 * cluster[k].count);
+
+	free(miss);
+	return a3true;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// vertex fetch pass: renumber vertices in order of first use, unused last
+inline void a3demoMeshOptimizerInternalVertexFetch(a3ui32 *remap_out, a3ui32 *index, const a3ui32 numIndices, const a3ui32 numVertices)
+{
+	a3ui32 i, next = 0;
+	memset(remap_out, 0xff, sizeof(a3ui32) * numVertices);
+	for (i = 0; i < numIndices; ++i)
+	{
+		if (remap_out[index[i]] == a3demoMeshOptimizerInternalNone)
+			remap_out[index[i]] = next++;
+		index[i] = remap_out[index[i]];
+	}
+	for (i = 0; i < numVertices; ++i)
+		if (remap_out[i] == a3demoMeshOptimizerInternalNone)
+			remap_out[i] = next++;
+}
+
+// move one attribute block of a geometry to the new vertex order
+inline void a3demoMeshOptimizerInternalRemapBlock(void *block, a3byte *tmp, const a3ui32 *remap, const a3ui32 numVertices, const a3ui32 stride)
+{
+	a3ui32 i;
+	if (block)
+	{
+		for (i = 0; i < numVertices; ++i)
+			memcpy(tmp + remap[i] * stride, (a3byte *)block + i * stride, stride);
+		memcpy(block, tmp, (size_t)numVertices * stride);
+	}
+}
+
+inline void a3demoMeshOptimizerInternalRemap(a3_GeometryData *geom, a3byte *tmp, const a3ui32 *remap)
+{
+	const void *bitangent = 0, *blendingInd = 0;
+	a3geometryGetAddressBitangent(&bitangent, geom);
+	a3geometryGetAddressBlendingInd(&blendingInd, geom);
+	a3demoMeshOptimizerInternalRemapBlock((void *)geom->attribData[a3attrib_geomPosition], tmp, remap, geom->numVertices, sizeof(a3f32) * 3);
+	a3demoMeshOptimizerInternalRemapBlock((void *)geom->attribData[a3attrib_geomNormal], tmp, remap, geom->numVertices, sizeof(a3f32) * 3);
+	a3demoMeshOptimizerInternalRemapBlock((void *)geom->attribData[a3attrib_geomColor], tmp, remap, geom->numVertices, sizeof(a3f32) * 4);
+	a3demoMeshOptimizerInternalRemapBlock((void *)geom->attribData[a3attrib_geomTexcoord], tmp, remap, geom->numVertices, sizeof(a3f32) * 2);
+	a3demoMeshOptimizerInternalRemapBlock((void *)geom->attribData[a3attrib_geomTangent], tmp, remap, geom->numVertices, sizeof(a3f32) * 3);
+	a3demoMeshOptimizerInternalRemapBlock((void *)bitangent, tmp, remap, geom->numVertices, sizeof(a3f32) * 3);
+	a3demoMeshOptimizerInternalRemapBlock((void *)geom->attribData[a3attrib_geomBlending], tmp, remap, geom->numVertices, sizeof(a3f32) * 4);
+	a3demoMeshOptimizerInternalRemapBlock((void *)blendingInd, tmp, remap, geom->numVertices, sizeof(a3i32) * 4);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3demo_optimizeGeometry(a3_GeometryData *geom, const a3ui32 numShapes, const a3f32 overdrawThreshold)
+{
+	if (geom && geom->data && numShapes)
+	{
+		const a3ui32 numVertices = geom->numVertices, numIndices = geom->numIndices, numTriangles = numIndices / 3;
+		const a3ui32 indexSize = geom->indexFormat->indexSize;
+		a3ui32 *index, *reorder, *remap, i;
+		a3boolean done;
+
+		// all shapes must be the same indexed triangles
+		if (geom->primType != a3prim_triangles || !numTriangles || numIndices % 3 || !geom->indexData)
+			return 0;
+		for (i = 1; i < numShapes; ++i)
+			if (!geom[i].data || geom[i].primType != a3prim_triangles ||
+				geom[i].numVertices != numVertices || geom[i].numIndices != numIndices ||
+				geom[i].indexFormat->indexSize != indexSize ||
+				memcmp(geom[i].indexData, geom->indexData, (size_t)indexSize * numIndices))
+				return 0;
+
+		index = (a3ui32 *)malloc(sizeof(a3ui32) * (numIndices * 2 + numVertices * 4 + numVertices));
+		if (!index)
+			return 0;
+		reorder = index + numIndices;
+		remap = reorder + numIndices;
+		for (i = 0; i < numIndices; ++i)
+			index[i] = a3demoMeshOptimizerInternalGetIndex(geom->indexData, indexSize, i);
+
+		done = a3demoMeshOptimizerInternalVertexCache(reorder, index, numTriangles, numVertices);
+		if (done && overdrawThreshold >= 1.0f && geom->attribData[a3attrib_geomPosition])
+			done = a3demoMeshOptimizerInternalOverdraw(index, reorder, (const a3f32 *)geom->attribData[a3attrib_geomPosition], numTriangles, numVertices, overdrawThreshold);
+		else
+			memcpy(index, reorder, sizeof(a3ui32) * numIndices);
+
+		if (done)
+		{
+			// the remaining space is a scratch block for the largest stride
+			a3demoMeshOptimizerInternalVertexFetch(remap, index, numIndices, numVertices);
+			for (i = 0; i < numShapes; ++i)
+			{
+				a3demoMeshOptimizerInternalRemap(geom + i, (a3byte *)(remap + numVertices), remap);
+				a3demoMeshOptimizerInternalSetIndices((void *)geom[i].indexData, indexSize, index, numIndices);
+			}
+		}
+		free(index);
+		return (done ? numTriangles : 0);
+	}
+	return -1;
+}
+
+a3f32 a3demo_getGeometryACMR(a3_GeometryData const *geom, const a3ui32 cacheSize)
+{
+	if (geom && geom->data && cacheSize)
+	{
+		const a3ui32 numTriangles = geom->numIndices / 3, indexSize = geom->indexFormat->indexSize;
+		a3ui32 *index, i, misses;
+		if (geom->primType != a3prim_triangles || !numTriangles || !geom->indexData)
+			return 0.0f;
+		index = (a3ui32 *)malloc(sizeof(a3ui32) * (numTriangles * 3 + geom->numVertices));
+		if (!index)
+			return 0.0f;
+		for (i = 0; i < numTriangles * 3; ++i)
+			index[i] = a3demoMeshOptimizerInternalGetIndex(geom->indexData, indexSize, i);
+		misses = a3demoMeshOptimizerInternalSimulate(0, index + numTriangles * 3, index, numTriangles, geom->numVertices, cacheSize);
+		free(index);
+		return ((a3f32)misses / (a3f32)numTriangles);
+	}
+	return -1.0f;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,738 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoModelLoader.c
+	Parallel Wavefront OBJ loader implementation.
+*/
+
+#include "../a3_DemoModelLoader.h"
+#include "../a3_DemoTangentBasis.h"
+
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+#include "animal3D/a3utility/a3_Thread.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// memory-mapped files
+#ifdef _WIN32
+#include <Windows.h>
+#else	// !_WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif	// _WIN32
+
+
+// loader flag bits (see a3_ModelLoaderFlag)
+#define a3demoModelLoaderInternalFlagTexcoords		0x01
+#define a3demoModelLoaderInternalFlagLoadNormals	0x02
+#define a3demoModelLoaderInternalFlagCalcNormals	0x04
+#define a3demoModelLoaderInternalFlagTangents		0x08
+#define a3demoModelLoaderInternalFlagVertexNormals	0x10
+
+// missing corner index
+#define a3demoModelLoaderInternalNone			0xffffffff
+
+
+// mapped file
+typedef struct a3_DemoModelLoaderFile
+{
+	const a3byte *text;
+	a3ui32 size;
+#ifdef _WIN32
+	HANDLE file, mapping;
+#endif	// _WIN32
+} a3_DemoModelLoaderFile;
+
+// element streams shared by all chunks
+typedef struct a3_DemoModelLoaderStreams
+{
+	a3f32 *position, *texcoord, *normal;
+	a3ui32 *corner;					// triangles, three (v, vt, vn) each
+	const a3f32 *transform;
+	a3f32 normalTransform[9];		// inverse-transpose, up to scale
+} a3_DemoModelLoaderStreams;
+
+// range of the file for one worker thread; counted in the first pass,
+//	parsed into the streams at its offsets in the second
+typedef struct a3_DemoModelLoaderChunk
+{
+	a3_DemoModelLoaderStreams const *streams;
+	const a3byte *begin, *end;
+	a3ui32 count[4];				// positions, texcoords, normals, triangles
+	a3ui32 first[4];				// offset of each in the streams
+} a3_DemoModelLoaderChunk;
+
+
+//-----------------------------------------------------------------------------
+// file mapping
+
+inline a3boolean a3demoModelLoaderInternalMap(a3_DemoModelLoaderFile *file_out, const a3byte *filePath)
+{
+#ifdef _WIN32
+	LARGE_INTEGER size;
+	file_out->file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, 0);
+	if (file_out->file != INVALID_HANDLE_VALUE)
+	{
+		if (GetFileSizeEx(file_out->file, &size) && size.QuadPart > 0 && size.QuadPart < 0x7fffffff)
+		{
+			file_out->mapping = CreateFileMappingA(file_out->file, 0, PAGE_READONLY, 0, 0, 0);
+			if (file_out->mapping)
+			{
+				file_out->text = (const a3byte *)MapViewOfFile(file_out->mapping, FILE_MAP_READ, 0, 0, 0);
+				file_out->size = (a3ui32)size.QuadPart;
+				if (file_out->text)
+					return a3true;
+				CloseHandle(file_out->mapping);
+			}
+		}
+		CloseHandle(file_out->file);
+	}
+#else	// !_WIN32
+	struct stat info;
+	const int fd = open(filePath, O_RDONLY);
+	if (fd >= 0)
+	{
+		if (fstat(fd, &info) == 0 && info.st_size > 0 && info.st_size < 0x7fffffff)
+		{
+			void *text = mmap(0, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (text != MAP_FAILED)
+			{
+				file_out->text = (const a3byte *)text;
+				file_out->size = (a3ui32)info.st_size;
+				close(fd);
+				return a3true;
+			}
+		}
+		close(fd);
+	}
+#endif	// _WIN32
+	return a3false;
+}
+
+inline void a3demoModelLoaderInternalUnmap(a3_DemoModelLoaderFile *file)
+{
+#ifdef _WIN32
+	UnmapViewOfFile(file->text);
+	CloseHandle(file->mapping);
+	CloseHandle(file->file);
+#else	// !_WIN32
+	munmap((void *)file->text, file->size);
+#endif	// _WIN32
+}
+
+
+//-----------------------------------------------------------------------------
+// text parsing; the mapped text is not terminated, so every read checks
+//	the end of the range
+
+inline a3boolean a3demoModelLoaderInternalIsSpace(const a3byte c)
+{
+	return (c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f');
+}
+
+inline const a3byte *a3demoModelLoaderInternalSkipSpace(const a3byte *c, const a3byte *end)
+{
+	while (c < end && a3demoModelLoaderInternalIsSpace(*c))
+		++c;
+	return c;
+}
+
+inline const a3byte *a3demoModelLoaderInternalSkipToken(const a3byte *c, const a3byte *end)
+{
+	while (c < end && *c != '\n' && !a3demoModelLoaderInternalIsSpace(*c))
+		++c;
+	return c;
+}
+
+inline const a3byte *a3demoModelLoaderInternalLineEnd(const a3byte *c, const a3byte *end)
+{
+	const a3byte *line = (const a3byte *)memchr(c, '\n', (size_t)(end - c));
+	return line ? line : end;
+}
+
+// decimal float: sign, digits, fraction and exponent; the first 19
+//	significant digits are kept exactly, then scaled once by a power of
+//	ten, which is well within float precision
+inline const a3byte *a3demoModelLoaderInternalParseFloat(const a3byte *c, const a3byte *end, a3f32 *value_out)
+{
+	static const a3f64 power[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+	};
+	a3ui64 mantissa = 0;
+	a3i32 exponent = 0, exponentSign = 1, digits = 0, e = 0;
+	a3f64 value;
+	a3boolean negative = a3false;
+
+	if (c < end && (*c == '-' || *c == '+'))
+		negative = (*c++ == '-');
+	for (; c < end && *c >= '0' && *c <= '9'; ++c)
+	{
+		if (digits < 19)
+			mantissa = mantissa * 10 + (a3ui64)(*c - '0'), digits += (mantissa != 0);
+		else
+			++exponent;
+	}
+	if (c < end && *c == '.')
+		for (++c; c < end && *c >= '0' && *c <= '9'; ++c)
+			if (digits < 19)
+			{
+				mantissa = mantissa * 10 + (a3ui64)(*c - '0'), digits += (mantissa != 0);
+				--exponent;
+			}
+	if (c < end && (*c == 'e' || *c == 'E'))
+	{
+		++c;
+		if (c < end && (*c == '-' || *c == '+'))
+			exponentSign = (*c++ == '-') ? -1 : 1;
+		for (; c < end && *c >= '0' && *c <= '9'; ++c)
+			e = e < 1000 ? e * 10 + (*c - '0') : e;
+		exponent += exponentSign * e;
+	}
+
+	value = (a3f64)mantissa;
+	while (exponent > 22)
+		value *= power[22], exponent -= 22;
+	while (exponent < -22)
+		value /= power[22], exponent += 22;
+	value = exponent >= 0 ? value * power[exponent] : value / power[-exponent];
+	*value_out = (a3f32)(negative ? -value : value);
+	return c;
+}
+
+inline const a3byte *a3demoModelLoaderInternalParseInt(const a3byte *c, const a3byte *end, a3i32 *value_out)
+{
+	a3i32 value = 0;
+	a3boolean negative = a3false;
+	if (c < end && (*c == '-' || *c == '+'))
+		negative = (*c++ == '-');
+	for (; c < end && *c >= '0' && *c <= '9'; ++c)
+		value = value * 10 + (*c - '0');
+	*value_out = negative ? -value : value;
+	return c;
+}
+
+// parse up to a number of floats from the rest of a line, zero if missing
+inline void a3demoModelLoaderInternalParseFloats(const a3byte *c, const a3byte *end, a3f32 *values_out, const a3ui32 count)
+{
+	a3ui32 i;
+	for (i = 0; i < count; ++i)
+	{
+		c = a3demoModelLoaderInternalSkipSpace(c, end);
+		values_out[i] = 0.0f;
+		if (c < end && *c != '\n')
+			c = a3demoModelLoaderInternalParseFloat(c, end, values_out + i);
+	}
+}
+
+// parse face corner "v", "v/vt", "v//vn" or "v/vt/vn"; one-based indices
+//	become zero-based and negative ones count back from the last element
+//	defined so far; missing indices are none
+inline const a3byte *a3demoModelLoaderInternalParseCorner(const a3byte *c, const a3byte *end, a3ui32 *corner_out, const a3ui32 *defined)
+{
+	a3ui32 k;
+	a3i32 value;
+	corner_out[0] = corner_out[1] = corner_out[2] = a3demoModelLoaderInternalNone;
+	for (k = 0; k < 3; ++k)
+	{
+		if (c < end && *c != '/')
+		{
+			c = a3demoModelLoaderInternalParseInt(c, end, &value);
+			if (value > 0)
+				corner_out[k] = (a3ui32)(value - 1);
+			else if (value < 0 && (a3ui32)(-value) <= defined[k])
+				corner_out[k] = defined[k] - (a3ui32)(-value);
+		}
+		if (c < end && *c == '/')
+			++c;
+		else
+			break;
+	}
+	return a3demoModelLoaderInternalSkipToken(c, end);
+}
+
+// element kind of a line: 0 position, 1 texcoord, 2 normal, 3 face, or
+//	-1 for anything else; returns the start of its data
+inline a3i32 a3demoModelLoaderInternalLineKind(const a3byte *c, const a3byte *end, const a3byte **data_out)
+{
+	if (c + 1 < end && a3demoModelLoaderInternalIsSpace(c[1]))
+	{
+		*data_out = c + 1;
+		return (*c == 'v') ? 0 : (*c == 'f') ? 3 : -1;
+	}
+	if (c + 2 < end && *c == 'v' && a3demoModelLoaderInternalIsSpace(c[2]))
+	{
+		*data_out = c + 2;
+		return (c[1] == 't') ? 1 : (c[1] == 'n') ? 2 : -1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// worker passes
+
+// first pass: count elements and triangles (polygons are fanned)
+a3ret a3demoModelLoaderInternalCountThread(void *args)
+{
+	a3_DemoModelLoaderChunk *chunk = (a3_DemoModelLoaderChunk *)args;
+	const a3byte *c = chunk->begin, *end = chunk->end, *lineEnd, *data;
+	a3ui32 corners;
+	a3i32 kind;
+	memset(chunk->count, 0, sizeof(chunk->count));
+	for (; c < end; c = lineEnd + 1)
+	{
+		c = a3demoModelLoaderInternalSkipSpace(c, end);
+		lineEnd = a3demoModelLoaderInternalLineEnd(c, end);
+		kind = a3demoModelLoaderInternalLineKind(c, lineEnd, &data);
+		if (kind == 3)
+		{
+			for (corners = 0, c = a3demoModelLoaderInternalSkipSpace(data, lineEnd); c < lineEnd; ++corners)
+				c = a3demoModelLoaderInternalSkipSpace(a3demoModelLoaderInternalSkipToken(c, lineEnd), lineEnd);
+			chunk->count[3] += corners >= 3 ? corners - 2 : 0;
+		}
+		else if (kind >= 0)
+			++chunk->count[kind];
+	}
+	return chunk->count[3];
+}
+
+// second pass: parse elements and triangles into the streams; positions
+//	and normals are transformed here
+a3ret a3demoModelLoaderInternalParseThread(void *args)
+{
+	a3_DemoModelLoaderChunk *chunk = (a3_DemoModelLoaderChunk *)args;
+	a3_DemoModelLoaderStreams const *streams = chunk->streams;
+	const a3f32 *m = streams->transform, *n = streams->normalTransform;
+	const a3byte *c = chunk->begin, *end = chunk->end, *lineEnd, *data;
+	a3f32 *position = streams->position + chunk->first[0] * 3;
+	a3f32 *texcoord = streams->texcoord + chunk->first[1] * 2;
+	a3f32 *normal = streams->normal + chunk->first[2] * 3;
+	a3ui32 *corner = streams->corner + chunk->first[3] * 9;
+	a3ui32 defined[3], fan[2][3], i;
+	a3f32 v[3];
+	a3i32 kind;
+	for (i = 0; i < 3; ++i)
+		defined[i] = chunk->first[i];
+	for (; c < end; c = lineEnd + 1)
+	{
+		c = a3demoModelLoaderInternalSkipSpace(c, end);
+		lineEnd = a3demoModelLoaderInternalLineEnd(c, end);
+		kind = a3demoModelLoaderInternalLineKind(c, lineEnd, &data);
+		switch (kind)
+		{
+		case 0:
+			a3demoModelLoaderInternalParseFloats(data, lineEnd, v, 3);
+			if (m)
+			{
+				position[0] = m[0] * v[0] + m[4] * v[1] + m[8] * v[2] + m[12];
+				position[1] = m[1] * v[0] + m[5] * v[1] + m[9] * v[2] + m[13];
+				position[2] = m[2] * v[0] + m[6] * v[1] + m[10] * v[2] + m[14];
+			}
+			else
+				memcpy(position, v, sizeof(v));
+			position += 3;
+			++defined[0];
+			break;
+		case 1:
+			a3demoModelLoaderInternalParseFloats(data, lineEnd, texcoord, 2);
+			texcoord += 2;
+			++defined[1];
+			break;
+		case 2:
+			a3demoModelLoaderInternalParseFloats(data, lineEnd, v, 3);
+			if (m)
+			{
+				normal[0] = n[0] * v[0] + n[3] * v[1] + n[6] * v[2];
+				normal[1] = n[1] * v[0] + n[4] * v[1] + n[7] * v[2];
+				normal[2] = n[2] * v[0] + n[5] * v[1] + n[8] * v[2];
+			}
+			else
+				memcpy(normal, v, sizeof(v));
+			normal += 3;
+			++defined[2];
+			break;
+		case 3:
+			// fan around the first corner
+			c = a3demoModelLoaderInternalSkipSpace(data, lineEnd);
+			for (i = 0; c < lineEnd; ++i)
+			{
+				if (i < 2)
+					c = a3demoModelLoaderInternalParseCorner(c, lineEnd, fan[i], defined);
+				else
+				{
+					memcpy(corner, fan[0], sizeof(fan[0]));
+					memcpy(corner + 3, fan[1], sizeof(fan[1]));
+					c = a3demoModelLoaderInternalParseCorner(c, lineEnd, corner + 6, defined);
+					memcpy(fan[1], corner + 6, sizeof(fan[1]));
+					corner += 9;
+				}
+				c = a3demoModelLoaderInternalSkipSpace(c, lineEnd);
+			}
+			break;
+		}
+	}
+	return chunk->count[3];
+}
+
+// run a pass over all chunks; if a thread fails to launch, its chunk runs
+//	here instead
+inline void a3demoModelLoaderInternalRun(a3_threadfunc func, a3_DemoModelLoaderChunk *chunk, const a3ui32 numChunks)
+{
+	a3_Thread thread[a3demo_modelLoaderThreadMax] = { 0 };
+	a3boolean launched[a3demo_modelLoaderThreadMax];
+	a3ui32 i;
+	for (i = 1; i < numChunks; ++i)
+		if ((launched[i] = (a3threadLaunch(thread + i, func, chunk + i, 0) > 0)) == 0)
+			func(chunk + i);
+	func(chunk);
+	for (i = 1; i < numChunks; ++i)
+		if (launched[i])
+			a3threadWait(thread + i);
+}
+
+
+//-----------------------------------------------------------------------------
+// vertex generation
+
+// hash of corner tuple
+inline a3ui32 a3demoModelLoaderInternalHash(const a3ui32 *corner)
+{
+	return ((corner[0] * 73856093u) ^ (corner[1] * 19349663u) ^ (corner[2] * 83492791u)) * 2654435761u;
+}
+
+// normalize or leave zero
+inline void a3demoModelLoaderInternalNormalize(a3f32 *v)
+{
+	const a3f32 lenSq = v[0] * v[0] + v[1] * v[1] + v[2] * v[2];
+	if (lenSq > 0.0f)
+	{
+		const a3f32 lenInv = 1.0f / (a3f32)a3sqrt((a3real)lenSq);
+		v[0] *= lenInv;
+		v[1] *= lenInv;
+		v[2] *= lenInv;
+	}
+}
+
+// accumulate area-weighted triangle normals into the slots given by key
+//	(position index for smooth normals, vertex index for flat)
+inline void a3demoModelLoaderInternalAccumulateNormals(a3f32 *normal_out, const a3ui32 *key, const a3f32 *position, const a3ui32 *index, const a3ui32 numTriangles)
+{
+	a3f32 e0[3], e1[3], n[3];
+	a3ui32 t, k, r;
+	for (t = 0; t < numTriangles; ++t, index += 3)
+	{
+		const a3f32 *p0 = position + index[0] * 3, *p1 = position + index[1] * 3, *p2 = position + index[2] * 3;
+		for (r = 0; r < 3; ++r)
+		{
+			e0[r] = p1[r] - p0[r];
+			e1[r] = p2[r] - p0[r];
+		}
+		n[0] = e0[1] * e1[2] - e0[2] * e1[1];
+		n[1] = e0[2] * e1[0] - e0[0] * e1[2];
+		n[2] = e0[0] * e1[1] - e0[1] * e1[0];
+		for (k = 0; k < 3; ++k)
+			for (r = 0; r < 3; ++r)
+				normal_out[key[index[k]] * 3 + r] += n[r];
+	}
+}
+
+//-----------------------------------------------------------------------------
+
+// shared by both loaders; blending is written when weights and indices 
+//	are given
+inline a3i32 a3demoModelLoaderInternalLoad(a3_GeometryData *geom_out, const a3byte *filePath, const a3_ModelLoaderFlag flags, const a3f32 *transform_opt, const a3ui32 numThreads, const a3real *blendWeights, const a3i32 *blendIndices, const a3ui32 numBlendPositions)
+{
+	if (geom_out && !geom_out->data && filePath && *filePath && numThreads)
+	{
+		a3_DemoModelLoaderFile file[1] = { 0 };
+		a3_DemoModelLoaderStreams streams[1] = { 0 };
+		a3_DemoModelLoaderChunk chunk[a3demo_modelLoaderThreadMax];
+		a3ui32 total[4] = { 0 }, n = numThreads < a3demo_modelLoaderThreadMax ? numThreads : a3demo_modelLoaderThreadMax;
+		a3ui32 i, k, numCorners, numVertices = 0, numAttribs = 0, hashMask;
+		a3ui32 *index = 0, *vertexCorner = 0, *hash = 0, *key = 0;
+		a3f32 *accum = 0;
+		a3byte *data = 0;
+		a3boolean texcoords, normals, calcNormals, tangents, blending, flat, valid = a3true;
+		a3ui32 numMissingNormals = 0;
+		a3i32 result;
+		a3_GeometryVertexAttributeName attribs[5];
+
+		if (!a3demoModelLoaderInternalMap(file, filePath))
+			return 0;
+
+		// split at line boundaries; don't bother with threads for tiny files
+		if (n > file->size / 65536)
+			n = file->size / 65536 + 1;
+		for (i = 0; i < n; ++i)
+		{
+			const a3byte *begin = i ? chunk[i - 1].end : file->text;
+			const a3byte *end = file->text + file->size;
+			if (i + 1 < n)
+			{
+				end = file->text + (a3ui32)((a3ui64)file->size * (i + 1) / n);
+				if (end > begin)
+				{
+					end = a3demoModelLoaderInternalLineEnd(end, file->text + file->size);
+					end += (end < file->text + file->size);
+				}
+				else
+					end = begin;
+			}
+			chunk[i].streams = streams;
+			chunk[i].begin = begin;
+			chunk[i].end = end;
+		}
+		a3demoModelLoaderInternalRun(a3demoModelLoaderInternalCountThread, chunk, n);
+		for (i = 0; i < n; ++i)
+			for (k = 0; k < 4; ++k)
+			{
+				chunk[i].first[k] = total[k];
+				total[k] += chunk[i].count[k];
+			}
+
+		// streams: positions, texcoords, normals and triangle corners
+		streams->position = (a3f32 *)malloc(sizeof(a3f32) * (total[0] * 3 + total[1] * 2 + total[2] * 3) + sizeof(a3ui32) * total[3] * 9);
+		if (!streams->position || !total[0] || !total[3])
+		{
+			free(streams->position);
+			a3demoModelLoaderInternalUnmap(file);
+			return 0;
+		}
+		streams->texcoord = streams->position + total[0] * 3;
+		streams->normal = streams->texcoord + total[1] * 2;
+		streams->corner = (a3ui32 *)(streams->normal + total[2] * 3);
+		if (transform_opt)
+		{
+			// cofactors of the upper 3x3 are its inverse-transpose times the
+			//	determinant; the sign keeps normals facing out
+			const a3f32 *m = transform_opt;
+			a3f32 *c = streams->normalTransform, det;
+			c[0] = m[5] * m[10] - m[6] * m[9];
+			c[1] = m[6] * m[8] - m[4] * m[10];
+			c[2] = m[4] * m[9] - m[5] * m[8];
+			c[3] = m[9] * m[2] - m[10] * m[1];
+			c[4] = m[10] * m[0] - m[8] * m[2];
+			c[5] = m[8] * m[1] - m[9] * m[0];
+			c[6] = m[1] * m[6] - m[2] * m[5];
+			c[7] = m[2] * m[4] - m[0] * m[6];
+			c[8] = m[0] * m[5] - m[1] * m[4];
+			det = m[0] * c[0] + m[1] * c[1] + m[2] * c[2];
+			if (det < 0.0f)
+				for (k = 0; k < 9; ++k)
+					c[k] = -c[k];
+			streams->transform = transform_opt;
+		}
+		a3demoModelLoaderInternalRun(a3demoModelLoaderInternalParseThread, chunk, n);
+		a3demoModelLoaderInternalUnmap(file);
+
+		// what to output
+		texcoords = (flags & a3demoModelLoaderInternalFlagTexcoords) && total[1];
+		normals = (flags & (a3demoModelLoaderInternalFlagLoadNormals | a3demoModelLoaderInternalFlagCalcNormals)) != 0;
+		calcNormals = (flags & a3demoModelLoaderInternalFlagCalcNormals) || !(flags & a3demoModelLoaderInternalFlagLoadNormals) || !total[2];
+		tangents = (flags & a3demoModelLoaderInternalFlagTangents) && texcoords && normals;
+		blending = blendWeights && blendIndices;
+		flat = (flags & a3demoModelLoaderInternalFlagCalcNormals) && !(flags & a3demoModelLoaderInternalFlagVertexNormals);
+
+		// drop indices that won't be used, then validate
+		numCorners = total[3] * 3;
+		for (i = 0; i < numCorners; ++i)
+		{
+			a3ui32 *corner = streams->corner + i * 3;
+			if (!texcoords)
+				corner[1] = a3demoModelLoaderInternalNone;
+			if (calcNormals)
+				corner[2] = a3demoModelLoaderInternalNone;
+			if (corner[0] >= total[0] ||
+				(corner[1] != a3demoModelLoaderInternalNone && corner[1] >= total[1]) ||
+				(corner[2] != a3demoModelLoaderInternalNone && corner[2] >= total[2]))
+				valid = a3false;
+		}
+
+		// unique corners become vertices; flat shading keeps every corner
+		for (hashMask = 1; hashMask < numCorners * 2; hashMask <<= 1);
+		index = (a3ui32 *)malloc(sizeof(a3ui32) * (numCorners * 2 + hashMask));
+		if (valid && index)
+		{
+			vertexCorner = index + numCorners;
+			hash = vertexCorner + numCorners;
+			memset(hash, 0, sizeof(a3ui32) * hashMask);
+			--hashMask;
+			for (i = 0; i < numCorners; ++i)
+			{
+				const a3ui32 *corner = streams->corner + i * 3;
+				if (!flat)
+				{
+					for (k = a3demoModelLoaderInternalHash(corner) & hashMask; hash[k]; k = (k + 1) & hashMask)
+						if (!memcmp(streams->corner + vertexCorner[hash[k] - 1] * 3, corner, sizeof(a3ui32) * 3))
+							break;
+					if (hash[k])
+					{
+						index[i] = hash[k] - 1;
+						continue;
+					}
+					hash[k] = numVertices + 1;
+				}
+				vertexCorner[numVertices] = i;
+				index[i] = numVertices++;
+			}
+
+			// single allocation: attributes one after another, then indices
+			geom_out->numVertices = numVertices;
+			geom_out->numIndices = numCorners;
+			geom_out->primType = a3prim_triangles;
+			a3geometryCreateIndexFormat(geom_out->indexFormat, numVertices);
+			attribs[numAttribs++] = a3attrib_geomPosition;
+			if (normals)
+				attribs[numAttribs++] = a3attrib_geomNormal;
+			if (texcoords)
+				attribs[numAttribs++] = a3attrib_geomTexcoord;
+			if (tangents)
+				attribs[numAttribs++] = a3attrib_geomTangent;
+			if (blending)
+				attribs[numAttribs++] = a3attrib_geomBlending;
+			a3geometryCreateVertexFormat(geom_out->vertexFormat, attribs, numAttribs);
+			k = numVertices * (3 + normals * 3 + texcoords * 2 + tangents * 6 + blending * 8);
+			data = (a3byte *)malloc(sizeof(a3f32) * k + geom_out->indexFormat->indexSize * numCorners);
+			accum = (a3f32 *)malloc(sizeof(a3f32) * 3 * (total[0] > numVertices ? total[0] : numVertices) + sizeof(a3ui32) * numVertices);
+		}
+		if (data && accum)
+		{
+			a3f32 *position = (a3f32 *)data, *attrib = position + numVertices * 3;
+			a3f32 *normal = 0, *texcoord = 0, *tangent = 0, *blend = 0;
+			geom_out->data = data;
+			geom_out->attribData[a3attrib_geomPosition] = position;
+			if (normals)
+				geom_out->attribData[a3attrib_geomNormal] = normal = attrib, attrib += numVertices * 3;
+			if (texcoords)
+				geom_out->attribData[a3attrib_geomTexcoord] = texcoord = attrib, attrib += numVertices * 2;
+			if (tangents)
+				geom_out->attribData[a3attrib_geomTangent] = tangent = attrib, attrib += numVertices * 6;
+			if (blending)
+				geom_out->attribData[a3attrib_geomBlending] = blend = attrib, attrib += numVertices * 8;
+			geom_out->indexData = attrib;
+
+			// corners without a texcoord get zero; corners without a normal 
+			//	are counted and get one calculated below
+			for (i = 0; i < numVertices; ++i)
+			{
+				const a3ui32 *corner = streams->corner + vertexCorner[i] * 3;
+				memcpy(position + i * 3, streams->position + corner[0] * 3, sizeof(a3f32) * 3);
+				if (texcoord && corner[1] != a3demoModelLoaderInternalNone)
+					memcpy(texcoord + i * 2, streams->texcoord + corner[1] * 2, sizeof(a3f32) * 2);
+				else if (texcoord)
+					texcoord[i * 2 + 0] = texcoord[i * 2 + 1] = 0.0f;
+				if (normal && corner[2] != a3demoModelLoaderInternalNone)
+					memcpy(normal + i * 3, streams->normal + corner[2] * 3, sizeof(a3f32) * 3);
+				else if (normal && !calcNormals)
+					++numMissingNormals;
+			}
+
+			// blending follows the position index; positions without 
+			//	weights are bound fully to the first influence
+			if (blend)
+			{
+				a3i32 *const blendIndex = (a3i32 *)(blend + numVertices * 4);
+				for (i = 0; i < numVertices; ++i)
+				{
+					const a3ui32 p = streams->corner[vertexCorner[i] * 3];
+					for (k = 0; k < 4; ++k)
+					{
+						blend[i * 4 + k] = p < numBlendPositions ? (a3f32)blendWeights[p * 4 + k] : (a3f32)(k == 0);
+						blendIndex[i * 4 + k] = p < numBlendPositions ? blendIndices[p * 4 + k] : 0;
+					}
+				}
+			}
+
+			// normals not taken from the file are accumulated by position
+			//	(smooth, across texcoord seams) or by vertex (flat); if some 
+			//	corners in the file have normals, only the others are filled
+			if (normal && (calcNormals || numMissingNormals))
+			{
+				const a3ui32 numKeys = flat ? numVertices : total[0];
+				key = (a3ui32 *)(accum + numKeys * 3);
+				for (i = 0; i < numVertices; ++i)
+					key[i] = flat ? i : streams->corner[vertexCorner[i] * 3];
+				memset(accum, 0, sizeof(a3f32) * numKeys * 3);
+				a3demoModelLoaderInternalAccumulateNormals(accum, key, position, index, total[3]);
+				for (i = 0; i < numVertices; ++i)
+					if (calcNormals || streams->corner[vertexCorner[i] * 3 + 2] == a3demoModelLoaderInternalNone)
+						memcpy(normal + i * 3, accum + key[i] * 3, sizeof(a3f32) * 3);
+			}
+			if (normal)
+				for (i = 0; i < numVertices; ++i)
+					a3demoModelLoaderInternalNormalize(normal + i * 3);
+
+			// indices in the selected format
+			switch (geom_out->indexFormat->indexSize)
+			{
+			case 1:
+				for (i = 0; i < numCorners; ++i)
+					((a3ui8 *)attrib)[i] = (a3ui8)index[i];
+				break;
+			case 2:
+				for (i = 0; i < numCorners; ++i)
+					((a3ui16 *)attrib)[i] = (a3ui16)index[i];
+				break;
+			default:
+				memcpy(attrib, index, sizeof(a3ui32) * numCorners);
+				break;
+			}
+
+			// tangents use the finished vertices and indices
+			if (tangent)
+				a3demo_generateTangentBasis(geom_out, numThreads);
+			result = 1;
+		}
+		else
+		{
+			free(data);
+			memset(geom_out, 0, sizeof(a3_GeometryData));
+			result = 0;
+		}
+		free(accum);
+		free(index);
+		free(streams->position);
+		return result;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3demo_loadModelOBJ(a3_GeometryData *geom_out, const a3byte *filePath, const a3_ModelLoaderFlag flags, const a3f32 *transform_opt, const a3ui32 numThreads)
+{
+	return a3demoModelLoaderInternalLoad(geom_out, filePath, flags, transform_opt, numThreads, 0, 0, 0);
+}
+
+a3i32 a3demo_loadModelOBJBlending(a3_GeometryData *geom_out, const a3byte *filePath, const a3_ModelLoaderFlag flags, const a3f32 *transform_opt, const a3ui32 numThreads, const a3real *blendWeights, const a3i32 *blendIndices, const a3ui32 numBlendPositions)
+{
+	if (blendWeights && blendIndices)
+		return a3demoModelLoaderInternalLoad(geom_out, filePath, flags, transform_opt, numThreads, blendWeights, blendIndices, numBlendPositions);
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
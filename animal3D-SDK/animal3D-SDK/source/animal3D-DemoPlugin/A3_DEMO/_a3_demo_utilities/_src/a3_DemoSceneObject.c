@@ -26,6 +26,8 @@
 
 #include "../a3_DemoRenderUtils.h"
 
+#include "../../_animation/a3_MatrixBatch.h"
+
 
 //-----------------------------------------------------------------------------
 
@@ -35,7 +37,7 @@ extern inline void a3demo_initSceneObject(a3_DemoSceneObject *sceneObject)
 	a3real4x4SetIdentity(sceneObject->modelMat.m);
 	a3real4x4SetIdentity(sceneObject->modelMatInv.m);
 	a3real3Set(sceneObject->euler.v, a3real_zero, a3real_zero, a3real_zero);
-	a3real3Set(sceneObject->position.v, a3real_zero, a3real_zero, a3real_zero);
+	a3demo_setSceneObjectPosition(sceneObject, 0.0, 0.0, 0.0);
 }
 
 extern inline void a3demo_updateSceneObject(a3_DemoSceneObject *sceneObject, const a3boolean useZYX)
@@ -44,7 +46,9 @@ extern inline void a3demo_updateSceneObject(a3_DemoSceneObject *sceneObject, con
 		a3real4x4SetRotateZYX(sceneObject->modelMat.m, sceneObject->euler.x, sceneObject->euler.y, sceneObject->euler.z);
 	else
 		a3real4x4SetRotateXYZ(sceneObject->modelMat.m, sceneObject->euler.x, sceneObject->euler.y, sceneObject->euler.z);
-	sceneObject->modelMat.v3.xyz = sceneObject->position;
+	sceneObject->modelMat.v3.x = (a3real)sceneObject->position.x;
+	sceneObject->modelMat.v3.y = (a3real)sceneObject->position.y;
+	sceneObject->modelMat.v3.z = (a3real)sceneObject->position.z;
 	a3real4x4TransformInverseIgnoreScale(sceneObject->modelMatInv.m, sceneObject->modelMat.m);
 }
 
@@ -73,13 +77,22 @@ extern inline a3i32 a3demo_moveSceneObject(a3_DemoSceneObject *sceneObject, cons
 		a3real3Add(delta[0], delta[1]);									// add the 3 deltas together
 		a3real3Add(delta[0], delta[2]);
 		a3real3MulS(delta[0], speed * a3real3LengthInverse(delta[0]));	// normalize and scale by speed
-		a3real3Add(sceneObject->position.v, delta[0]);					// add delta to current
+		sceneObject->position.x += delta[0][0];							// add delta to current
+		sceneObject->position.y += delta[0][1];
+		sceneObject->position.z += delta[0][2];
 
 		return 1;
 	}
 	return 0;
 }
 
+extern inline void a3demo_setSceneObjectPosition(a3_DemoSceneObject *sceneObject, const a3f64 x, const a3f64 y, const a3f64 z)
+{
+	sceneObject->position.x = x;
+	sceneObject->position.y = y;
+	sceneObject->position.z = z;
+}
+
 
 extern inline void a3demo_setProjectorSceneObject(a3_DemoProjector *projector, a3_DemoSceneObject *sceneObject)
 {
@@ -133,17 +146,36 @@ extern inline void a3demo_resetViewerMatrixStack(a3_DemoViewerMatrixStack* viewe
 	viewer->viewProjectionBiasMat = viewer->viewProjectionBiasMatInverse = a3mat4_identity;
 }
 
-extern inline void a3demo_updateModelMatrixStack(a3_DemoModelMatrixStack* model, a3real4x4p const projectionMat_viewer, a3real4x4p const modelMat_viewer, a3real4x4p const modelMatInv_viewer, a3real4x4p const modelMat, a3real4x4p const atlasMat)
+extern inline void a3demo_updateModelMatrixStack(a3_DemoModelMatrixStack* model, a3real4x4p const projectionMat_viewer, a3real4x4p const modelMat_viewer, a3real4x4p const modelMatInv_viewer, a3real4x4p const modelMat, a3real4x4p const atlasMat, a3f64 const* position_viewer, a3f64 const* position)
 {
 	a3real4x4SetReal4x4(model->modelMat.m, modelMat);
-	a3real4x4TransformInverse(model->modelMatInverse.m, modelMat);
+	a3matrixTransformInverse(&model->modelMatInverse, &model->modelMat);
 	a3demo_quickTransposedZeroBottomRow(model->modelMatInverseTranspose.m, model->modelMatInverse.m);
 	
-	a3real4x4ProductTransform(model->modelViewMat.m, modelMatInv_viewer, modelMat);
-	a3real4x4ProductTransform(model->modelViewMatInverse.m, model->modelMatInverse.m, modelMat_viewer);
+	if (position_viewer && position)
+	{
+		// camera-relative: the offset between the double positions is taken 
+		//	before rounding to float, so it stays precise wherever the pair 
+		//	is in the world, and the viewer's own translation drops out
+		a3mat4 modelMat_rel = model->modelMat, modelMatInv_rel;
+		a3mat4 modelMat_viewer_rel = *(const a3mat4 *)modelMat_viewer, modelMatInv_viewer_rel = *(const a3mat4 *)modelMatInv_viewer;
+		modelMat_rel.v3.x = (a3real)(position[0] - position_viewer[0]);
+		modelMat_rel.v3.y = (a3real)(position[1] - position_viewer[1]);
+		modelMat_rel.v3.z = (a3real)(position[2] - position_viewer[2]);
+		modelMat_viewer_rel.v3 = modelMatInv_viewer_rel.v3 = a3vec4_w;
+		a3matrixTransformInverse(&modelMatInv_rel, &modelMat_rel);
+
+		a3matrixProductTransform(&model->modelViewMat, &modelMatInv_viewer_rel, &modelMat_rel);
+		a3matrixProductTransform(&model->modelViewMatInverse, &modelMatInv_rel, &modelMat_viewer_rel);
+	}
+	else
+	{
+		a3matrixProductTransform(&model->modelViewMat, (const a3mat4 *)modelMatInv_viewer, &model->modelMat);
+		a3matrixProductTransform(&model->modelViewMatInverse, &model->modelMatInverse, (const a3mat4 *)modelMat_viewer);
+	}
 	a3demo_quickTransposedZeroBottomRow(model->modelViewMatInverseTranspose.m, model->modelViewMatInverse.m);
 
-	a3real4x4Product(model->modelViewProjectionMat.m, projectionMat_viewer, model->modelViewMat.m);
+	a3matrixProduct(&model->modelViewProjectionMat, (const a3mat4 *)projectionMat_viewer, &model->modelViewMat);
 	a3real4x4SetReal4x4(model->atlasMat.m, atlasMat);
 }
 
@@ -0,0 +1,262 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoTangentBasis.c
+	Parallel tangent basis generation implementation.
+*/
+
+#include "../a3_DemoTangentBasis.h"
+
+#include "animal3D-A3DM/animal3D-A3DM.h"
+#include "animal3D/a3utility/a3_Thread.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+// geometry streams and per-block sums; each vertex sum is the weighted
+//	tangent (xyz) and the weighted orientation sign (w)
+typedef struct a3_DemoTangentBasisJob
+{
+	const a3f32 *position, *normal, *texcoord;
+	const void *indexData;
+	a3f32 *tangent, *bitangent;
+	a3f32 *sum;
+	a3ui32 indexSize, numVertices, numTriangles, numSums;
+	a3ui32 first, count;		// first block and step to sum, or vertices to merge
+} a3_DemoTangentBasisJob;
+
+// triangles are summed in blocks of about this many, one buffer each; the
+//	blocks depend only on the mesh, never on the thread count, so the
+//	merged sums are the same for any number of threads
+#define a3demoTangentBasisInternalBlockSize	4096
+
+
+//-----------------------------------------------------------------------------
+
+inline a3ui32 a3demoTangentBasisInternalIndex(a3_DemoTangentBasisJob const *job, const a3ui32 i)
+{
+	switch (job->indexSize)
+	{
+	case 0: return i;
+	case 1: return ((const a3ui8 *)job->indexData)[i];
+	case 2: return ((const a3ui16 *)job->indexData)[i];
+	}
+	return ((const a3ui32 *)job->indexData)[i];
+}
+
+inline a3f32 a3demoTangentBasisInternalDot(const a3f32 *a, const a3f32 *b)
+{
+	return (a[0] * b[0] + a[1] * b[1] + a[2] * b[2]);
+}
+
+// remove the component along unit n, then normalize; false if nothing
+//	is left
+inline a3boolean a3demoTangentBasisInternalProjectUnit(a3f32 *v_out, const a3f32 *v, const a3f32 *n)
+{
+	const a3f32 d = a3demoTangentBasisInternalDot(n, v);
+	a3f32 lenSq;
+	v_out[0] = v[0] - n[0] * d;
+	v_out[1] = v[1] - n[1] * d;
+	v_out[2] = v[2] - n[2] * d;
+	lenSq = a3demoTangentBasisInternalDot(v_out, v_out);
+	if (lenSq > 1e-20f)
+	{
+		const a3f32 lenInv = 1.0f / sqrtf(lenSq);
+		v_out[0] *= lenInv;
+		v_out[1] *= lenInv;
+		v_out[2] *= lenInv;
+		return a3true;
+	}
+	return a3false;
+}
+
+// worker: sum corner contributions of every 'count'th block of triangles,
+//	starting at block 'first'
+a3ret a3demoTangentBasisInternalSumThread(void *args)
+{
+	a3_DemoTangentBasisJob *job = (a3_DemoTangentBasisJob *)args;
+	a3f32 d1[3], d2[3], os[3], e1[3], e2[3], t[3], sign, area, angle, c, *blockSum;
+	a3ui32 block, tri, tri1, k, r, v[3], numBlocks = 0;
+	for (block = job->first; block < job->numSums; block += job->count, ++numBlocks)
+	{
+		blockSum = job->sum + job->numVertices * 4 * block;
+		memset(blockSum, 0, sizeof(a3f32) * 4 * job->numVertices);
+		tri1 = (a3ui32)((a3ui64)job->numTriangles * (block + 1) / job->numSums);
+		for (tri = (a3ui32)((a3ui64)job->numTriangles * block / job->numSums); tri < tri1; ++tri)
+		{
+			const a3f32 *p[3], *uv[3];
+			for (k = 0; k < 3; ++k)
+			{
+				v[k] = a3demoTangentBasisInternalIndex(job, tri * 3 + k);
+				p[k] = job->position + v[k] * 3;
+				uv[k] = job->texcoord + v[k] * 2;
+			}
+
+			// texture-space s axis of the triangle (MikkTSpace vOs), signed
+			//	so that mirrored texture gives a consistent direction
+			for (r = 0; r < 3; ++r)
+			{
+				d1[r] = p[1][r] - p[0][r];
+				d2[r] = p[2][r] - p[0][r];
+			}
+			area = (uv[1][0] - uv[0][0]) * (uv[2][1] - uv[0][1]) - (uv[1][1] - uv[0][1]) * (uv[2][0] - uv[0][0]);
+			if (area == 0.0f)
+				continue;
+			sign = area > 0.0f ? 1.0f : -1.0f;
+			for (r = 0; r < 3; ++r)
+				os[r] = ((uv[2][1] - uv[0][1]) * d1[r] - (uv[1][1] - uv[0][1]) * d2[r]) * sign;
+
+			// each corner: axis projected onto its normal, weighted by the
+			//	corner angle measured in the same tangent plane
+			for (k = 0; k < 3; ++k)
+			{
+				const a3f32 *n = job->normal + v[k] * 3, *p1 = p[(k + 1) % 3], *p2 = p[(k + 2) % 3];
+				a3f32 *sum = blockSum + v[k] * 4;
+				for (r = 0; r < 3; ++r)
+				{
+					d1[r] = p1[r] - p[k][r];
+					d2[r] = p2[r] - p[k][r];
+				}
+				if (!a3demoTangentBasisInternalProjectUnit(t, os, n) ||
+					!a3demoTangentBasisInternalProjectUnit(e1, d1, n) ||
+					!a3demoTangentBasisInternalProjectUnit(e2, d2, n))
+					continue;
+				c = a3demoTangentBasisInternalDot(e1, e2);
+				angle = acosf(c > 1.0f ? 1.0f : c < -1.0f ? -1.0f : c);
+				for (r = 0; r < 3; ++r)
+					sum[r] += t[r] * angle;
+				sum[3] += sign * angle;
+			}
+		}
+	}
+	return numBlocks;
+}
+
+// worker: merge all sums for a range of vertices and write the basis
+a3ret a3demoTangentBasisInternalMergeThread(void *args)
+{
+	a3_DemoTangentBasisJob *job = (a3_DemoTangentBasisJob *)args;
+	a3f32 s[4], t[3], axis[3] = { 0 };
+	a3ui32 i, j, r;
+	for (i = job->first; i < job->first + job->count; ++i)
+	{
+		const a3f32 *n = job->normal + i * 3;
+		a3f32 *tangent = job->tangent + i * 3, *bitangent = job->bitangent + i * 3, sign;
+		s[0] = s[1] = s[2] = s[3] = 0.0f;
+		for (j = 0; j < job->numSums; ++j)
+			for (r = 0; r < 4; ++r)
+				s[r] += job->sum[(j * job->numVertices + i) * 4 + r];
+
+		// vertices with no usable triangle get any tangent perpendicular
+		//	to the normal
+		if (!a3demoTangentBasisInternalProjectUnit(t, s, n))
+		{
+			axis[0] = axis[1] = axis[2] = 0.0f;
+			axis[(n[0] * n[0] < n[1] * n[1]) ? (n[0] * n[0] < n[2] * n[2] ? 0 : 2) : (n[1] * n[1] < n[2] * n[2] ? 1 : 2)] = 1.0f;
+			if (!a3demoTangentBasisInternalProjectUnit(t, axis, n))
+				t[0] = 1.0f, t[1] = t[2] = 0.0f;
+		}
+		sign = s[3] < 0.0f ? -1.0f : 1.0f;
+		memcpy(tangent, t, sizeof(t));
+		bitangent[0] = (n[1] * t[2] - n[2] * t[1]) * sign;
+		bitangent[1] = (n[2] * t[0] - n[0] * t[2]) * sign;
+		bitangent[2] = (n[0] * t[1] - n[1] * t[0]) * sign;
+	}
+	return job->count;
+}
+
+// run jobs; if a thread fails to launch, its job runs here instead
+inline void a3demoTangentBasisInternalRun(a3_threadfunc func, a3_DemoTangentBasisJob *job, const a3ui32 n)
+{
+	a3_Thread thread[a3demo_tangentBasisThreadMax] = { 0 };
+	a3boolean launched[a3demo_tangentBasisThreadMax];
+	a3ui32 i;
+	for (i = 1; i < n; ++i)
+		if ((launched[i] = (a3threadLaunch(thread + i, func, job + i, 0) > 0)) == 0)
+			func(job + i);
+	func(job);
+	for (i = 1; i < n; ++i)
+		if (launched[i])
+			a3threadWait(thread + i);
+}
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3demo_generateTangentBasis(a3_GeometryData *geom, const a3ui32 numThreads)
+{
+	if (geom && geom->data && numThreads)
+	{
+		a3_DemoTangentBasisJob job[a3demo_tangentBasisThreadMax];
+		const a3ui32 numCorners = geom->numIndices ? geom->numIndices : geom->numVertices;
+		const a3ui32 numTriangles = numCorners / 3, numVertices = geom->numVertices;
+		const a3ui32 numBlocks = numTriangles / a3demoTangentBasisInternalBlockSize < a3demo_tangentBasisThreadMax ? numTriangles / a3demoTangentBasisInternalBlockSize + 1 : a3demo_tangentBasisThreadMax;
+		a3ui32 n = numThreads < numBlocks ? numThreads : numBlocks, i;
+		const void *bitangent = 0;
+		a3f32 *sum;
+
+		if (geom->primType != a3prim_triangles || !numTriangles ||
+			!geom->attribData[a3attrib_geomPosition] || !geom->attribData[a3attrib_geomNormal] ||
+			!geom->attribData[a3attrib_geomTexcoord] || !geom->attribData[a3attrib_geomTangent] ||
+			a3geometryGetAddressBitangent(&bitangent, geom) <= 0 || !bitangent)
+			return 0;
+
+		// small meshes are one block, so they get no extra threads; every
+		//	block costs a buffer over all vertices
+		sum = (a3f32 *)malloc(sizeof(a3f32) * 4 * numVertices * numBlocks);
+		if (!sum)
+			return 0;
+
+		for (i = 0; i < n; ++i)
+		{
+			job[i].position = (const a3f32 *)geom->attribData[a3attrib_geomPosition];
+			job[i].normal = (const a3f32 *)geom->attribData[a3attrib_geomNormal];
+			job[i].texcoord = (const a3f32 *)geom->attribData[a3attrib_geomTexcoord];
+			job[i].tangent = (a3f32 *)geom->attribData[a3attrib_geomTangent];
+			job[i].bitangent = (a3f32 *)bitangent;
+			job[i].indexData = geom->indexData;
+			job[i].indexSize = geom->numIndices ? geom->indexFormat->indexSize : 0;
+			job[i].numVertices = numVertices;
+			job[i].numTriangles = numTriangles;
+			job[i].numSums = numBlocks;
+			job[i].sum = sum;
+			job[i].first = i;
+			job[i].count = n;
+		}
+		a3demoTangentBasisInternalRun(a3demoTangentBasisInternalSumThread, job, n);
+
+		// merge adds the buffers in block order, so all jobs see the first
+		for (i = 0; i < n; ++i)
+		{
+			job[i].first = (a3ui32)((a3ui64)numVertices * i / n);
+			job[i].count = (a3ui32)((a3ui64)numVertices * (i + 1) / n) - job[i].first;
+		}
+		a3demoTangentBasisInternalRun(a3demoTangentBasisInternalMergeThread, job, n);
+
+		free(sum);
+		return numVertices;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,66 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoVertexFormat.c
+	Packed vertex format implementation.
+*/
+
+#include "../a3_DemoVertexFormat.h"
+
+
+//-----------------------------------------------------------------------------
+
+a3i32 a3demo_packGeometryVertexFormat(a3_GeometryData *geom, const a3boolean octahedral)
+{
+	if (geom && geom->data)
+	{
+		const a3_VertexAttributeType unitType = octahedral ? a3attrib_octvec3 : a3attrib_snorm16vec3;
+		a3_VertexAttributeDescriptor attrib[a3attrib_nameMax];
+		a3ui32 numAttribs = 0;
+
+		// same attribute slots as the unpacked format, so shaders and
+		//	drawable generation see the same names
+		if (geom->attribData[a3attrib_geomPosition])
+			a3vertexAttribCreateDescriptor(attrib + numAttribs++, a3attrib_position, a3attrib_hvec3);
+		if (geom->attribData[a3attrib_geomNormal])
+			a3vertexAttribCreateDescriptor(attrib + numAttribs++, a3attrib_normal, unitType);
+		if (geom->attribData[a3attrib_geomColor])
+			a3vertexAttribCreateDescriptor(attrib + numAttribs++, a3attrib_color, a3attrib_vec4);
+		if (geom->attribData[a3attrib_geomTexcoord])
+			a3vertexAttribCreateDescriptor(attrib + numAttribs++, a3attrib_texcoord, a3attrib_unorm16vec2);
+		if (geom->attribData[a3attrib_geomTangent])
+		{
+			a3vertexAttribCreateDescriptor(attrib + numAttribs++, a3attrib_tangent, unitType);
+			a3vertexAttribCreateDescriptor(attrib + numAttribs++, a3attrib_bitangent, unitType);
+		}
+		if (geom->attribData[a3attrib_geomBlending])
+		{
+			a3vertexAttribCreateDescriptor(attrib + numAttribs++, a3attrib_blendWeights, a3attrib_unorm8vec4);
+			a3vertexAttribCreateDescriptor(attrib + numAttribs++, a3attrib_blendIndices, a3attrib_ivec4);
+		}
+		if (numAttribs && a3vertexFormatCreateDescriptor(geom->vertexFormat, attrib, numAttribs) > 0)
+			return geom->vertexFormat->vertexSize;
+		return 0;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,136 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoBVH.h
+	Dynamic bounding volume hierarchy over object bounds for frustum, ray
+		and overlap queries.
+*/
+
+#ifndef __ANIMAL3D_DEMOBVH_H
+#define __ANIMAL3D_DEMOBVH_H
+
+
+// object bounds and frustum
+#include "a3_DemoCulling.h"
+
+// mouse coordinates for picking
+#include "animal3D/a3input/a3_MouseInput.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoBVHNode	a3_DemoBVHNode;
+	typedef struct a3_DemoBVH		a3_DemoBVH;
+	typedef enum a3_DemoBVHLimits	a3_DemoBVHLimits;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// build and refit limits
+	enum a3_DemoBVHLimits
+	{
+		a3demo_bvhLeafMax = 4,		// most objects in one leaf
+		a3demo_bvhBinCount = 16,	// SAH candidate bins per split
+		a3demo_bvhDepthMax = 48,	// deeper splits are by count, not SAH
+		a3demo_bvhThreadMax = 32	// most threads used by a single refit
+	};
+
+
+	// node of the hierarchy; nodes are stored depth-first so the left
+	//	child directly follows its parent and every subtree is one range
+	//	of nodes, [self, skip), covering one range of the object list
+	struct a3_DemoBVHNode
+	{
+		a3real boxMin[3], boxMax[3];	// world box of the subtree
+		a3ui32 first, count;			// objects of the subtree in list
+		a3ui32 right;					// right child; zero for a leaf
+		a3ui32 skip;					// first node after the subtree
+	};
+
+	// hierarchy over a3_DemoCullingBounds boxes; refit every frame and
+	//	rebuilt when its surface area cost degrades or periodically
+	struct a3_DemoBVH
+	{
+		a3_DemoBVHNode *node;		// node array (capacity * 2 - 1)
+		a3ui32 *object;				// object indices in leaf order
+		a3ui32 capacity;			// most objects
+		a3ui32 objectCount;			// objects in the last build
+		a3ui32 nodeCount;			// nodes in the last build
+		a3real cost, cost_build;	// surface area cost now and when built
+		a3real rebuildRatio;		// rebuild when cost grows by this factor
+		a3ui32 refitCount;			// refits since the last build
+		a3ui32 refitMax;			// rebuild after this many refits (0 off)
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// allocate hierarchy for up to a number of objects
+	a3i32 a3demo_createBVH(a3_DemoBVH *bvh_out, const a3ui32 capacity);
+
+	// release hierarchy
+	a3i32 a3demo_releaseBVH(a3_DemoBVH *bvh);
+
+	// full binned SAH build from bounds; returns number of nodes
+	a3i32 a3demo_buildBVH(a3_DemoBVH *bvh, a3_DemoCullingBounds const *bounds);
+
+	// refit node boxes to the current bounds without changing the tree;
+	//	subtrees are refit on up to a3demo_bvhThreadMax threads (the
+	//	calling thread runs the first); returns number of nodes
+	a3i32 a3demo_refitBVH(a3_DemoBVH *bvh, a3_DemoCullingBounds const *bounds, const a3ui32 numThreads);
+
+	// per-frame update: refit, then rebuild if the object count changed,
+	//	the cost grew past the rebuild ratio or too many refits have run;
+	//	returns 1 if rebuilt, 0 if only refit
+	a3i32 a3demo_updateBVH(a3_DemoBVH *bvh, a3_DemoCullingBounds const *bounds, const a3ui32 numThreads);
+
+	// write indices of objects whose boxes may be inside the frustum and
+	//	return how many (not sorted); output must have room for all objects
+	a3i32 a3demo_queryBVHFrustum(a3ui32 *visible_out, a3_DemoBVH const *bvh, a3_DemoCullingBounds const *bounds, a3_DemoCullingFrustum const *frustum);
+
+	// write indices of objects whose boxes overlap a world box and return
+	//	how many, never more than the output size
+	a3i32 a3demo_queryBVHOverlap(a3ui32 *overlap_out, const a3ui32 overlapMax, a3_DemoBVH const *bvh, a3_DemoCullingBounds const *bounds, const a3real3p boxMin, const a3real3p boxMax);
+
+	// find the nearest object box hit by a ray (direction need not be
+	//	unit, distance is in its units); returns 1 if hit, 0 if not
+	a3i32 a3demo_queryBVHRay(a3ui32 *hitIndex_out, a3real *hitDistance_out_opt, a3_DemoBVH const *bvh, a3_DemoCullingBounds const *bounds, const a3real3p origin, const a3real3p direction);
+
+	// world-space picking ray through the mouse position: window position
+	//	is offset by the frame border and scaled by the inverse frame size
+	//	into NDC, then unprojected with the camera's inverse projection and
+	//	model matrix; direction is unit length
+	a3i32 a3demo_getPickRay(a3real3p origin_out, a3real3p direction_out, a3_MouseInput const *mouse, const a3i32 frameBorder, const a3real frameWidthInv, const a3real frameHeightInv, const a3real4x4p projectionMatInv, const a3real4x4p cameraMat);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOBVH_H
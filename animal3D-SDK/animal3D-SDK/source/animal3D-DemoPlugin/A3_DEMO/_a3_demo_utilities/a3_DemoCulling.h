@@ -0,0 +1,110 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoCulling.h
+	Batch view frustum culling of object bounds (boxes and spheres).
+*/
+
+#ifndef __ANIMAL3D_DEMOCULLING_H
+#define __ANIMAL3D_DEMOCULLING_H
+
+
+// math library
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+// instruction set is chosen at compile time: AVX when the compiler targets
+//	it (8 objects per test), otherwise SSE2 (4 objects, always on x64),
+//	otherwise scalar; only single precision reals are vectorized
+#if !(defined A3_REAL_F64 || defined A3_REAL_F128)
+#if (defined __AVX__ || defined __AVX2__)
+#define A3_DEMOCULLING_AVX
+#include <immintrin.h>
+#elif (defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__)
+#define A3_DEMOCULLING_SSE
+#include <emmintrin.h>
+#endif	// AVX, SSE2
+#endif	// !(A3_REAL_F64 || A3_REAL_F128)
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef struct a3_DemoCullingBounds		a3_DemoCullingBounds;
+	typedef struct a3_DemoCullingFrustum	a3_DemoCullingFrustum;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// world-space bounds of many objects, one stream per component (SoA)
+	struct a3_DemoCullingBounds
+	{
+		a3real *center[3];	// box and sphere center
+		a3real *extent[3];	// box half-size along each world axis
+		a3real *radius;		// sphere radius
+		a3ui32 count;		// number of objects
+	};
+
+	// frustum planes (left, right, bottom, top, near, far); a point p is
+	//	inside a plane when dot(plane.xyz, p) + plane.w >= 0
+	struct a3_DemoCullingFrustum
+	{
+		a3vec4 plane[6];
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// allocate bounds for a number of objects, all initially empty at origin
+	a3i32 a3demo_createCullingBounds(a3_DemoCullingBounds *bounds_out, const a3ui32 count);
+
+	// release bounds
+	a3i32 a3demo_releaseCullingBounds(a3_DemoCullingBounds *bounds);
+
+	// set bounds of one object from its model matrix and its local box
+	//	(center and half-size); the world box encloses the transformed box
+	//	and the sphere encloses the world box
+	a3i32 a3demo_setCullingBoundsTransformed(a3_DemoCullingBounds const *bounds, const a3ui32 index, const a3real4x4p modelMat, const a3real3p center_local, const a3real3p extent_local);
+
+	// extract normalized frustum planes from a view-projection matrix
+	a3i32 a3demo_extractCullingFrustum(a3_DemoCullingFrustum *frustum_out, const a3real4x4p viewProjectionMat);
+
+	// test boxes against frustum; writes indices of objects that may be
+	//	visible, in increasing order, and returns how many; the output
+	//	must have room for every object
+	a3i32 a3demo_cullBoxes(a3ui32 *visible_out, a3_DemoCullingBounds const *bounds, a3_DemoCullingFrustum const *frustum);
+
+	// test spheres against frustum, same output as boxes
+	a3i32 a3demo_cullSpheres(a3ui32 *visible_out, a3_DemoCullingBounds const *bounds, a3_DemoCullingFrustum const *frustum);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOCULLING_H
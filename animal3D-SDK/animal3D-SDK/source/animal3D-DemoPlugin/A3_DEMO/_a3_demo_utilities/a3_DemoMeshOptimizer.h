@@ -0,0 +1,86 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoMeshOptimizer.h
+	Vertex cache, overdraw and vertex fetch ordering for indexed triangles.
+*/
+
+#ifndef __ANIMAL3D_DEMOMESHOPTIMIZER_H
+#define __ANIMAL3D_DEMOMESHOPTIMIZER_H
+
+
+// geometry data
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef enum a3_DemoMeshOptimizerCacheSize	a3_DemoMeshOptimizerCacheSize;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// post-transform vertex cache size the ordering is tuned for
+	enum a3_DemoMeshOptimizerCacheSize
+	{
+		a3demo_meshOptimizerCacheSize = 32
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// reorder indexed triangle geometry for drawing, in three passes:
+	//	-> vertex cache: greedy Forsyth ordering, each step emitting the
+	//		triangle whose vertices score best by cache position and by how
+	//		few triangles still use them
+	//	-> overdraw: the cache-ordered triangles are cut into clusters
+	//		wherever the running miss ratio (ACMR) of the cluster is within
+	//		overdrawThreshold of the whole cluster's, and clusters facing out
+	//		from the mesh center are moved first; a threshold below 1 skips
+	//		this pass, higher values trade cache hits for less overdraw
+	//	-> vertex fetch: vertices are renumbered in order of first use
+	//	-> geom points to numShapes geometries with the same vertices and
+	//		indices (e.g. morph targets); the first one is ordered and the
+	//		others are given the same indices and vertex order
+	//	returns number of triangles, 0 if the geometry is not indexed
+	//		triangles or the shapes do not match, -1 if invalid params
+	a3i32 a3demo_optimizeGeometry(a3_GeometryData *geom, const a3ui32 numShapes, const a3f32 overdrawThreshold);
+
+	// average vertex cache misses per triangle of indexed triangle geometry
+	//	for a FIFO cache of the given size (0.5 is ideal for large regular
+	//	meshes, 3 is worst)
+	//	returns ACMR, 0 if not indexed triangles, -1 if invalid params
+	a3f32 a3demo_getGeometryACMR(a3_GeometryData const *geom, const a3ui32 cacheSize);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMESHOPTIMIZER_H
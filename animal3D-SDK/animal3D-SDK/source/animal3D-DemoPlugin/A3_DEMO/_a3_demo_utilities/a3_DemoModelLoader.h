@@ -0,0 +1,90 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoModelLoader.h
+	Parallel Wavefront OBJ loader producing geometry data.
+*/
+
+#ifndef __ANIMAL3D_DEMOMODELLOADER_H
+#define __ANIMAL3D_DEMOMODELLOADER_H
+
+
+// geometry data and loader flags
+#include "animal3D/a3geometry/a3_GeometryData.h"
+#include "animal3D/a3geometry/a3_ModelLoader_WavefrontOBJ.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef enum a3_DemoModelLoaderThreadMax	a3_DemoModelLoaderThreadMax;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// maximum number of threads parsing one file
+	enum a3_DemoModelLoaderThreadMax
+	{
+		a3demo_modelLoaderThreadMax = 32
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// load a Wavefront OBJ file into geometry data usable anywhere the
+	//	result of a3modelLoadOBJ is (drawables, binary save/load, release):
+	//	the file is memory-mapped and split at line boundaries into chunks
+	//	parsed on up to a3demo_modelLoaderThreadMax threads (the calling
+	//	thread parses the first), then unique (v, vt, vn) corners become
+	//	vertices through a hash table
+	//	-> polygons of any size are fanned into triangles; negative
+	//		(relative) indices are accepted; groups, smoothing groups and
+	//		materials are ignored
+	//	-> flags are the same as a3modelLoadOBJ; face normals and tangents
+	//		give every triangle its own vertices; tangents need texcoords
+	//	-> transform_opt is a column-major 4x4 applied to positions; loaded
+	//		normals use its inverse-transpose
+	//	returns 1 if success, 0 if the file could not be read or is not
+	//		valid, -1 if invalid params
+	a3i32 a3demo_loadModelOBJ(a3_GeometryData *geom_out, const a3byte *filePath, const a3_ModelLoaderFlag flags, const a3f32 *transform_opt, const a3ui32 numThreads);
+
+	// load a Wavefront OBJ file as above, also filling the blending 
+	//	attribute for skinning: blendWeights and blendIndices hold 4 of 
+	//	each per OBJ position ('v' line, in file order), as written by 
+	//	a3skinWeightsDecode; positions past numBlendPositions are bound 
+	//	fully to influence 0
+	//	returns 1 if success, 0 if the file could not be read or is not 
+	//		valid, -1 if invalid params
+	a3i32 a3demo_loadModelOBJBlending(a3_GeometryData *geom_out, const a3byte *filePath, const a3_ModelLoaderFlag flags, const a3f32 *transform_opt, const a3ui32 numThreads, const a3real *blendWeights, const a3i32 *blendIndices, const a3ui32 numBlendPositions);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOMODELLOADER_H
@@ -38,6 +38,7 @@ extern "C"
 #else	// !__cplusplus
 	typedef struct a3_DemoModelMatrixStack	a3_DemoModelMatrixStack;
 	typedef struct a3_DemoViewerMatrixStack	a3_DemoViewerMatrixStack;
+	typedef union a3_DemoWorldPosition		a3_DemoWorldPosition;
 	typedef struct a3_DemoSceneObject		a3_DemoSceneObject;
 	typedef struct a3_DemoProjector			a3_DemoProjector;
 	typedef struct a3_DemoPointLight		a3_DemoPointLight;
@@ -72,13 +73,22 @@ extern "C"
 		a3mat4 viewProjectionBiasMatInverse;	// view-projection-bias inverse matrix (biased clip -> world)
 	};
 
+	// double-precision world position: objects far from the origin keep 
+	//	full precision here; the float model matrix holds the rounded 
+	//	position and rendering uses positions relative to the viewer
+	union a3_DemoWorldPosition
+	{
+		struct { a3f64 x, y, z; };
+		a3f64 v[3];
+	};
+
 	// general scene objects
 	struct a3_DemoSceneObject
 	{
 		a3mat4 modelMat;	// model matrix: transform relative to scene
 		a3mat4 modelMatInv;	// inverse model matrix: scene relative to this
 		a3vec3 euler;		// euler angles for direct rotation control
-		a3vec3 position;	// scene position for direct control
+		a3_DemoWorldPosition position;	// scene position for direct control
 		a3vec3 scale;		// scale (not accounted for in update)
 		a3i32 scaleMode;	// 0 = off; 1 = uniform; other = non-uniform (nightmare)
 	};
@@ -119,6 +129,7 @@ extern "C"
 	inline void a3demo_updateSceneObject(a3_DemoSceneObject *sceneObject, const a3boolean useZYX);
 	inline a3i32 a3demo_rotateSceneObject(a3_DemoSceneObject *sceneObject, const a3real speed, const a3real deltaX, const a3real deltaY, const a3real deltaZ);
 	inline a3i32 a3demo_moveSceneObject(a3_DemoSceneObject *sceneObject, const a3real speed, const a3real deltaX, const a3real deltaY, const a3real deltaZ);
+	inline void a3demo_setSceneObjectPosition(a3_DemoSceneObject *sceneObject, const a3f64 x, const a3f64 y, const a3f64 z);
 
 	inline void a3demo_setProjectorSceneObject(a3_DemoProjector *projector, a3_DemoSceneObject *sceneObject);
 	inline void a3demo_initProjector(a3_DemoProjector *projector);
@@ -127,7 +138,7 @@ extern "C"
 
 	inline void a3demo_resetModelMatrixStack(a3_DemoModelMatrixStack* model);
 	inline void a3demo_resetViewerMatrixStack(a3_DemoViewerMatrixStack* viewer);
-	inline void a3demo_updateModelMatrixStack(a3_DemoModelMatrixStack* model, a3real4x4p const projectionMat_viewer, a3real4x4p const modelMat_viewer, a3real4x4p const modelMatInv_viewer, a3real4x4p const modelMat, a3real4x4p const atlasMat);
+	inline void a3demo_updateModelMatrixStack(a3_DemoModelMatrixStack* model, a3real4x4p const projectionMat_viewer, a3real4x4p const modelMat_viewer, a3real4x4p const modelMatInv_viewer, a3real4x4p const modelMat, a3real4x4p const atlasMat, a3f64 const* position_viewer, a3f64 const* position);
 	inline void a3demo_updateViewerMatrixStack(a3_DemoViewerMatrixStack* viewer, a3real4x4p const modelMat_viewer, a3real4x4p const modelMatInv_viewer, a3real4x4p const projectionMat, a3real4x4p const projectionMatInv, a3real4x4p const biasMat, a3real4x4p const biasMatInv);
 
 
@@ -75,6 +75,10 @@ extern "C"
 				uColor0,					// color (used in whatever context is needed)
 				uColor;						// color (used in whatever context is needed)
 
+			a3i32
+				// animation uniform handles
+				uMorphWeight;				// morph target weights
+
 			a3i32
 				// common texture handles
 				uTex_dm, uTex_sm,			// named texture map handles for basic shading
@@ -89,7 +93,8 @@ extern "C"
 				// transformation uniform block handles
 				ubTransformStack,	// matrix stack block
 				ubTransformMVPB,	// model-view-projection-bias matrix block
-				ubTransformMVP;		// model-view-projection matrix block
+				ubTransformMVP,		// model-view-projection matrix block
+				ubTransformBlend;	// skinning palette block
 		};
 	};
 
@@ -0,0 +1,80 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoTangentBasis.h
+	Parallel tangent basis generation for triangle geometry.
+*/
+
+#ifndef __ANIMAL3D_DEMOTANGENTBASIS_H
+#define __ANIMAL3D_DEMOTANGENTBASIS_H
+
+
+// geometry data
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+	typedef enum a3_DemoTangentBasisThreadMax	a3_DemoTangentBasisThreadMax;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// maximum number of threads used by a single generation
+	enum a3_DemoTangentBasisThreadMax
+	{
+		a3demo_tangentBasisThreadMax = 32
+	};
+
+
+//-----------------------------------------------------------------------------
+
+	// overwrite the tangent and bitangent attributes of triangle geometry
+	//	that has positions, normals, texcoords and tangents, following
+	//	MikkTSpace: each corner adds its triangle's texture-space axes
+	//	projected onto the vertex normal, weighted by the corner angle, and
+	//	the bitangent is the normal cross the tangent signed by texture
+	//	orientation; vertices already share position, normal and texcoord,
+	//	so they are the MikkTSpace groups (split groups of disconnected
+	//	triangles on one vertex are merged)
+	//	-> triangles are split into up to a3demo_tangentBasisThreadMax
+	//		blocks, each summed into its own buffer, and the blocks are dealt
+	//		out to the threads (the calling thread runs the first); vertices
+	//		are then split to merge the buffers in block order, so the result
+	//		does not depend on the number of threads
+	//	returns number of vertices, 0 if the geometry is not indexed or
+	//		listed triangles or lacks an attribute, -1 if invalid params
+	a3i32 a3demo_generateTangentBasis(a3_GeometryData *geom, const a3ui32 numThreads);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOTANGENTBASIS_H
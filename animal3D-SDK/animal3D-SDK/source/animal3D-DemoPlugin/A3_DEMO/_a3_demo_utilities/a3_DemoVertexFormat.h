@@ -0,0 +1,65 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+
+	a3_DemoVertexFormat.h
+	Packed vertex formats for geometry uploaded by the demo.
+*/
+
+#ifndef __ANIMAL3D_DEMOVERTEXFORMAT_H
+#define __ANIMAL3D_DEMOVERTEXFORMAT_H
+
+
+// geometry data
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+	// replace the vertex format of geometry data with packed attribute
+	//	types; the float data is unchanged and is encoded when the drawable
+	//	is generated (see a3vertexBufferStore)
+	//	-> positions become half floats, texcoords (which must be in
+	//		[0, 1]) and blend weights become unsigned normalized, colors and
+	//		blend indices are kept
+	//	-> normals, tangents and bitangents become octahedral if requested,
+	//		which every vertex shader reading them must decode, otherwise
+	//		signed normalized, which shaders read as before
+	//	-> geometry sharing a vertex array must be packed the same way
+	//	returns packed vertex size, 0 if no attributes, -1 if invalid params
+	a3i32 a3demo_packGeometryVertexFormat(a3_GeometryData *geom, const a3boolean octahedral);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#endif	// !__ANIMAL3D_DEMOVERTEXFORMAT_H
@@ -30,6 +30,32 @@
 
 //-----------------------------------------------------------------------------
 
+// sample pose group between two key poses into a full hierarchy pose
+inline a3i32 a3hierarchyPoseGroupSample(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_HierarchyPoseGroup *poseGroup, const a3ui32 poseIndex0, const a3ui32 poseIndex1, const a3real u)
+{
+	if (poseGroup && poseGroup->hierarchy && poseIndex0 < poseGroup->poseCount && poseIndex1 < poseGroup->poseCount)
+	{
+		const a3ui32 numNodes = poseGroup->hierarchy->numNodes;
+		return a3spatialPoseSoALerp(pose_out, first_out,
+			&poseGroup->pose, poseIndex0 * numNodes, &poseGroup->pose, poseIndex1 * numNodes, numNodes, u);
+	}
+	return -1;
+}
+
+// sample pose group with a Catmull-Rom spline between two key poses, using 
+//	the keys before and after as neighbors, into a full hierarchy pose
+inline a3i32 a3hierarchyPoseGroupSampleCubic(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_HierarchyPoseGroup *poseGroup, const a3ui32 poseIndexPrev, const a3ui32 poseIndex0, const a3ui32 poseIndex1, const a3ui32 poseIndexNext, const a3real u)
+{
+	if (poseGroup && poseGroup->hierarchy && poseIndexPrev < poseGroup->poseCount && poseIndex0 < poseGroup->poseCount && 
+		poseIndex1 < poseGroup->poseCount && poseIndexNext < poseGroup->poseCount)
+	{
+		const a3ui32 numNodes = poseGroup->hierarchy->numNodes;
+		return a3spatialPoseSoACatmullRom(pose_out, first_out,
+			&poseGroup->pose, poseIndexPrev * numNodes, &poseGroup->pose, poseIndex0 * numNodes,
+			&poseGroup->pose, poseIndex1 * numNodes, &poseGroup->pose, poseIndexNext * numNodes, numNodes, u);
+	}
+	return -1;
+}
 
 
 //-----------------------------------------------------------------------------
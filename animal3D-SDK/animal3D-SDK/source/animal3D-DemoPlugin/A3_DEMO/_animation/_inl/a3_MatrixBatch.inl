@@ -0,0 +1,178 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_MatrixBatch.inl
+	Implementation of inline SIMD matrix operations.
+*/
+
+
+#ifdef __ANIMAL3D_MATRIXBATCH_H
+#ifndef __ANIMAL3D_MATRIXBATCH_INL
+#define __ANIMAL3D_MATRIXBATCH_INL
+
+
+//-----------------------------------------------------------------------------
+
+// matrices are column-major: output column j is the sum over k of left 
+//	column k scaled by right element [j][k]; all inputs are read before 
+//	any output is written so that outputs may alias inputs
+// with AVX, two output columns share a register: left columns are 
+//	duplicated into both halves and right elements are splat per half
+
+// general product: m_out = mL * mR; output may alias either input
+inline a3i32 a3matrixProduct(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR)
+{
+	if (m_out && mL && mR)
+	{
+#if (defined A3_MATRIXBATCH_AVX)
+		const __m256 l0 = _mm256_broadcast_ps((__m128 const *)(mL->mm + 0)), l1 = _mm256_broadcast_ps((__m128 const *)(mL->mm + 4));
+		const __m256 l2 = _mm256_broadcast_ps((__m128 const *)(mL->mm + 8)), l3 = _mm256_broadcast_ps((__m128 const *)(mL->mm + 12));
+		const __m256 r01 = _mm256_loadu_ps(mR->mm + 0), r23 = _mm256_loadu_ps(mR->mm + 8);
+		const __m256 o01 = _mm256_add_ps(
+			_mm256_add_ps(_mm256_mul_ps(l0, _mm256_shuffle_ps(r01, r01, 0x00)), _mm256_mul_ps(l1, _mm256_shuffle_ps(r01, r01, 0x55))),
+			_mm256_add_ps(_mm256_mul_ps(l2, _mm256_shuffle_ps(r01, r01, 0xaa)), _mm256_mul_ps(l3, _mm256_shuffle_ps(r01, r01, 0xff))));
+		const __m256 o23 = _mm256_add_ps(
+			_mm256_add_ps(_mm256_mul_ps(l0, _mm256_shuffle_ps(r23, r23, 0x00)), _mm256_mul_ps(l1, _mm256_shuffle_ps(r23, r23, 0x55))),
+			_mm256_add_ps(_mm256_mul_ps(l2, _mm256_shuffle_ps(r23, r23, 0xaa)), _mm256_mul_ps(l3, _mm256_shuffle_ps(r23, r23, 0xff))));
+		_mm256_storeu_ps(m_out->mm + 0, o01);
+		_mm256_storeu_ps(m_out->mm + 8, o23);
+#elif (defined A3_MATRIXBATCH_SSE)
+		const __m128 l0 = _mm_loadu_ps(mL->mm + 0), l1 = _mm_loadu_ps(mL->mm + 4), l2 = _mm_loadu_ps(mL->mm + 8), l3 = _mm_loadu_ps(mL->mm + 12);
+		__m128 o[4], r;
+		a3ui32 j;
+		for (j = 0; j < 4; ++j)
+		{
+			r = _mm_loadu_ps(mR->mm + j * 4);
+			o[j] = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(l0, _mm_shuffle_ps(r, r, 0x00)), _mm_mul_ps(l1, _mm_shuffle_ps(r, r, 0x55))),
+				_mm_add_ps(_mm_mul_ps(l2, _mm_shuffle_ps(r, r, 0xaa)), _mm_mul_ps(l3, _mm_shuffle_ps(r, r, 0xff))));
+		}
+		for (j = 0; j < 4; ++j)
+			_mm_storeu_ps(m_out->mm + j * 4, o[j]);
+#else	// scalar
+		a3mat4 tmp;
+		a3real4x4Product(tmp.m, mL->m, mR->m);
+		*m_out = tmp;
+#endif	// SIMD
+		return 1;
+	}
+	return -1;
+}
+
+// product of affine transforms (bottom row is 0, 0, 0, 1): m_out = mL * mR; 
+//	output may alias either input
+inline a3i32 a3matrixProductTransform(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR)
+{
+	if (m_out && mL && mR)
+	{
+#if (defined A3_MATRIXBATCH_AVX)
+		// right w elements are 0 except the last, which adds left column 3
+		const __m256 l0 = _mm256_broadcast_ps((__m128 const *)(mL->mm + 0)), l1 = _mm256_broadcast_ps((__m128 const *)(mL->mm + 4));
+		const __m256 l2 = _mm256_broadcast_ps((__m128 const *)(mL->mm + 8));
+		const __m256 l3 = _mm256_insertf128_ps(_mm256_setzero_ps(), _mm_loadu_ps(mL->mm + 12), 1);
+		const __m256 r01 = _mm256_loadu_ps(mR->mm + 0), r23 = _mm256_loadu_ps(mR->mm + 8);
+		const __m256 o01 = _mm256_add_ps(
+			_mm256_add_ps(_mm256_mul_ps(l0, _mm256_shuffle_ps(r01, r01, 0x00)), _mm256_mul_ps(l1, _mm256_shuffle_ps(r01, r01, 0x55))),
+			_mm256_mul_ps(l2, _mm256_shuffle_ps(r01, r01, 0xaa)));
+		const __m256 o23 = _mm256_add_ps(
+			_mm256_add_ps(_mm256_mul_ps(l0, _mm256_shuffle_ps(r23, r23, 0x00)), _mm256_mul_ps(l1, _mm256_shuffle_ps(r23, r23, 0x55))),
+			_mm256_add_ps(_mm256_mul_ps(l2, _mm256_shuffle_ps(r23, r23, 0xaa)), l3));
+		_mm256_storeu_ps(m_out->mm + 0, o01);
+		_mm256_storeu_ps(m_out->mm + 8, o23);
+#elif (defined A3_MATRIXBATCH_SSE)
+		const __m128 l0 = _mm_loadu_ps(mL->mm + 0), l1 = _mm_loadu_ps(mL->mm + 4), l2 = _mm_loadu_ps(mL->mm + 8), l3 = _mm_loadu_ps(mL->mm + 12);
+		__m128 o[4], r;
+		a3ui32 j;
+		for (j = 0; j < 4; ++j)
+		{
+			r = _mm_loadu_ps(mR->mm + j * 4);
+			o[j] = _mm_add_ps(
+				_mm_add_ps(_mm_mul_ps(l0, _mm_shuffle_ps(r, r, 0x00)), _mm_mul_ps(l1, _mm_shuffle_ps(r, r, 0x55))),
+				_mm_mul_ps(l2, _mm_shuffle_ps(r, r, 0xaa)));
+		}
+		o[3] = _mm_add_ps(o[3], l3);
+		for (j = 0; j < 4; ++j)
+			_mm_storeu_ps(m_out->mm + j * 4, o[j]);
+#else	// scalar
+		a3mat4 tmp;
+		a3real4x4ProductTransform(tmp.m, mL->m, mR->m);
+		*m_out = tmp;
+#endif	// SIMD
+		return 1;
+	}
+	return -1;
+}
+
+// inverse of affine transform with any scale; output may alias input
+inline a3i32 a3matrixTransformInverse(a3mat4 *m_out, const a3mat4 *m)
+{
+	if (m_out && m)
+	{
+#if (defined A3_MATRIXBATCH_SSE)
+		// rows of the inverse basis are cross products of the basis columns 
+		//	divided by the determinant; transpose them back into columns, 
+		//	then the translation is the negated inverse basis times the old
+		const __m128 xyz = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		const __m128 a = _mm_and_ps(_mm_loadu_ps(m->mm + 0), xyz), b = _mm_and_ps(_mm_loadu_ps(m->mm + 4), xyz), c = _mm_and_ps(_mm_loadu_ps(m->mm + 8), xyz);
+		const __m128 t = _mm_loadu_ps(m->mm + 12);
+		const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1)), b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1)), c_yzx = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+		__m128 r0 = _mm_sub_ps(_mm_mul_ps(b, c_yzx), _mm_mul_ps(b_yzx, c));
+		__m128 r1 = _mm_sub_ps(_mm_mul_ps(c, a_yzx), _mm_mul_ps(c_yzx, a));
+		__m128 r2 = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+		__m128 r3 = _mm_setzero_ps(), d;
+
+		// crosses above are rotated to zxy order; rotate back to xyz
+		r0 = _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 0, 2, 1));
+		r1 = _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 0, 2, 1));
+		r2 = _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 0, 2, 1));
+
+		// determinant splat to all lanes
+		d = _mm_mul_ps(a, r0);
+		d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)));
+		d = _mm_add_ps(d, _mm_shuffle_ps(d, d, _MM_SHUFFLE(1, 0, 3, 2)));
+		d = _mm_div_ps(_mm_set1_ps(1.0f), d);
+		r0 = _mm_mul_ps(r0, d);
+		r1 = _mm_mul_ps(r1, d);
+		r2 = _mm_mul_ps(r2, d);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+		r3 = _mm_sub_ps(_mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f), _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(r0, _mm_shuffle_ps(t, t, 0x00)), _mm_mul_ps(r1, _mm_shuffle_ps(t, t, 0x55))),
+			_mm_mul_ps(r2, _mm_shuffle_ps(t, t, 0xaa))));
+		_mm_storeu_ps(m_out->mm + 0, r0);
+		_mm_storeu_ps(m_out->mm + 4, r1);
+		_mm_storeu_ps(m_out->mm + 8, r2);
+		_mm_storeu_ps(m_out->mm + 12, r3);
+#else	// scalar
+		a3mat4 tmp;
+		a3real4x4TransformInverse(tmp.m, m->m);
+		*m_out = tmp;
+#endif	// SIMD
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_MATRIXBATCH_INL
+#endif	// __ANIMAL3D_MATRIXBATCH_H
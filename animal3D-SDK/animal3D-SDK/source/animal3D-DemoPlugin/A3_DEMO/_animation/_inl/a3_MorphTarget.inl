@@ -0,0 +1,46 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_MorphTarget.inl
+	Implementation of inline morph target operations.
+*/
+
+
+#ifdef __ANIMAL3D_MORPHTARGET_H
+#ifndef __ANIMAL3D_MORPHTARGET_INL
+#define __ANIMAL3D_MORPHTARGET_INL
+
+
+//-----------------------------------------------------------------------------
+
+// get number of rows needed for the data texture
+inline a3ui32 a3morphTargetGetTextureHeight(const a3_MorphTargetSet *set, const a3ui32 width)
+{
+	if (set && set->data && width)
+		return (set->numVertices + set->numEntries * 3 + width - 1) / width;
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_MORPHTARGET_INL
+#endif	// __ANIMAL3D_MORPHTARGET_H
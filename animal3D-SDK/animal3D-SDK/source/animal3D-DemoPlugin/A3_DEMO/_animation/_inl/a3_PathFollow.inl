@@ -0,0 +1,54 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_PathFollow.inl
+	Implementation of inline path operations.
+*/
+
+
+#ifdef __ANIMAL3D_PATHFOLLOW_H
+#ifndef __ANIMAL3D_PATHFOLLOW_INL
+#define __ANIMAL3D_PATHFOLLOW_INL
+
+
+//-----------------------------------------------------------------------------
+
+// get total length of path
+inline a3real a3pathGetLength(const a3_Path *path)
+{
+	if (path && path->data)
+		return path->length;
+	return a3real_zero;
+}
+
+// move cursor by a (signed) distance and evaluate; returns segment index
+inline a3i32 a3pathCursorAdvance(a3_PathCursor *cursor, const a3real delta, a3real3p position_out, a3real3p direction_out_opt)
+{
+	if (cursor)
+		return a3pathCursorSetDistance(cursor, cursor->distance + delta, position_out, direction_out_opt);
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_PATHFOLLOW_INL
+#endif	// __ANIMAL3D_PATHFOLLOW_H
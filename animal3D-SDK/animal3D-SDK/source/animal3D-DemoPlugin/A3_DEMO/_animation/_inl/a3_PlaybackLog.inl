@@ -0,0 +1,65 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_PlaybackLog.inl
+	Implementation of inline playback log operations.
+*/
+
+
+#ifdef __ANIMAL3D_PLAYBACKLOG_H
+#ifndef __ANIMAL3D_PLAYBACKLOG_INL
+#define __ANIMAL3D_PLAYBACKLOG_INL
+
+
+//-----------------------------------------------------------------------------
+
+// reset replay position to first event
+inline a3i32 a3playbackLogRewind(a3_PlaybackLog *log)
+{
+	if (log && log->event)
+	{
+		const a3ui32 cursor = log->cursor;
+		log->cursor = 0;
+		return cursor;
+	}
+	return -1;
+}
+
+// get next event in replay; returns 1 if event, 0 if done
+inline a3i32 a3playbackLogReplayEvent(a3_PlaybackLog *log, a3_PlaybackEvent *event_out)
+{
+	if (log && log->event && event_out)
+	{
+		if (log->cursor < log->count)
+		{
+			*event_out = log->event[log->cursor++];
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_PLAYBACKLOG_INL
+#endif	// __ANIMAL3D_PLAYBACKLOG_H
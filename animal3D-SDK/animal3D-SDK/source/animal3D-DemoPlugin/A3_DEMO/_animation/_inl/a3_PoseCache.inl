@@ -0,0 +1,62 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_PoseCache.inl
+	Implementation of inline pose cache operations.
+*/
+
+
+#ifdef __ANIMAL3D_POSECACHE_H
+#ifndef __ANIMAL3D_POSECACHE_INL
+#define __ANIMAL3D_POSECACHE_INL
+
+
+//-----------------------------------------------------------------------------
+
+// convert sample time to ticks
+inline a3i32 a3poseCacheQuantizeTime(const a3_PoseCache *cache, const a3real time)
+{
+	if (cache)
+	{
+		const a3real t = time * cache->ticksPerSecond;
+		return (a3i32)(t >= a3real_zero ? t + a3real_half : t - a3real_half);
+	}
+	return 0;
+}
+
+// make key
+inline a3i32 a3poseCacheKeyInit(a3_PoseCacheKey *key_out, const a3_HierarchyPoseGroup *poseGroup, const a3ui32 clipIndex, const a3i32 timeTick)
+{
+	if (key_out && poseGroup)
+	{
+		key_out->poseGroup = poseGroup;
+		key_out->clipIndex = clipIndex;
+		key_out->timeTick = timeTick;
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_POSECACHE_INL
+#endif	// __ANIMAL3D_POSECACHE_H
@@ -0,0 +1,53 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_QuaternionBatch.inl
+	Implementation of inline batch quaternion operations.
+*/
+
+
+#ifdef __ANIMAL3D_QUATERNIONBATCH_H
+#ifndef __ANIMAL3D_QUATERNIONBATCH_INL
+#define __ANIMAL3D_QUATERNIONBATCH_INL
+
+
+//-----------------------------------------------------------------------------
+
+// nlerp parameter correction for the absolute cosine of the angle between 
+//	two unit quaternions; keeps the error against slerp well under 0.001
+// nlerp moves too slowly near the ends and too fast in the middle; the 
+//	cubic term pushes the parameter toward the ends by an amount fitted 
+//	over the full range of angles
+inline a3real a3quatBatchCorrectParam(const a3real cosAngle, const a3real u)
+{
+	const a3real d = cosAngle;
+	const a3real a = (a3real)1.0904 + d * ((a3real)-3.2452 + d * ((a3real)3.55645 - d * (a3real)1.43519));
+	const a3real b = (a3real)0.848013 + d * ((a3real)-1.06021 + d * (a3real)0.215638);
+	const a3real h = u - a3real_half;
+	const a3real k = a * h * h + b;
+	return (u + u * h * (u - a3real_one) * k);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_QUATERNIONBATCH_INL
+#endif	// __ANIMAL3D_QUATERNIONBATCH_H
@@ -0,0 +1,46 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_Retarget.inl
+	Implementation of inline retargeting operations.
+*/
+
+
+#ifdef __ANIMAL3D_RETARGET_H
+#ifndef __ANIMAL3D_RETARGET_INL
+#define __ANIMAL3D_RETARGET_INL
+
+
+//-----------------------------------------------------------------------------
+
+// get source node index mapped to target node
+inline a3i32 a3retargetMapGetSourceIndex(const a3_RetargetMap *map, const a3ui32 targetIndex)
+{
+	if (map && map->sourceIndex && targetIndex < map->target->numNodes)
+		return map->sourceIndex[targetIndex];
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_RETARGET_INL
+#endif	// __ANIMAL3D_RETARGET_H
@@ -0,0 +1,46 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_SkinWeights.inl
+	Implementation of inline skin weight operations.
+*/
+
+
+#ifdef __ANIMAL3D_SKINWEIGHTS_H
+#ifndef __ANIMAL3D_SKINWEIGHTS_INL
+#define __ANIMAL3D_SKINWEIGHTS_INL
+
+
+//-----------------------------------------------------------------------------
+
+// get weight of slot for vertex as real
+inline a3real a3skinWeightsGetWeight(const a3_SkinWeights *weights, const a3ui32 vertexIndex, const a3ui32 slot)
+{
+	if (weights && weights->weight && vertexIndex < weights->numVertices && slot < a3skinWeights_influenceMax)
+		return ((a3real)weights->weight[vertexIndex * a3skinWeights_influenceMax + slot] / (a3real)255);
+	return a3real_zero;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_SKINWEIGHTS_INL
+#endif	// __ANIMAL3D_SKINWEIGHTS_H
@@ -0,0 +1,69 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_Skinning.inl
+	Implementation of inline skinning operations.
+*/
+
+
+#ifdef __ANIMAL3D_SKINNING_H
+#ifndef __ANIMAL3D_SKINNING_INL
+#define __ANIMAL3D_SKINNING_INL
+
+
+//-----------------------------------------------------------------------------
+
+// rotate vector by unit dual quaternion: v' = v + 2r x (r x v + w v)
+inline a3real *a3skinningDualQuatRotateVector(a3real *v_out, const a3dualquat *dq, const a3real *v)
+{
+	const a3real
+		cx = dq->ry * v[2] - dq->rz * v[1] + dq->rw * v[0],
+		cy = dq->rz * v[0] - dq->rx * v[2] + dq->rw * v[1],
+		cz = dq->rx * v[1] - dq->ry * v[0] + dq->rw * v[2],
+		x = v[0] + a3real_two * (dq->ry * cz - dq->rz * cy),
+		y = v[1] + a3real_two * (dq->rz * cx - dq->rx * cz),
+		z = v[2] + a3real_two * (dq->rx * cy - dq->ry * cx);
+	v_out[0] = x;
+	v_out[1] = y;
+	v_out[2] = z;
+	return v_out;
+}
+
+// transform point by unit dual quaternion: rotate, then add the 
+//	translation decoded from the dual part, t = 2 d r*
+inline a3real *a3skinningDualQuatTransformPoint(a3real *p_out, const a3dualquat *dq, const a3real *p)
+{
+	const a3real
+		tx = a3real_two * (dq->rw * dq->dx - dq->dw * dq->rx + dq->ry * dq->dz - dq->rz * dq->dy),
+		ty = a3real_two * (dq->rw * dq->dy - dq->dw * dq->ry + dq->rz * dq->dx - dq->rx * dq->dz),
+		tz = a3real_two * (dq->rw * dq->dz - dq->dw * dq->rz + dq->rx * dq->dy - dq->ry * dq->dx);
+	a3skinningDualQuatRotateVector(p_out, dq, p);
+	p_out[0] += tx;
+	p_out[1] += ty;
+	p_out[2] += tz;
+	return p_out;
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_SKINNING_INL
+#endif	// __ANIMAL3D_SKINNING_H
@@ -30,6 +30,24 @@
 
 //-----------------------------------------------------------------------------
 
+// reset a range of SoA poses to identity
+inline a3i32 a3spatialPoseSoAReset(a3_SpatialPoseSoA const *pose, const a3ui32 first, const a3ui32 count)
+{
+	if (pose && pose->data && first + count <= pose->count)
+	{
+		a3ui32 i;
+		const a3ui32 end = first + count;
+		for (i = first; i < end; ++i)
+		{
+			pose->orientation[0][i] = pose->orientation[1][i] = pose->orientation[2][i] = a3real_zero;
+			pose->orientation[3][i] = a3real_one;
+			pose->translation[0][i] = pose->translation[1][i] = pose->translation[2][i] = a3real_zero;
+			pose->scale[0][i] = pose->scale[1][i] = pose->scale[2][i] = a3real_one;
+		}
+		return count;
+	}
+	return -1;
+}
 
 
 //-----------------------------------------------------------------------------
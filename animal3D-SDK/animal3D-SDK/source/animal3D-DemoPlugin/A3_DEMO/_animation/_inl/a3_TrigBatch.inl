@@ -0,0 +1,110 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_TrigBatch.inl
+	Implementation of inline polynomial trig functions.
+*/
+
+
+#ifdef __ANIMAL3D_TRIGBATCH_H
+#ifndef __ANIMAL3D_TRIGBATCH_INL
+#define __ANIMAL3D_TRIGBATCH_INL
+
+
+//-----------------------------------------------------------------------------
+
+// sine and cosine reduce the angle by the nearest multiple of pi/2, with 
+//	pi/2 split in three parts so the reduction is exact for large k; the 
+//	reduced angle in [-pi/4, +pi/4] feeds minimax polynomials
+#define a3trigBatchInternalTwoOverPi	((a3real)0.636619772367581343)
+#define a3trigBatchInternalHalfPi0		((a3real)1.5703125)
+#define a3trigBatchInternalHalfPi1		((a3real)4.837512969970703125e-4)
+#define a3trigBatchInternalHalfPi2		((a3real)7.54978995489188216e-8)
+#define a3trigBatchInternalSin3			((a3real)-1.6666654611e-1)
+#define a3trigBatchInternalSin5			((a3real)8.3321608736e-3)
+#define a3trigBatchInternalSin7			((a3real)-1.9515295891e-4)
+#define a3trigBatchInternalCos4			((a3real)4.166664568298827e-2)
+#define a3trigBatchInternalCos6			((a3real)-1.388731625493765e-3)
+#define a3trigBatchInternalCos8			((a3real)2.443315711809948e-5)
+
+// arctangent reduces the ratio to [0, 1] by octant symmetry, then to 
+//	[-tan(pi/8), +tan(pi/8)] by the identity atan(a) = pi/4 + atan((a-1)/(a+1))
+#define a3trigBatchInternalTanPi8		((a3real)0.414213562373095049)
+#define a3trigBatchInternalQuarterPi	((a3real)0.785398163397448310)
+#define a3trigBatchInternalHalfPi		((a3real)1.57079632679489662)
+#define a3trigBatchInternalPi			((a3real)3.14159265358979324)
+#define a3trigBatchInternalAtan3		((a3real)-3.33329491539e-1)
+#define a3trigBatchInternalAtan5		((a3real)1.99777106478e-1)
+#define a3trigBatchInternalAtan7		((a3real)-1.38776856032e-1)
+#define a3trigBatchInternalAtan9		((a3real)8.05374449538e-2)
+
+
+//-----------------------------------------------------------------------------
+
+// sine and cosine of one angle
+inline void a3trigBatchSinCosrScalar(a3real *sin_out, a3real *cos_out, const a3real x)
+{
+	const a3real kf = x * a3trigBatchInternalTwoOverPi;
+	const a3i32 k = (a3i32)(kf < a3real_zero ? kf - a3real_half : kf + a3real_half);
+	const a3real r = ((x - (a3real)k * a3trigBatchInternalHalfPi0) - (a3real)k * a3trigBatchInternalHalfPi1) - (a3real)k * a3trigBatchInternalHalfPi2;
+	const a3real r2 = r * r;
+	const a3real s = r + r * r2 * (a3trigBatchInternalSin3 + r2 * (a3trigBatchInternalSin5 + r2 * a3trigBatchInternalSin7));
+	const a3real c = a3real_one - a3real_half * r2 + r2 * r2 * (a3trigBatchInternalCos4 + r2 * (a3trigBatchInternalCos6 + r2 * a3trigBatchInternalCos8));
+
+	// quadrant: sin(r + k pi/2) cycles through s, c, -s, -c
+	switch (k & 3)
+	{
+	case 0:	*sin_out = +s;	*cos_out = +c;	break;
+	case 1:	*sin_out = +c;	*cos_out = -s;	break;
+	case 2:	*sin_out = -s;	*cos_out = -c;	break;
+	case 3:	*sin_out = -c;	*cos_out = +s;	break;
+	}
+}
+
+// arctangent of y/x in [-pi, +pi] using the signs of both to pick the quadrant
+inline a3real a3trigBatchAtan2rScalar(const a3real y, const a3real x)
+{
+	const a3real ax = x < a3real_zero ? -x : x, ay = y < a3real_zero ? -y : y;
+	const a3real lo = ax < ay ? ax : ay, hi = ax < ay ? ay : ax;
+	a3real a = hi > a3real_zero ? lo / hi : a3real_zero, a2, r = a3real_zero;
+
+	// octant reduction
+	if (a > a3trigBatchInternalTanPi8)
+	{
+		a = (a - a3real_one) / (a + a3real_one);
+		r = a3trigBatchInternalQuarterPi;
+	}
+	a2 = a * a;
+	r += a + a * a2 * (a3trigBatchInternalAtan3 + a2 * (a3trigBatchInternalAtan5 + a2 * (a3trigBatchInternalAtan7 + a2 * a3trigBatchInternalAtan9)));
+
+	// undo symmetry
+	if (ay > ax)
+		r = a3trigBatchInternalHalfPi - r;
+	if (x < a3real_zero)
+		r = a3trigBatchInternalPi - r;
+	return (y < a3real_zero ? -r : r);
+}
+
+
+//-----------------------------------------------------------------------------
+
+
+#endif	// !__ANIMAL3D_TRIGBATCH_INL
+#endif	// __ANIMAL3D_TRIGBATCH_H
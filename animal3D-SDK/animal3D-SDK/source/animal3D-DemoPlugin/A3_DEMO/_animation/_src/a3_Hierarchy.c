@@ -69,11 +69,11 @@ a3ret a3hierarchyCreate(a3_Hierarchy *hierarchy_out, const a3ui32 numNodes, cons
 			if (names_opt)
 			{
 				for (i = 0; i < numNodes; ++i)
-					if (tmpName = *(names_opt + i))
+					if ((tmpName = *(names_opt + i)))
 					{
 						if (a3hierarchyInternalGetIndex(hierarchy_out, tmpName) < 0)
 						{
-							strncpy(hierarchy_out->nodes[i].name, tmpName, a3node_nameSize);
+							strncpy(hierarchy_out->nodes[i].name, tmpName, a3node_nameSize - 1);
 							hierarchy_out->nodes[i].name[a3node_nameSize - 1] = 0;
 						}
 						else
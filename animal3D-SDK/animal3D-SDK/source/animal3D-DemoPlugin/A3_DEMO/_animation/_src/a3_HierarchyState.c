@@ -24,6 +24,9 @@
 
 #include "../a3_HierarchyState.h"
 
+#include "../a3_QuaternionBatch.h"
+
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -33,12 +36,204 @@
 // initialize pose set given an initialized hierarchy and key pose count
 a3i32 a3hierarchyPoseGroupCreate(a3_HierarchyPoseGroup *poseGroup_out, const a3_Hierarchy *hierarchy, const a3ui32 poseCount)
 {
+	if (poseGroup_out && !poseGroup_out->hierarchy && hierarchy && hierarchy->nodes && poseCount)
+	{
+		memset(&poseGroup_out->pose, 0, sizeof(a3_SpatialPoseSoA));
+		if (a3spatialPoseSoACreate(&poseGroup_out->pose, poseCount * hierarchy->numNodes) > 0)
+		{
+			poseGroup_out->hierarchy = hierarchy;
+			poseGroup_out->poseCount = poseCount;
+			return poseCount;
+		}
+	}
 	return -1;
 }
 
 // release pose set
 a3i32 a3hierarchyPoseGroupRelease(a3_HierarchyPoseGroup *poseGroup)
 {
+	if (poseGroup && poseGroup->hierarchy)
+	{
+		a3spatialPoseSoARelease(&poseGroup->pose);
+		poseGroup->hierarchy = 0;
+		poseGroup->poseCount = 0;
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// HTR sections in file order
+enum a3_HierarchyInternalHTRSection
+{
+	a3htr_none,
+	a3htr_header,
+	a3htr_hierarchy,
+	a3htr_base,
+	a3htr_frames,
+};
+
+
+// read next line that is not a comment or blank; strips line break
+inline a3byte *a3hierarchyInternalHTRLine(a3byte *line, const a3ui32 lineSize, FILE *fp)
+{
+	a3byte *end;
+	while (fgets(line, lineSize, fp))
+	{
+		for (end = line + strlen(line); end > line && (end[-1] == '\n' || end[-1] == '\r'); *(--end) = 0);
+		if (*line && *line != '#')
+			return line;
+	}
+	return 0;
+}
+
+// store HTR Euler angles in degrees in the orientation streams; the whole 
+//	pose group is converted to quaternions once the file is read
+inline void a3hierarchyInternalHTRRotation(a3_SpatialPoseSoA const *pose, const a3ui32 index, a3real rx, a3real ry, a3real rz, const a3boolean radians)
+{
+	if (radians)
+	{
+		rx *= a3real_rad2deg;
+		ry *= a3real_rad2deg;
+		rz *= a3real_rad2deg;
+	}
+	pose->orientation[0][index] = rx;
+	pose->orientation[1][index] = ry;
+	pose->orientation[2][index] = rz;
+}
+
+// load hierarchy and pose group from HTR file; pose 0 is the base pose and 
+//	each frame follows as a full local pose; optionally get frame rate
+a3i32 a3hierarchyPoseGroupLoadHTR(a3_HierarchyPoseGroup *poseGroup_out, a3_Hierarchy *hierarchy_out, const a3byte *resourceFilePath, a3real *frameRate_out_opt)
+{
+	if (poseGroup_out && !poseGroup_out->hierarchy && hierarchy_out && !hierarchy_out->nodes && resourceFilePath && *resourceFilePath)
+	{
+		FILE *fp = fopen(resourceFilePath, "r");
+		a3byte line[256], name[a3node_nameSize], parentName[a3node_nameSize], key[64], value[64];
+		a3ui32 numSegments = 0, numFrames = 0, numSet = 0, frame = 0, i;
+		a3i32 section = a3htr_none, nodeIndex = -1, parentIndex;
+		a3boolean orderZYX = a3true, radians = a3false;
+		a3real frameRate = a3real_zero, scaleFactor = a3real_one;
+		float tx, ty, tz, rx, ry, rz, s;
+
+		if (!fp)
+		{
+			printf("\n A3 Warning: Could not open HTR file \'%s\'.", resourceFilePath);
+			return 0;
+		}
+
+		while (a3hierarchyInternalHTRLine(line, sizeof(line), fp))
+		{
+			// section change
+			if (*line == '[')
+			{
+				if (!strncmp(line, "[Header]", 8))
+					section = a3htr_header;
+				else if (!strncmp(line, "[SegmentNames&Hierarchy]", 24))
+				{
+					// hierarchy can be allocated once header is read
+					if (!numSegments || a3hierarchyCreate(hierarchy_out, numSegments, 0) <= 0)
+						break;
+					section = a3htr_hierarchy;
+				}
+				else if (!strncmp(line, "[BasePosition]", 14))
+				{
+					if (a3hierarchyPoseGroupCreate(poseGroup_out, hierarchy_out, numFrames + 1) <= 0)
+						break;
+					section = a3htr_base;
+				}
+				else if (section == a3htr_base || section == a3htr_frames)
+				{
+					// node frame section: "[name]"
+					sscanf(line, "[%31[^]]", name);
+					nodeIndex = a3hierarchyGetNodeIndex(hierarchy_out, name);
+					frame = 0;
+					section = a3htr_frames;
+				}
+				continue;
+			}
+
+			switch (section)
+			{
+			case a3htr_header:
+				if (sscanf(line, "%63s %63s", key, value) == 2)
+				{
+					if (!strcmp(key, "NumSegments"))
+						numSegments = (a3ui32)atoi(value);
+					else if (!strcmp(key, "NumFrames"))
+						numFrames = (a3ui32)atoi(value);
+					else if (!strcmp(key, "DataFrameRate"))
+						frameRate = (a3real)atof(value);
+					else if (!strcmp(key, "EulerRotationOrder"))
+						orderZYX = !strcmp(value, "ZYX");
+					else if (!strcmp(key, "RotationUnits"))
+						radians = !strcmp(value, "Radians");
+					else if (!strcmp(key, "ScaleFactor"))
+						scaleFactor = (a3real)atof(value);
+				}
+				break;
+			case a3htr_hierarchy:
+				// parents must precede children
+				if (sscanf(line, "%31s %31s", name, parentName) == 2 && numSet < numSegments)
+				{
+					parentIndex = strcmp(parentName, "GLOBAL") ? a3hierarchyGetNodeIndex(hierarchy_out, parentName) : -1;
+					a3hierarchySetNode(hierarchy_out, numSet++, parentIndex, name);
+				}
+				break;
+			case a3htr_base:
+				if (sscanf(line, "%31s %f %f %f %f %f %f", name, &tx, &ty, &tz, &rx, &ry, &rz) == 7 &&
+					(nodeIndex = a3hierarchyGetNodeIndex(hierarchy_out, name)) >= 0)
+				{
+					a3hierarchyInternalHTRRotation(&poseGroup_out->pose, nodeIndex, rx, ry, rz, radians);
+					poseGroup_out->pose.translation[0][nodeIndex] = tx * scaleFactor;
+					poseGroup_out->pose.translation[1][nodeIndex] = ty * scaleFactor;
+					poseGroup_out->pose.translation[2][nodeIndex] = tz * scaleFactor;
+				}
+				break;
+			case a3htr_frames:
+				// frame values are relative to base: rotation concatenates 
+				//	(after conversion), translation adds and scale factor replaces
+				if (nodeIndex >= 0 && frame < numFrames &&
+					sscanf(line, "%*d %f %f %f %f %f %f %f", &tx, &ty, &tz, &rx, &ry, &rz, &s) == 7)
+				{
+					const a3ui32 base = nodeIndex, index = (++frame) * hierarchy_out->numNodes + nodeIndex;
+					a3hierarchyInternalHTRRotation(&poseGroup_out->pose, index, rx, ry, rz, radians);
+					poseGroup_out->pose.translation[0][index] = poseGroup_out->pose.translation[0][base] + tx * scaleFactor;
+					poseGroup_out->pose.translation[1][index] = poseGroup_out->pose.translation[1][base] + ty * scaleFactor;
+					poseGroup_out->pose.translation[2][index] = poseGroup_out->pose.translation[2][base] + tz * scaleFactor;
+					poseGroup_out->pose.scale[0][index] = poseGroup_out->pose.scale[1][index] = poseGroup_out->pose.scale[2][index] = s;
+				}
+				break;
+			}
+		}
+		fclose(fp);
+
+		// convert all rotations in one pass, then concatenate frames to base
+		if (poseGroup_out->hierarchy)
+		{
+			const a3real *const *q = (const a3real *const *)poseGroup_out->pose.orientation;
+			const a3ui32 numNodes = hierarchy_out->numNodes;
+			a3real *qFrame[4];
+			a3quatBatchSetEuler(poseGroup_out->pose.orientation, q, poseGroup_out->pose.count, orderZYX);
+			for (frame = 1; frame < poseGroup_out->poseCount; ++frame)
+			{
+				for (i = 0; i < 4; ++i)
+					qFrame[i] = poseGroup_out->pose.orientation[i] + frame * numNodes;
+				a3quatBatchProduct(qFrame, q, (const a3real *const *)qFrame, numNodes);
+			}
+		}
+
+		if (frameRate_out_opt)
+			*frameRate_out_opt = frameRate;
+		if (poseGroup_out->hierarchy)
+			return poseGroup_out->poseCount;
+		printf("\n A3 Warning: Invalid HTR file \'%s\'.", resourceFilePath);
+		if (hierarchy_out->nodes)
+			a3hierarchyRelease(hierarchy_out);
+		return 0;
+	}
 	return -1;
 }
 
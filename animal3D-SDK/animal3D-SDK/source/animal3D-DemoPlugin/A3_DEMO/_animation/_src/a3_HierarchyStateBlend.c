@@ -24,9 +24,223 @@
 
 #include "../a3_HierarchyStateBlend.h"
 
+#include "../a3_QuaternionBatch.h"
+
 
 //-----------------------------------------------------------------------------
 
+// SSE is used when reals are single precision and the target has SSE2
+//	(always the case on x64)
+#if ((defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__) && !(defined A3_REAL_F64 || defined A3_REAL_F128))
+#define A3_HIERARCHYSTATEBLEND_SSE
+#include <emmintrin.h>
+#endif	// SSE2
+
+
+// cubic sources are four poses combined with one weight each; quaternion 
+//	sources are sign-aligned to their neighbors before combining
+enum a3_SpatialPoseCubicMode
+{
+	a3poseCubic_CatmullRom,	// sources: prev, 0, 1, next
+	a3poseCubic_Hermite,	// sources: 0, 1, tangent 0, tangent 1
+};
+
+
+// weighted sum of four poses per node, then normalize orientation
+// all weights are shared by every node, so four nodes are done per step 
+//	in SIMD; each channel component is its own contiguous stream
+inline void a3spatialPoseInternalCubic(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_SpatialPoseSoA *const src[4], const a3ui32 first[4], const a3ui32 count, const a3real w[4], const enum a3_SpatialPoseCubicMode mode)
+{
+	const a3real *q[4][4], *v[4][6];
+	a3real *qo[4], *vo[6];
+	a3real d, len, sgn[4];
+	a3ui32 i = 0, j, k;
+
+	for (k = 0; k < 4; ++k)
+	{
+		for (j = 0; j < 4; ++j)
+			q[k][j] = src[k]->orientation[j] + first[k];
+		for (j = 0; j < 3; ++j)
+		{
+			v[k][j] = src[k]->translation[j] + first[k];
+			v[k][j + 3] = src[k]->scale[j] + first[k];
+		}
+	}
+	for (j = 0; j < 4; ++j)
+		qo[j] = pose_out->orientation[j] + first_out;
+	for (j = 0; j < 3; ++j)
+	{
+		vo[j] = pose_out->translation[j] + first_out;
+		vo[j + 3] = pose_out->scale[j] + first_out;
+	}
+
+#ifdef A3_HIERARCHYSTATEBLEND_SSE
+	{
+		const __m128 zero = _mm_setzero_ps(), signBit = _mm_set1_ps(-0.0f);
+		const __m128 w0 = _mm_set1_ps(w[0]), w1 = _mm_set1_ps(w[1]), w2 = _mm_set1_ps(w[2]), w3 = _mm_set1_ps(w[3]);
+		__m128 x[4][4], m[4], r[4], l, y;
+
+		for (; i + 4 <= count; i += 4)
+		{
+			for (k = 0; k < 4; ++k)
+				for (j = 0; j < 4; ++j)
+					x[k][j] = _mm_loadu_ps(q[k][j] + i);
+
+			// sign masks: flip a source when it is on the far hemisphere 
+			//	of the neighbor it is aligned to
+#define a3poseInternalDotSign(a, b)	_mm_and_ps(_mm_cmplt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_add_ps(_mm_mul_ps(a[2], b[2]), _mm_mul_ps(a[3], b[3]))), zero), signBit)
+			if (mode == a3poseCubic_CatmullRom)
+			{
+				m[0] = a3poseInternalDotSign(x[0], x[1]);
+				m[1] = zero;
+				m[2] = a3poseInternalDotSign(x[2], x[1]);
+				m[3] = _mm_xor_ps(m[2], a3poseInternalDotSign(x[3], x[2]));
+			}
+			else
+			{
+				m[0] = m[2] = zero;
+				m[1] = m[3] = a3poseInternalDotSign(x[1], x[0]);
+			}
+#undef a3poseInternalDotSign
+
+			for (j = 0; j < 4; ++j)
+				r[j] = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_xor_ps(x[0][j], m[0]), w0), _mm_mul_ps(_mm_xor_ps(x[1][j], m[1]), w1)),
+					_mm_add_ps(_mm_mul_ps(_mm_xor_ps(x[2][j], m[2]), w2), _mm_mul_ps(_mm_xor_ps(x[3][j], m[3]), w3)));
+
+			// normalize; degenerate results are zeroed like the scalar path
+			l = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r[0], r[0]), _mm_mul_ps(r[1], r[1])), _mm_add_ps(_mm_mul_ps(r[2], r[2]), _mm_mul_ps(r[3], r[3])));
+			l = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(l)), _mm_cmpgt_ps(l, zero));
+			for (j = 0; j < 4; ++j)
+				_mm_storeu_ps(qo[j] + i, _mm_mul_ps(r[j], l));
+
+			for (j = 0; j < 6; ++j)
+			{
+				y = _mm_add_ps(
+					_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(v[0][j] + i), w0), _mm_mul_ps(_mm_loadu_ps(v[1][j] + i), w1)),
+					_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(v[2][j] + i), w2), _mm_mul_ps(_mm_loadu_ps(v[3][j] + i), w3)));
+				_mm_storeu_ps(vo[j] + i, y);
+			}
+		}
+	}
+#endif	// A3_HIERARCHYSTATEBLEND_SSE
+
+	// remaining nodes
+	for (; i < count; ++i)
+	{
+#define a3poseInternalDot(a, b)	(q[a][0][i] * q[b][0][i] + q[a][1][i] * q[b][1][i] + q[a][2][i] * q[b][2][i] + q[a][3][i] * q[b][3][i])
+		if (mode == a3poseCubic_CatmullRom)
+		{
+			sgn[0] = a3poseInternalDot(0, 1) < a3real_zero ? -w[0] : w[0];
+			sgn[1] = w[1];
+			sgn[2] = a3poseInternalDot(2, 1) < a3real_zero ? -w[2] : w[2];
+			sgn[3] = (a3poseInternalDot(3, 2) < a3real_zero) != (sgn[2] < a3real_zero) ? -w[3] : w[3];
+		}
+		else
+		{
+			d = a3poseInternalDot(1, 0);
+			sgn[0] = w[0];
+			sgn[1] = d < a3real_zero ? -w[1] : w[1];
+			sgn[2] = w[2];
+			sgn[3] = d < a3real_zero ? -w[3] : w[3];
+		}
+#undef a3poseInternalDot
+		for (j = 0, len = a3real_zero; j < 4; ++j)
+		{
+			d = q[0][j][i] * sgn[0] + q[1][j][i] * sgn[1] + q[2][j][i] * sgn[2] + q[3][j][i] * sgn[3];
+			qo[j][i] = d;
+			len += d * d;
+		}
+		len = len > a3real_zero ? a3sqrtInverse(len) : a3real_zero;
+		for (j = 0; j < 4; ++j)
+			qo[j][i] *= len;
+
+		for (j = 0; j < 6; ++j)
+			vo[j][i] = v[0][j][i] * w[0] + v[1][j][i] * w[1] + v[2][j][i] * w[2] + v[3][j][i] * w[3];
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+
+// interpolate a range of SoA poses: orientation uses normalized lerp along 
+//	the shortest arc, translation and scale use lerp
+a3i32 a3spatialPoseSoALerp(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_SpatialPoseSoA *pose0, const a3ui32 first0, const a3_SpatialPoseSoA *pose1, const a3ui32 first1, const a3ui32 count, const a3real u)
+{
+	if (pose_out && pose_out->data && pose0 && pose0->data && pose1 && pose1->data &&
+		first_out + count <= pose_out->count && first0 + count <= pose0->count && first1 + count <= pose1->count)
+	{
+		a3real *const qo[4] = { pose_out->orientation[0] + first_out, pose_out->orientation[1] + first_out, pose_out->orientation[2] + first_out, pose_out->orientation[3] + first_out };
+		const a3real *const qa[4] = { pose0->orientation[0] + first0, pose0->orientation[1] + first0, pose0->orientation[2] + first0, pose0->orientation[3] + first0 };
+		const a3real *const qb[4] = { pose1->orientation[0] + first1, pose1->orientation[1] + first1, pose1->orientation[2] + first1, pose1->orientation[3] + first1 };
+		a3real *const *to = pose_out->translation, *const *so = pose_out->scale;
+		const a3real *const *ta = (const a3real *const *)pose0->translation, *const *sa = (const a3real *const *)pose0->scale;
+		const a3real *const *tb = (const a3real *const *)pose1->translation, *const *sb = (const a3real *const *)pose1->scale;
+		a3ui32 i, o, a, b;
+
+		a3quatBatchNlerp(qo, qa, qb, count, u);
+		for (i = 0, o = first_out, a = first0, b = first1; i < count; ++i, ++o, ++a, ++b)
+		{
+			to[0][o] = a3lerp(ta[0][a], tb[0][b], u);
+			to[1][o] = a3lerp(ta[1][a], tb[1][b], u);
+			to[2][o] = a3lerp(ta[2][a], tb[2][b], u);
+			so[0][o] = a3lerp(sa[0][a], sb[0][b], u);
+			so[1][o] = a3lerp(sa[1][a], sb[1][b], u);
+			so[2][o] = a3lerp(sa[2][a], sb[2][b], u);
+		}
+		return count;
+	}
+	return -1;
+}
+
+// interpolate a range of SoA poses with a Catmull-Rom spline through four 
+//	consecutive keys; orientation uses normalized cubic interpolation with 
+//	each key aligned to the hemisphere of the previous one
+a3i32 a3spatialPoseSoACatmullRom(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_SpatialPoseSoA *posePrev, const a3ui32 firstPrev, const a3_SpatialPoseSoA *pose0, const a3ui32 first0, const a3_SpatialPoseSoA *pose1, const a3ui32 first1, const a3_SpatialPoseSoA *poseNext, const a3ui32 firstNext, const a3ui32 count, const a3real u)
+{
+	if (pose_out && pose_out->data && posePrev && posePrev->data && pose0 && pose0->data && pose1 && pose1->data && poseNext && poseNext->data &&
+		first_out + count <= pose_out->count && firstPrev + count <= posePrev->count && first0 + count <= pose0->count && 
+		first1 + count <= pose1->count && firstNext + count <= poseNext->count)
+	{
+		const a3_SpatialPoseSoA *const src[4] = { posePrev, pose0, pose1, poseNext };
+		const a3ui32 first[4] = { firstPrev, first0, first1, firstNext };
+		const a3real u2 = u * u, u3 = u2 * u;
+		const a3real w[4] = {
+			a3real_half * (a3real_two * u2 - u3 - u),
+			a3real_half * (a3real_three * u3 - a3real_five * u2 + a3real_two),
+			a3real_half * (a3real_four * u2 - a3real_three * u3 + u),
+			a3real_half * (u3 - u2),
+		};
+		a3spatialPoseInternalCubic(pose_out, first_out, src, first, count, w, a3poseCubic_CatmullRom);
+		return count;
+	}
+	return -1;
+}
+
+// interpolate a range of SoA poses with a cubic Hermite spline given key 
+//	tangents (derivatives per unit parameter, stored as poses); orientation 
+//	uses normalized cubic interpolation with the second key and its 
+//	tangent aligned to the hemisphere of the first key
+a3i32 a3spatialPoseSoAHermite(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_SpatialPoseSoA *pose0, const a3ui32 first0, const a3_SpatialPoseSoA *pose1, const a3ui32 first1, const a3_SpatialPoseSoA *tangent0, const a3ui32 firstTangent0, const a3_SpatialPoseSoA *tangent1, const a3ui32 firstTangent1, const a3ui32 count, const a3real u)
+{
+	if (pose_out && pose_out->data && pose0 && pose0->data && pose1 && pose1->data && tangent0 && tangent0->data && tangent1 && tangent1->data &&
+		first_out + count <= pose_out->count && first0 + count <= pose0->count && first1 + count <= pose1->count && 
+		firstTangent0 + count <= tangent0->count && firstTangent1 + count <= tangent1->count)
+	{
+		const a3_SpatialPoseSoA *const src[4] = { pose0, pose1, tangent0, tangent1 };
+		const a3ui32 first[4] = { first0, first1, firstTangent0, firstTangent1 };
+		const a3real u2 = u * u, u3 = u2 * u;
+		const a3real w[4] = {
+			a3real_two * u3 - a3real_three * u2 + a3real_one,
+			a3real_three * u2 - a3real_two * u3,
+			u3 - a3real_two * u2 + u,
+			u3 - u2,
+		};
+		a3spatialPoseInternalCubic(pose_out, first_out, src, first, count, w, a3poseCubic_Hermite);
+		return count;
+	}
+	return -1;
+}
 
 
 //-----------------------------------------------------------------------------
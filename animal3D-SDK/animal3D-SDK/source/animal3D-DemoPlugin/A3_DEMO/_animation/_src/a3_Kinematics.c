@@ -24,6 +24,8 @@
 
 #include "../a3_Kinematics.h"
 
+#include "../a3_MatrixBatch.h"
+
 
 //-----------------------------------------------------------------------------
 
@@ -63,4 +65,163 @@ a3i32 a3kinematicsSolveInversePartial(const a3_HierarchyState *hierarchyState, c
 }
 
 
+//-----------------------------------------------------------------------------
+
+// forward kinematics from local SoA poses starting at 'first': converts 
+//	poses to local matrices and concatenates them to object-space
+a3i32 a3kinematicsSolveForwardSoA(const a3_Hierarchy *hierarchy, a3mat4 *objectMat_out, a3mat4 *localMat_out, const a3_SpatialPoseSoA *localPose, const a3ui32 first)
+{
+	if (hierarchy && hierarchy->nodes && objectMat_out && localMat_out &&
+		a3spatialPoseSoAConvert(localMat_out, localPose, first, hierarchy->numNodes) >= 0)
+	{
+		const a3_HierarchyNode *node = hierarchy->nodes;
+		a3ui32 i;
+		for (i = 0; i < hierarchy->numNodes; ++i, ++node)
+		{
+			if (node->parentIndex >= 0)
+				a3matrixProductTransform(objectMat_out + i, objectMat_out + node->parentIndex, localMat_out + i);
+			else
+				objectMat_out[i] = localMat_out[i];
+		}
+		return hierarchy->numNodes;
+	}
+	return -1;
+}
+
+// inverse kinematics from object-space matrices to local matrices
+a3i32 a3kinematicsSolveInverseMat(const a3_Hierarchy *hierarchy, a3mat4 *localMat_out, const a3mat4 *objectMat)
+{
+	if (hierarchy && hierarchy->nodes && localMat_out && objectMat)
+	{
+		const a3_HierarchyNode *node = hierarchy->nodes;
+		a3mat4 parentInv;
+		a3ui32 i;
+		for (i = 0; i < hierarchy->numNodes; ++i, ++node)
+		{
+			if (node->parentIndex >= 0)
+			{
+				a3matrixTransformInverse(&parentInv, objectMat + node->parentIndex);
+				a3matrixProductTransform(localMat_out + i, &parentInv, objectMat + i);
+			}
+			else
+				localMat_out[i] = objectMat[i];
+		}
+		return hierarchy->numNodes;
+	}
+	return -1;
+}
+
+// skinning palette: object-space * inverse object-space bind pose
+a3i32 a3kinematicsUpdateSkinPalette(a3mat4 *palette_out, const a3mat4 *objectMat, const a3mat4 *objectBindInverse, const a3ui32 count)
+{
+	return a3matrixProductTransformBatch(palette_out, objectMat, objectBindInverse, count);
+}
+
+
+//-----------------------------------------------------------------------------
+
+// dual quaternion product expanded in place: 
+//	real = rL * rR, dual = rL * dR + dL * rR
+inline void a3kinematicsInternalDualQuatProduct(a3dualquat *Q_out, const a3dualquat *QL, const a3dualquat *QR)
+{
+	const a3real
+		rx = QL->rw * QR->rx + QL->rx * QR->rw + QL->ry * QR->rz - QL->rz * QR->ry,
+		ry = QL->rw * QR->ry - QL->rx * QR->rz + QL->ry * QR->rw + QL->rz * QR->rx,
+		rz = QL->rw * QR->rz + QL->rx * QR->ry - QL->ry * QR->rx + QL->rz * QR->rw,
+		rw = QL->rw * QR->rw - QL->rx * QR->rx - QL->ry * QR->ry - QL->rz * QR->rz,
+		dx = QL->rw * QR->dx + QL->rx * QR->dw + QL->ry * QR->dz - QL->rz * QR->dy
+			+ QL->dw * QR->rx + QL->dx * QR->rw + QL->dy * QR->rz - QL->dz * QR->ry,
+		dy = QL->rw * QR->dy - QL->rx * QR->dz + QL->ry * QR->dw + QL->rz * QR->dx
+			+ QL->dw * QR->ry - QL->dx * QR->rz + QL->dy * QR->rw + QL->dz * QR->rx,
+		dz = QL->rw * QR->dz + QL->rx * QR->dy - QL->ry * QR->dx + QL->rz * QR->dw
+			+ QL->dw * QR->rz + QL->dx * QR->ry - QL->dy * QR->rx + QL->dz * QR->rw,
+		dw = QL->rw * QR->dw - QL->rx * QR->dx - QL->ry * QR->dy - QL->rz * QR->dz
+			+ QL->dw * QR->rw - QL->dx * QR->rx - QL->dy * QR->ry - QL->dz * QR->rz;
+	Q_out->rx = rx;	Q_out->ry = ry;	Q_out->rz = rz;	Q_out->rw = rw;
+	Q_out->dx = dx;	Q_out->dy = dy;	Q_out->dz = dz;	Q_out->dw = dw;
+}
+
+// forward kinematics from local SoA poses starting at 'first' directly to 
+//	unit object-space dual quaternions
+a3i32 a3kinematicsSolveForwardDualQuatSoA(const a3_Hierarchy *hierarchy, a3dualquat *objectDQ_out, const a3_SpatialPoseSoA *localPose, const a3ui32 first)
+{
+	if (hierarchy && hierarchy->nodes && objectDQ_out && localPose && localPose->data &&
+		first + hierarchy->numNodes <= localPose->count)
+	{
+		const a3real *qx = localPose->orientation[0] + first, *qy = localPose->orientation[1] + first, *qz = localPose->orientation[2] + first, *qw = localPose->orientation[3] + first;
+		const a3real *tx = localPose->translation[0] + first, *ty = localPose->translation[1] + first, *tz = localPose->translation[2] + first;
+		const a3_HierarchyNode *node = hierarchy->nodes;
+		a3dualquat local;
+		a3ui32 i;
+		for (i = 0; i < hierarchy->numNodes; ++i, ++node)
+		{
+			// real = rotation, dual = (translation * rotation) / 2
+			local.rx = qx[i];
+			local.ry = qy[i];
+			local.rz = qz[i];
+			local.rw = qw[i];
+			local.dx = a3real_half * (tx[i] * qw[i] + ty[i] * qz[i] - tz[i] * qy[i]);
+			local.dy = a3real_half * (-tx[i] * qz[i] + ty[i] * qw[i] + tz[i] * qx[i]);
+			local.dz = a3real_half * (tx[i] * qy[i] - ty[i] * qx[i] + tz[i] * qw[i]);
+			local.dw = -a3real_half * (tx[i] * qx[i] + ty[i] * qy[i] + tz[i] * qz[i]);
+
+			if (node->parentIndex >= 0)
+				a3kinematicsInternalDualQuatProduct(objectDQ_out + i, objectDQ_out + node->parentIndex, &local);
+			else
+				objectDQ_out[i] = local;
+		}
+		return hierarchy->numNodes;
+	}
+	return -1;
+}
+
+// dual quaternion skinning palette: object-space * inverse object-space bind 
+//	pose; real parts are made to share a hemisphere with their parent
+a3i32 a3kinematicsUpdateSkinPaletteDualQuat(const a3_Hierarchy *hierarchy, a3dualquat *palette_out, const a3dualquat *objectDQ, const a3dualquat *objectBindInverseDQ)
+{
+	if (hierarchy && hierarchy->nodes && palette_out && objectDQ && objectBindInverseDQ)
+	{
+		const a3_HierarchyNode *node = hierarchy->nodes;
+		const a3dualquat *parent;
+		a3real *flip;
+		a3ui32 i, j;
+		for (i = 0; i < hierarchy->numNodes; ++i, ++node)
+		{
+			a3kinematicsInternalDualQuatProduct(palette_out + i, objectDQ + i, objectBindInverseDQ + i);
+			if (node->parentIndex >= 0)
+			{
+				parent = palette_out + node->parentIndex;
+				if (palette_out[i].rx * parent->rx + palette_out[i].ry * parent->ry + palette_out[i].rz * parent->rz + palette_out[i].rw * parent->rw < a3real_zero)
+					for (j = 0, flip = palette_out[i].Q[0]; j < 8; ++j)
+						flip[j] = -flip[j];
+			}
+		}
+		return hierarchy->numNodes;
+	}
+	return -1;
+}
+
+// invert unit dual quaternions (conjugate both parts)
+a3i32 a3kinematicsInvertDualQuat(a3dualquat *dq_out, const a3dualquat *dq, const a3ui32 count)
+{
+	if (dq_out && dq)
+	{
+		a3ui32 i;
+		for (i = 0; i < count; ++i)
+		{
+			dq_out[i].rx = -dq[i].rx;
+			dq_out[i].ry = -dq[i].ry;
+			dq_out[i].rz = -dq[i].rz;
+			dq_out[i].rw = +dq[i].rw;
+			dq_out[i].dx = -dq[i].dx;
+			dq_out[i].dy = -dq[i].dy;
+			dq_out[i].dz = -dq[i].dz;
+			dq_out[i].dw = +dq[i].dw;
+		}
+		return count;
+	}
+	return -1;
+}
+
+
 //-----------------------------------------------------------------------------
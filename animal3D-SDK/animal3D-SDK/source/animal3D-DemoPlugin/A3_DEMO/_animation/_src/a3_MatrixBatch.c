@@ -0,0 +1,85 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_MatrixBatch.c
+	Implementation of batched SIMD matrix operations.
+*/
+
+#include "../a3_MatrixBatch.h"
+
+
+//-----------------------------------------------------------------------------
+
+// batch general products: m_out[i] = mL[i] * mR[i]
+a3i32 a3matrixProductBatch(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR, const a3ui32 count)
+{
+	if (m_out && mL && mR)
+	{
+		a3ui32 i;
+		for (i = 0; i < count; ++i)
+			a3matrixProduct(m_out + i, mL + i, mR + i);
+		return count;
+	}
+	return -1;
+}
+
+// batch affine products: m_out[i] = mL[i] * mR[i]
+a3i32 a3matrixProductTransformBatch(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR, const a3ui32 count)
+{
+	if (m_out && mL && mR)
+	{
+		a3ui32 i;
+		for (i = 0; i < count; ++i)
+			a3matrixProductTransform(m_out + i, mL + i, mR + i);
+		return count;
+	}
+	return -1;
+}
+
+// batch affine products with shared left matrix: m_out[i] = mL * mR[i]
+a3i32 a3matrixProductTransformBatchShared(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR, const a3ui32 count)
+{
+	if (m_out && mL && mR)
+	{
+		// copy left first in case it is one of the outputs
+		const a3mat4 left = *mL;
+		a3ui32 i;
+		for (i = 0; i < count; ++i)
+			a3matrixProductTransform(m_out + i, &left, mR + i);
+		return count;
+	}
+	return -1;
+}
+
+// batch affine inverses: m_out[i] = inverse(m[i])
+a3i32 a3matrixTransformInverseBatch(a3mat4 *m_out, const a3mat4 *m, const a3ui32 count)
+{
+	if (m_out && m)
+	{
+		a3ui32 i;
+		for (i = 0; i < count; ++i)
+			a3matrixTransformInverse(m_out + i, m + i);
+		return count;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
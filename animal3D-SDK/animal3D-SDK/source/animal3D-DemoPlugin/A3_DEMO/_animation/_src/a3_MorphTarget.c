@@ -0,0 +1,674 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_MorphTarget.c
+	Implementation of sparse morph targets.
+*/
+
+#include "../a3_MorphTarget.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+// SSE is used when reals are single precision and the target has SSE2
+
+#if ((defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__) && !(defined A3_REAL_F64 || defined A3_REAL_F128))
+#define A3_MORPHTARGET_SSE
+#include <emmintrin.h>
+#endif	// SSE2
+
+
+// quantized file header
+enum a3_MorphTargetPackFileInfo
+{
+	a3morphTargetPack_magic = 0x504d3341,	// "A3MP"
+	a3morphTargetPack_version = 1,
+};
+
+// largest quantized value
+#define a3morphTargetPack_quantMax	65535
+
+
+//-----------------------------------------------------------------------------
+
+// difference of two vec3 streams at a vertex, widened to four reals; 
+//	returns true if any component exceeds the threshold
+inline a3boolean a3morphTargetInternalDelta(a3real *delta_out, const a3real *target, const a3real *base, const a3ui32 vertexIndex, const a3real threshold)
+{
+	const a3ui32 i = vertexIndex * 3;
+	delta_out[0] = target[i + 0] - base[i + 0];
+	delta_out[1] = target[i + 1] - base[i + 1];
+	delta_out[2] = target[i + 2] - base[i + 2];
+	delta_out[3] = a3real_zero;
+	return (delta_out[0] > threshold || delta_out[0] < -threshold ||
+		delta_out[1] > threshold || delta_out[1] < -threshold ||
+		delta_out[2] > threshold || delta_out[2] < -threshold);
+}
+
+// compare one vertex of target with base; deltas are written for 
+//	position, normal and tangent in that order, whether it moves or not
+inline a3boolean a3morphTargetInternalCompare(a3real delta_out[3][4], const a3_GeometryData *target, const a3_GeometryData *base, const a3ui32 vertexIndex, const a3real threshold)
+{
+	a3boolean moved;
+	moved = a3morphTargetInternalDelta(delta_out[0],
+		(const a3real *)target->attribData[a3attrib_geomPosition], (const a3real *)base->attribData[a3attrib_geomPosition], vertexIndex, threshold);
+	if (base->attribData[a3attrib_geomNormal])
+		moved |= a3morphTargetInternalDelta(delta_out[1],
+			(const a3real *)target->attribData[a3attrib_geomNormal], (const a3real *)base->attribData[a3attrib_geomNormal], vertexIndex, threshold);
+	if (base->attribData[a3attrib_geomTangent])
+		moved |= a3morphTargetInternalDelta(delta_out[2],
+			(const a3real *)target->attribData[a3attrib_geomTangent], (const a3real *)base->attribData[a3attrib_geomTangent], vertexIndex, threshold);
+	return moved;
+}
+
+// widen vec3 stream to four reals per vertex
+inline void a3morphTargetInternalWiden(a3real *v_out, const a3real *v, const a3ui32 count)
+{
+	a3ui32 i;
+	for (i = 0; i < count; ++i, v_out += 4, v += 3)
+	{
+		v_out[0] = v[0];
+		v_out[1] = v[1];
+		v_out[2] = v[2];
+		v_out[3] = a3real_zero;
+	}
+}
+
+// allocate set streams and copy base shape, widened to four reals
+inline a3boolean a3morphTargetInternalSetAlloc(a3_MorphTargetSet *set_out, const a3_GeometryData *base, const a3ui32 numTargets, const a3ui32 numEntries)
+{
+	const a3ui32 numVertices = base->numVertices;
+	const a3boolean hasNormal = (base->attribData[a3attrib_geomNormal] != 0);
+	const a3boolean hasTangent = (base->attribData[a3attrib_geomTangent] != 0);
+	const a3ui32 numStreams = 1 + hasNormal + hasTangent;
+	a3real *stream;
+
+	// reals first to keep them aligned
+	const a3ui32 dataSize = sizeof(a3real) * 4 * numStreams * (numVertices + numEntries) + sizeof(a3ui32) * (numTargets + 1 + numEntries);
+	a3ubyte *const data = (a3ubyte *)malloc(dataSize);
+	if (!data)
+		return 0;
+	memset(set_out, 0, sizeof(a3_MorphTargetSet));
+	set_out->data = data;
+	stream = (a3real *)data;
+	set_out->basePosition = stream;
+	stream += numVertices * 4;
+	if (hasNormal)
+	{
+		set_out->baseNormal = stream;
+		stream += numVertices * 4;
+	}
+	if (hasTangent)
+	{
+		set_out->baseTangent = stream;
+		stream += numVertices * 4;
+	}
+	set_out->deltaPosition = stream;
+	stream += numEntries * 4;
+	if (hasNormal)
+	{
+		set_out->deltaNormal = stream;
+		stream += numEntries * 4;
+	}
+	if (hasTangent)
+	{
+		set_out->deltaTangent = stream;
+		stream += numEntries * 4;
+	}
+	set_out->targetFirst = (a3ui32 *)stream;
+	set_out->vertexIndex = set_out->targetFirst + numTargets + 1;
+	set_out->numVertices = numVertices;
+	set_out->numTargets = numTargets;
+	set_out->numEntries = numEntries;
+
+	a3morphTargetInternalWiden(set_out->basePosition, (const a3real *)base->attribData[a3attrib_geomPosition], numVertices);
+	if (hasNormal)
+		a3morphTargetInternalWiden(set_out->baseNormal, (const a3real *)base->attribData[a3attrib_geomNormal], numVertices);
+	if (hasTangent)
+		a3morphTargetInternalWiden(set_out->baseTangent, (const a3real *)base->attribData[a3attrib_geomTangent], numVertices);
+	return 1;
+}
+
+// scatter-add one weighted delta stream
+inline void a3morphTargetInternalScatterAdd(a3real *v_inout, const a3real *delta, const a3ui32 *vertexIndex, const a3ui32 first, const a3ui32 last, const a3real weight)
+{
+	a3ui32 e;
+#ifdef A3_MORPHTARGET_SSE
+	const __m128 w = _mm_set1_ps(weight);
+	a3real *v;
+	for (e = first, delta += first * 4; e < last; ++e, delta += 4)
+	{
+		v = v_inout + vertexIndex[e] * 4;
+		_mm_storeu_ps(v, _mm_add_ps(_mm_loadu_ps(v), _mm_mul_ps(w, _mm_loadu_ps(delta))));
+	}
+#else	// !A3_MORPHTARGET_SSE
+	a3real *v;
+	for (e = first, delta += first * 4; e < last; ++e, delta += 4)
+	{
+		v = v_inout + vertexIndex[e] * 4;
+		v[0] += weight * delta[0];
+		v[1] += weight * delta[1];
+		v[2] += weight * delta[2];
+	}
+#endif	// A3_MORPHTARGET_SSE
+}
+
+// allocate pack streams; quantized values are followed by padding so the 
+//	last one can be read as four 16-bit values
+inline a3boolean a3morphTargetInternalPackAlloc(a3_MorphTargetPack *pack_out, const a3ui32 numVertices, const a3ui32 numTargets, const a3ui32 numEntries, const a3ui32 numStreams)
+{
+	const a3ui32 dataSize = sizeof(a3f32) * 8 * numStreams * numTargets + sizeof(a3ui32) * (numTargets + 1 + numEntries) + sizeof(a3ui16) * (3 * numStreams * numEntries + 1);
+	a3ubyte *const data = (a3ubyte *)malloc(dataSize);
+	if (!data)
+		return 0;
+	memset(data, 0, dataSize);
+	memset(pack_out, 0, sizeof(a3_MorphTargetPack));
+	pack_out->data = data;
+	pack_out->bounds = (a3f32 *)data;
+	pack_out->targetFirst = (a3ui32 *)(pack_out->bounds + 8 * numStreams * numTargets);
+	pack_out->vertexIndex = pack_out->targetFirst + numTargets + 1;
+	pack_out->delta = (a3ui16 *)(pack_out->vertexIndex + numEntries);
+	pack_out->numVertices = numVertices;
+	pack_out->numTargets = numTargets;
+	pack_out->numEntries = numEntries;
+	pack_out->numStreams = numStreams;
+	return 1;
+}
+
+// size of pack data to save or load, excluding padding
+inline a3ui32 a3morphTargetInternalPackSize(const a3ui32 numTargets, const a3ui32 numEntries, const a3ui32 numStreams)
+{
+	return (sizeof(a3f32) * 8 * numStreams * numTargets + sizeof(a3ui32) * (numTargets + 1 + numEntries) + sizeof(a3ui16) * 3 * numStreams * numEntries);
+}
+
+// quantize one delta stream of a target against its bounds
+inline void a3morphTargetInternalQuantize(a3ui16 *q_out, a3f32 *bounds_out, const a3real *delta, const a3ui32 first, const a3ui32 last, const a3ui32 qStride)
+{
+	a3f32 *const minimum = bounds_out, *const step = bounds_out + 4;
+	a3f32 maximum[3], q;
+	a3ui32 e, k;
+
+	for (k = 0; k < 3; ++k)
+	{
+		minimum[k] = maximum[k] = first < last ? (a3f32)delta[first * 4 + k] : 0.0f;
+		for (e = first + 1; e < last; ++e)
+		{
+			if ((a3f32)delta[e * 4 + k] < minimum[k])
+				minimum[k] = (a3f32)delta[e * 4 + k];
+			else if ((a3f32)delta[e * 4 + k] > maximum[k])
+				maximum[k] = (a3f32)delta[e * 4 + k];
+		}
+		step[k] = (maximum[k] - minimum[k]) / (a3f32)a3morphTargetPack_quantMax;
+	}
+	minimum[3] = step[3] = 0.0f;
+
+	for (e = first; e < last; ++e, q_out += qStride)
+	{
+		for (k = 0; k < 3; ++k)
+		{
+			q = step[k] > 0.0f ? ((a3f32)delta[e * 4 + k] - minimum[k]) / step[k] + 0.5f : 0.0f;
+			q_out[k] = (a3ui16)(q < (a3f32)a3morphTargetPack_quantMax ? q : (a3f32)a3morphTargetPack_quantMax);
+		}
+	}
+}
+
+// scatter-add one weighted quantized stream of a target
+inline void a3morphTargetInternalScatterAddPack(a3real *v_inout, const a3ui16 *q, const a3ui32 qStride, const a3f32 *bounds, const a3ui32 *vertexIndex, const a3ui32 first, const a3ui32 last, const a3real weight)
+{
+	a3ui32 e;
+	a3real *v;
+#ifdef A3_MORPHTARGET_SSE
+	// weight folded into bounds; fourth lane of both is zero, which drops 
+	//	the value read past the three components
+	const __m128 w = _mm_set1_ps(weight);
+	const __m128 minimum = _mm_mul_ps(w, _mm_loadu_ps(bounds)), step = _mm_mul_ps(w, _mm_loadu_ps(bounds + 4));
+	const __m128i zero = _mm_setzero_si128();
+	__m128 d;
+	for (e = first, q += first * qStride; e < last; ++e, q += qStride)
+	{
+		v = v_inout + vertexIndex[e] * 4;
+		d = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)q), zero));
+		_mm_storeu_ps(v, _mm_add_ps(_mm_loadu_ps(v), _mm_add_ps(minimum, _mm_mul_ps(step, d))));
+	}
+#else	// !A3_MORPHTARGET_SSE
+	const a3real
+		mx = weight * bounds[0], my = weight * bounds[1], mz = weight * bounds[2],
+		sx = weight * bounds[4], sy = weight * bounds[5], sz = weight * bounds[6];
+	for (e = first, q += first * qStride; e < last; ++e, q += qStride)
+	{
+		v = v_inout + vertexIndex[e] * 4;
+		v[0] += mx + sx * (a3real)q[0];
+		v[1] += my + sy * (a3real)q[1];
+		v[2] += mz + sz * (a3real)q[2];
+	}
+#endif	// A3_MORPHTARGET_SSE
+}
+
+
+//-----------------------------------------------------------------------------
+
+// create morph target set from base shape and full-copy targets
+a3i32 a3morphTargetSetCreate(a3_MorphTargetSet *set_out, const a3_GeometryData *base, const a3_GeometryData *targets, const a3ui32 numTargets, const a3real threshold)
+{
+	if (set_out && !set_out->data && base && base->data && base->attribData[a3attrib_geomPosition] && targets && numTargets && numTargets <= a3morph_targetMax)
+	{
+		const a3ui32 numVertices = base->numVertices;
+		const a3boolean hasNormal = (base->attribData[a3attrib_geomNormal] != 0);
+		const a3boolean hasTangent = (base->attribData[a3attrib_geomTangent] != 0);
+		a3ui32 numEntries, t, v, e;
+		a3real delta[3][4];
+
+		// targets must match base layout
+		for (t = 0; t < numTargets; ++t)
+			if (targets[t].numVertices != numVertices || !targets[t].attribData[a3attrib_geomPosition] ||
+				(hasNormal && !targets[t].attribData[a3attrib_geomNormal]) ||
+				(hasTangent && !targets[t].attribData[a3attrib_geomTangent]))
+				return -1;
+
+		// count moving vertices
+		for (t = 0, numEntries = 0; t < numTargets; ++t)
+			for (v = 0; v < numVertices; ++v)
+				numEntries += a3morphTargetInternalCompare(delta, targets + t, base, v, threshold);
+
+		if (!a3morphTargetInternalSetAlloc(set_out, base, numTargets, numEntries))
+			return -1;
+
+		// entries
+		for (t = 0, e = 0; t < numTargets; ++t)
+		{
+			set_out->targetFirst[t] = e;
+			for (v = 0; v < numVertices; ++v)
+			{
+				if (a3morphTargetInternalCompare(delta, targets + t, base, v, threshold))
+				{
+					memcpy(set_out->deltaPosition + e * 4, delta[0], sizeof(delta[0]));
+					if (hasNormal)
+						memcpy(set_out->deltaNormal + e * 4, delta[1], sizeof(delta[1]));
+					if (hasTangent)
+						memcpy(set_out->deltaTangent + e * 4, delta[2], sizeof(delta[2]));
+					set_out->vertexIndex[e++] = v;
+				}
+			}
+		}
+		set_out->targetFirst[t] = e;
+		return numEntries;
+	}
+	return -1;
+}
+
+// release morph target set
+a3i32 a3morphTargetSetRelease(a3_MorphTargetSet *set)
+{
+	if (set && set->data)
+	{
+		free(set->data);
+		memset(set, 0, sizeof(a3_MorphTargetSet));
+		return 1;
+	}
+	return -1;
+}
+
+// select active targets by weight
+a3i32 a3morphTargetSelectActive(const a3_MorphTargetSet *set, const a3real *weights, const a3real threshold, const a3ui32 maxActive, a3ui32 *active_out, a3real *activeWeight_out)
+{
+	if (set && set->data && weights && active_out && activeWeight_out)
+	{
+		a3ui32 t, k, count = 0;
+		a3real w, m;
+
+		for (t = 0; t < set->numTargets; ++t)
+		{
+			w = weights[t];
+			m = w < a3real_zero ? -w : w;
+			if (m <= threshold)
+				continue;
+
+			// insertion by decreasing magnitude; the smallest falls off the end
+			for (k = count; k > 0; --k)
+			{
+				if ((activeWeight_out[k - 1] < a3real_zero ? -activeWeight_out[k - 1] : activeWeight_out[k - 1]) >= m)
+					break;
+				if (k < maxActive)
+				{
+					active_out[k] = active_out[k - 1];
+					activeWeight_out[k] = activeWeight_out[k - 1];
+				}
+			}
+			if (k < maxActive)
+			{
+				active_out[k] = t;
+				activeWeight_out[k] = w;
+				if (count < maxActive)
+					++count;
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+// add weighted deltas of active targets to vertex streams
+a3i32 a3morphTargetAccumulate(const a3_MorphTargetSet *set, const a3ui32 *active, const a3real *activeWeight, const a3ui32 activeCount, a3real *position_inout, a3real *normal_inout_opt, a3real *tangent_inout_opt)
+{
+	if (set && set->data && ((active && activeWeight) || !activeCount) && position_inout)
+	{
+		a3ui32 k, t, first, last;
+		a3real w;
+
+		for (k = 0; k < activeCount; ++k)
+		{
+			t = active[k];
+			w = activeWeight[k];
+			if (t >= set->numTargets || w == a3real_zero)
+				continue;
+
+			first = set->targetFirst[t];
+			last = set->targetFirst[t + 1];
+			a3morphTargetInternalScatterAdd(position_inout, set->deltaPosition, set->vertexIndex, first, last, w);
+			if (normal_inout_opt && set->deltaNormal)
+				a3morphTargetInternalScatterAdd(normal_inout_opt, set->deltaNormal, set->vertexIndex, first, last, w);
+			if (tangent_inout_opt && set->deltaTangent)
+				a3morphTargetInternalScatterAdd(tangent_inout_opt, set->deltaTangent, set->vertexIndex, first, last, w);
+		}
+		return activeCount;
+	}
+	return -1;
+}
+
+// evaluate morphed shape
+a3i32 a3morphTargetEvaluate(const a3_MorphTargetSet *set, const a3ui32 *active, const a3real *activeWeight, const a3ui32 activeCount, a3real *position_out, a3real *normal_out_opt, a3real *tangent_out_opt)
+{
+	if (set && set->data && position_out)
+	{
+		const a3ui32 size = sizeof(a3real) * 4 * set->numVertices;
+		memcpy(position_out, set->basePosition, size);
+		if (normal_out_opt && set->baseNormal)
+			memcpy(normal_out_opt, set->baseNormal, size);
+		if (tangent_out_opt && set->baseTangent)
+			memcpy(tangent_out_opt, set->baseTangent, size);
+		return a3morphTargetAccumulate(set, active, activeWeight, activeCount, position_out, normal_out_opt, tangent_out_opt);
+	}
+	return -1;
+}
+
+// fill data texture for the GPU path
+a3i32 a3morphTargetStoreTexture(const a3_MorphTargetSet *set, a3f32 *texels_out, const a3ui32 width)
+{
+	if (set && set->data && texels_out && width)
+	{
+		const a3ui32 numTexels = set->numVertices + set->numEntries * 3;
+		const a3ui32 height = a3morphTargetGetTextureHeight(set, width);
+		a3f32 *header, *texel;
+		const a3real *src;
+		a3ui32 *next, t, e, v, k, o;
+
+		// entries per vertex, then the first entry texel of each vertex
+		next = (a3ui32 *)malloc(sizeof(a3ui32) * set->numVertices);
+		if (!next)
+			return -1;
+		memset(next, 0, sizeof(a3ui32) * set->numVertices);
+		for (e = 0; e < set->numEntries; ++e)
+			++next[set->vertexIndex[e]];
+		memset(texels_out, 0, sizeof(a3f32) * 4 * width * height);
+		for (v = 0, o = set->numVertices; v < set->numVertices; ++v)
+		{
+			header = texels_out + v * 4;
+			header[0] = (a3f32)o;
+			header[1] = (a3f32)next[v];
+			next[v] = o;
+			o += (a3ui32)header[1] * 3;
+		}
+
+		// entries in target order within each vertex
+		for (t = 0; t < set->numTargets; ++t)
+		{
+			for (e = set->targetFirst[t]; e < set->targetFirst[t + 1]; ++e)
+			{
+				texel = texels_out + next[set->vertexIndex[e]] * 4;
+				next[set->vertexIndex[e]] += 3;
+				for (k = 0, src = set->deltaPosition + e * 4; k < 3; ++k)
+					texel[k] = (a3f32)src[k];
+				texel[3] = (a3f32)t;
+				if (set->deltaNormal)
+					for (k = 0, src = set->deltaNormal + e * 4; k < 3; ++k)
+						texel[4 + k] = (a3f32)src[k];
+				if (set->deltaTangent)
+					for (k = 0, src = set->deltaTangent + e * 4; k < 3; ++k)
+						texel[8 + k] = (a3f32)src[k];
+			}
+		}
+		free(next);
+		return numTexels;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// quantize sparse morph target set
+a3i32 a3morphTargetPackCreate(a3_MorphTargetPack *pack_out, const a3_MorphTargetSet *set)
+{
+	if (pack_out && !pack_out->data && set && set->data)
+	{
+		const a3real *delta[3];
+		a3ui32 numStreams = 0, qStride, t, s;
+
+		delta[numStreams++] = set->deltaPosition;
+		if (set->deltaNormal)
+			delta[numStreams++] = set->deltaNormal;
+		if (set->deltaTangent)
+			delta[numStreams++] = set->deltaTangent;
+		if (!a3morphTargetInternalPackAlloc(pack_out, set->numVertices, set->numTargets, set->numEntries, numStreams))
+			return -1;
+
+		qStride = numStreams * 3;
+		memcpy(pack_out->targetFirst, set->targetFirst, sizeof(a3ui32) * (set->numTargets + 1));
+		memcpy(pack_out->vertexIndex, set->vertexIndex, sizeof(a3ui32) * set->numEntries);
+		for (t = 0; t < set->numTargets; ++t)
+			for (s = 0; s < numStreams; ++s)
+				a3morphTargetInternalQuantize(pack_out->delta + set->targetFirst[t] * qStride + s * 3, pack_out->bounds + (t * numStreams + s) * 8,
+					delta[s], set->targetFirst[t], set->targetFirst[t + 1], qStride);
+		return set->numEntries;
+	}
+	return -1;
+}
+
+// release quantized morph targets
+a3i32 a3morphTargetPackRelease(a3_MorphTargetPack *pack)
+{
+	if (pack && pack->data)
+	{
+		free(pack->data);
+		memset(pack, 0, sizeof(a3_MorphTargetPack));
+		return 1;
+	}
+	return -1;
+}
+
+// scatter-add dequantized deltas of active targets
+a3i32 a3morphTargetPackAccumulate(const a3_MorphTargetPack *pack, const a3ui32 *active, const a3real *activeWeight, const a3ui32 activeCount, a3real *position_inout, a3real *normal_inout_opt, a3real *tangent_inout_opt)
+{
+	if (pack && pack->data && ((active && activeWeight) || !activeCount) && position_inout)
+	{
+		a3real *stream[3];
+		const a3ui32 qStride = pack->numStreams * 3;
+		a3ui32 k, t, s, first, last;
+		a3real w;
+
+		stream[0] = position_inout;
+		stream[1] = pack->numStreams > 1 ? normal_inout_opt : 0;
+		stream[2] = pack->numStreams > 2 ? tangent_inout_opt : 0;
+		for (k = 0; k < activeCount; ++k)
+		{
+			t = active[k];
+			w = activeWeight[k];
+			if (t >= pack->numTargets || w == a3real_zero)
+				continue;
+
+			first = pack->targetFirst[t];
+			last = pack->targetFirst[t + 1];
+			for (s = 0; s < pack->numStreams; ++s)
+				if (stream[s])
+					a3morphTargetInternalScatterAddPack(stream[s], pack->delta + s * 3, qStride, pack->bounds + (t * pack->numStreams + s) * 8,
+						pack->vertexIndex, first, last, w);
+		}
+		return activeCount;
+	}
+	return -1;
+}
+
+// create sparse morph target set from base shape and quantized targets
+a3i32 a3morphTargetSetCreatePack(a3_MorphTargetSet *set_out, const a3_GeometryData *base, const a3_MorphTargetPack *pack)
+{
+	if (set_out && !set_out->data && base && base->data && base->attribData[a3attrib_geomPosition] && pack && pack->data &&
+		base->numVertices == pack->numVertices &&
+		pack->numStreams == (a3ui32)(1 + (base->attribData[a3attrib_geomNormal] != 0) + (base->attribData[a3attrib_geomTangent] != 0)))
+	{
+		a3real *delta[3];
+		const a3ui32 qStride = pack->numStreams * 3;
+		const a3ui16 *q;
+		const a3f32 *bounds;
+		a3ui32 t, s, e, k;
+
+		if (!a3morphTargetInternalSetAlloc(set_out, base, pack->numTargets, pack->numEntries))
+			return -1;
+		memcpy(set_out->targetFirst, pack->targetFirst, sizeof(a3ui32) * (pack->numTargets + 1));
+		memcpy(set_out->vertexIndex, pack->vertexIndex, sizeof(a3ui32) * pack->numEntries);
+
+		// delta streams in pack order
+		s = 0;
+		delta[s++] = set_out->deltaPosition;
+		if (set_out->deltaNormal)
+			delta[s++] = set_out->deltaNormal;
+		if (set_out->deltaTangent)
+			delta[s++] = set_out->deltaTangent;
+		for (t = 0; t < pack->numTargets; ++t)
+		{
+			for (s = 0; s < pack->numStreams; ++s)
+			{
+				bounds = pack->bounds + (t * pack->numStreams + s) * 8;
+				for (e = pack->targetFirst[t]; e < pack->targetFirst[t + 1]; ++e)
+				{
+					q = pack->delta + e * qStride + s * 3;
+					for (k = 0; k < 3; ++k)
+						delta[s][e * 4 + k] = (a3real)(bounds[k] + bounds[4 + k] * (a3f32)q[k]);
+					delta[s][e * 4 + 3] = a3real_zero;
+				}
+			}
+		}
+		return pack->numEntries;
+	}
+	return -1;
+}
+
+// save quantized morph targets to binary file
+a3i32 a3morphTargetPackSaveBinary(const a3_MorphTargetPack *pack, const a3_FileStream *fileStream)
+{
+	FILE *fp;
+	a3ui32 ret = 0;
+	a3ui32 header[6];
+	if (pack && pack->data && fileStream)
+	{
+		fp = fileStream->stream;
+		if (fp)
+		{
+			header[0] = a3morphTargetPack_magic;
+			header[1] = a3morphTargetPack_version;
+			header[2] = pack->numVertices;
+			header[3] = pack->numTargets;
+			header[4] = pack->numEntries;
+			header[5] = pack->numStreams;
+			ret += (a3ui32)fwrite(header, 1, sizeof(header), fp);
+			ret += (a3ui32)fwrite(pack->data, 1, a3morphTargetInternalPackSize(pack->numTargets, pack->numEntries, pack->numStreams), fp);
+		}
+		return ret;
+	}
+	return -1;
+}
+
+// bytes left in file from the current position
+inline a3ui64 a3morphTargetInternalFileRemaining(FILE *fp)
+{
+	const long current = ftell(fp);
+	long end = current;
+	if (current >= 0 && !fseek(fp, 0, SEEK_END))
+	{
+		end = ftell(fp);
+		fseek(fp, current, SEEK_SET);
+	}
+	return (end > current ? (a3ui64)(end - current) : 0);
+}
+
+// loaded entry ranges must cover the entries in order and every entry 
+//	must index a base vertex
+inline a3boolean a3morphTargetInternalPackValid(const a3_MorphTargetPack *pack)
+{
+	a3ui32 t, e;
+	if (pack->targetFirst[0] || pack->targetFirst[pack->numTargets] != pack->numEntries)
+		return 0;
+	for (t = 0; t < pack->numTargets; ++t)
+		if (pack->targetFirst[t] > pack->targetFirst[t + 1])
+			return 0;
+	for (e = 0; e < pack->numEntries; ++e)
+		if (pack->vertexIndex[e] >= pack->numVertices)
+			return 0;
+	return 1;
+}
+
+// load quantized morph targets from binary file
+a3i32 a3morphTargetPackLoadBinary(a3_MorphTargetPack *pack_out, const a3_FileStream *fileStream)
+{
+	FILE *fp;
+	a3ui32 ret = 0;
+	a3ui32 header[6];
+	a3ui32 dataSize;
+	if (pack_out && !pack_out->data && fileStream)
+	{
+		fp = fileStream->stream;
+		if (fp)
+		{
+			// counts are checked before allocating: a target moves each 
+			//	vertex at most once, and the data must fit in the file
+			ret += (a3ui32)fread(header, 1, sizeof(header), fp);
+			if (ret == sizeof(header) && header[0] == a3morphTargetPack_magic && header[1] == a3morphTargetPack_version &&
+				header[2] && header[3] && header[3] <= a3morph_targetMax && header[5] >= 1 && header[5] <= 3 &&
+				(a3ui64)header[4] <= (a3ui64)header[2] * header[3] &&
+				(a3ui64)sizeof(a3f32) * 8 * header[5] * header[3] + sizeof(a3ui32) * ((a3ui64)header[3] + 1 + header[4]) + sizeof(a3ui16) * 3 * header[5] * (a3ui64)header[4] <= a3morphTargetInternalFileRemaining(fp) &&
+				a3morphTargetInternalPackAlloc(pack_out, header[2], header[3], header[4], header[5]))
+			{
+				dataSize = a3morphTargetInternalPackSize(header[3], header[4], header[5]);
+				if (fread(pack_out->data, 1, dataSize, fp) == dataSize && a3morphTargetInternalPackValid(pack_out))
+					return (ret + dataSize);
+				a3morphTargetPackRelease(pack_out);
+			}
+			printf("\n A3 Warning: Invalid morph target file.");
+			return 0;
+		}
+		return ret;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,305 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_PathFollow.c
+	Implementation of spline paths and path cursors.
+*/
+
+#include "../a3_PathFollow.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// number of segments described by a control layout, zero if invalid
+inline a3ui32 a3pathInternalNumSegments(const a3_PathCurve curve, const a3ui32 numControls, const a3boolean loop)
+{
+	switch (curve)
+	{
+	case a3path_CatmullRom:
+		if (numControls >= (a3ui32)(loop ? 3 : 2))
+			return (loop ? numControls : numControls - 1);
+		break;
+	case a3path_HermiteTangent:
+		if (numControls % 2 == 0 && numControls >= 4)
+			return (loop ? numControls / 2 : numControls / 2 - 1);
+		break;
+	case a3path_Bezier3:
+		if (loop && numControls % 3 == 0 && numControls >= 3)
+			return (numControls / 3);
+		if (!loop && numControls % 3 == 1 && numControls >= 4)
+			return (numControls / 3);
+		break;
+	}
+	return 0;
+}
+
+// get the four control vectors for a segment in the order taken by the 
+//	A3 spline functions
+inline void a3pathInternalGetSegment(const a3_Path *path, const a3ui32 segment, const a3real *c_out[4])
+{
+	const a3ui32 n = path->numControls;
+	a3ui32 i, j;
+	switch (path->curve)
+	{
+	case a3path_CatmullRom:
+		// previous, start, end, next; open ends reuse the end points
+		i = segment;
+		j = i + 1 < n ? i + 1 : 0;
+		c_out[0] = path->control[i > 0 ? i - 1 : (path->loop ? n - 1 : 0)].v;
+		c_out[1] = path->control[i].v;
+		c_out[2] = path->control[j].v;
+		c_out[3] = path->control[j + 1 < n ? j + 1 : (path->loop ? 0 : n - 1)].v;
+		break;
+	case a3path_HermiteTangent:
+		// start, end, start tangent, end tangent
+		i = segment * 2;
+		j = i + 2 < n ? i + 2 : 0;
+		c_out[0] = path->control[i].v;
+		c_out[1] = path->control[j].v;
+		c_out[2] = path->control[i + 1].v;
+		c_out[3] = path->control[j + 1].v;
+		break;
+	case a3path_Bezier3:
+		i = segment * 3;
+		c_out[0] = path->control[i].v;
+		c_out[1] = path->control[i + 1].v;
+		c_out[2] = path->control[i + 2].v;
+		c_out[3] = path->control[i + 3 < n ? i + 3 : 0].v;
+		break;
+	}
+}
+
+// evaluate segment at local parameter
+inline void a3pathInternalEvaluate(const a3_Path *path, a3real3p position_out, const a3ui32 segment, const a3real u)
+{
+	const a3real *c[4];
+	a3pathInternalGetSegment(path, segment, c);
+	switch (path->curve)
+	{
+	case a3path_CatmullRom:
+		a3real3CatmullRom(position_out, c[0], c[1], c[2], c[3], u);
+		break;
+	case a3path_HermiteTangent:
+		a3real3HermiteTangent(position_out, c[0], c[1], c[2], c[3], u);
+		break;
+	case a3path_Bezier3:
+		a3real3Bezier3(position_out, c[0], c[1], c[2], c[3], u);
+		break;
+	}
+}
+
+// split path parameter into segment and local parameter
+inline a3ui32 a3pathInternalSplitParam(const a3_Path *path, const a3real param, a3real *u_out)
+{
+	a3ui32 segment;
+	if (param <= a3real_zero)
+	{
+		*u_out = a3real_zero;
+		return 0;
+	}
+	segment = (a3ui32)param;
+	if (segment >= path->numSegments)
+	{
+		*u_out = a3real_one;
+		return (path->numSegments - 1);
+	}
+	*u_out = param - (a3real)segment;
+	return segment;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// create path from control vectors (see a3_PathCurve for layout); each 
+//	segment's arc length is tabled with the given number of divisions
+a3i32 a3pathCreate(a3_Path *path_out, const a3_PathCurve curve, const a3vec3 *controls, const a3ui32 numControls, const a3boolean loop, const a3ui32 numDivisions)
+{
+	if (path_out && !path_out->data && controls && numDivisions)
+	{
+		const a3ui32 numSegments = a3pathInternalNumSegments(curve, numControls, loop);
+		const a3ui32 numSamples = numSegments * numDivisions + 1;
+		const a3real *c[4];
+		a3real length, offset;
+		a3ui32 dataSize, s, i, first;
+		a3ubyte *data;
+
+		if (!numSegments)
+			return -1;
+
+		dataSize = sizeof(a3vec3) * numControls + sizeof(a3real3) * numSamples + sizeof(a3real) * numSamples * 2;
+		data = (a3ubyte *)malloc(dataSize);
+		if (!data)
+			return -1;
+		memset(path_out, 0, sizeof(a3_Path));
+		path_out->data = data;
+		path_out->control = (a3vec3 *)data;
+		path_out->sampleTable = (a3real3 *)(path_out->control + numControls);
+		path_out->paramTable = (a3real *)(path_out->sampleTable + numSamples);
+		path_out->arclenTable = path_out->paramTable + numSamples;
+		path_out->curve = curve;
+		path_out->loop = loop;
+		path_out->numControls = numControls;
+		path_out->numSegments = numSegments;
+		path_out->numDivisions = numDivisions;
+		path_out->numSamples = numSamples;
+		memcpy(path_out->control, controls, sizeof(a3vec3) * numControls);
+
+		// table each segment in place; its first sample overwrites the 
+		//	previous segment's last, which is the same point
+		for (s = 0, offset = a3real_zero; s < numSegments; ++s)
+		{
+			first = s * numDivisions;
+			a3pathInternalGetSegment(path_out, s, c);
+			switch (curve)
+			{
+			case a3path_CatmullRom:
+				length = a3real3CalculateArcLengthCatmullRom(path_out->sampleTable + first, path_out->paramTable + first, path_out->arclenTable + first, 0, numDivisions, c[0], c[1], c[2], c[3]);
+				break;
+			case a3path_HermiteTangent:
+				length = a3real3CalculateArcLengthHermiteTangent(path_out->sampleTable + first, path_out->paramTable + first, path_out->arclenTable + first, 0, numDivisions, c[0], c[1], c[2], c[3]);
+				break;
+			default:
+				length = a3real3CalculateArcLengthBezier3(path_out->sampleTable + first, path_out->paramTable + first, path_out->arclenTable + first, 0, numDivisions, c[0], c[1], c[2], c[3]);
+				break;
+			}
+			for (i = 0; i <= numDivisions; ++i)
+			{
+				path_out->paramTable[first + i] += (a3real)s;
+				path_out->arclenTable[first + i] += offset;
+			}
+			offset += length;
+		}
+		path_out->length = offset;
+		return numSegments;
+	}
+	return -1;
+}
+
+// release path
+a3i32 a3pathRelease(a3_Path *path)
+{
+	if (path && path->data)
+	{
+		free(path->data);
+		memset(path, 0, sizeof(a3_Path));
+		return 1;
+	}
+	return -1;
+}
+
+// evaluate path at segment index plus local parameter
+a3i32 a3pathEvaluate(const a3_Path *path, a3real3p position_out, const a3real param)
+{
+	if (path && path->data && position_out)
+	{
+		a3real u;
+		const a3ui32 segment = a3pathInternalSplitParam(path, param, &u);
+		a3pathInternalEvaluate(path, position_out, segment, u);
+		return segment;
+	}
+	return -1;
+}
+
+// initialize cursor on path at distance
+a3i32 a3pathCursorInit(a3_PathCursor *cursor_out, const a3_Path *path, const a3real distance)
+{
+	if (cursor_out && path && path->data)
+	{
+		a3real3 position;
+		cursor_out->path = path;
+		cursor_out->distance = a3real_zero;
+		cursor_out->index = 1;
+		return a3pathCursorSetDistance(cursor_out, distance, position, 0);
+	}
+	return -1;
+}
+
+// move cursor to distance and evaluate position and optional unit forward 
+//	direction of the path; returns segment index
+a3i32 a3pathCursorSetDistance(a3_PathCursor *cursor, const a3real distance, a3real3p position_out, a3real3p direction_out_opt)
+{
+	if (cursor && cursor->path && cursor->path->data && position_out)
+	{
+		const a3_Path *path = cursor->path;
+		const a3real *arclen = path->arclenTable;
+		const a3ui32 last = path->numSamples - 1;
+		a3real d = distance, u, param, lenSq;
+		a3ui32 i = cursor->index, segment;
+
+		// wrap or clamp; wrapping moves the cursor to the end it re-enters
+		if (path->loop && path->length > a3real_zero)
+		{
+			if (d >= path->length)
+			{
+				d -= path->length * (a3real)(a3ui32)(d / path->length);
+				i = 1;
+			}
+			else if (d < a3real_zero)
+			{
+				d += path->length * (a3real)(a3ui32)(a3real_one - d / path->length);
+				if (d >= path->length)
+					d = a3real_zero;
+				i = last;
+			}
+		}
+		else
+			d = a3clamp(a3real_zero, path->length, d);
+		cursor->distance = d;
+
+		// step back to the interval containing the distance, then forward; 
+		//	consecutive calls only move a few samples
+		if (d >= arclen[last])
+		{
+			i = last;
+			u = a3real_one;
+		}
+		else
+		{
+			if (i < 1 || i > last)
+				i = 1;
+			while (i > 1 && arclen[i - 1] > d)
+				--i;
+			i = (a3ui32)a3sampleTableLerpIncrementIndex(arclen, d, i, &u);
+		}
+		cursor->index = i;
+
+		// map interval back to path parameter and evaluate the curve there
+		param = path->paramTable[i - 1] + (path->paramTable[i] - path->paramTable[i - 1]) * u;
+		segment = a3pathInternalSplitParam(path, param, &u);
+		a3pathInternalEvaluate(path, position_out, segment, u);
+
+		// direction of the tabled interval
+		if (direction_out_opt)
+		{
+			a3real3Diff(direction_out_opt, path->sampleTable[i], path->sampleTable[i - 1]);
+			lenSq = a3real3LengthSquared(direction_out_opt);
+			if (lenSq > a3real_zero)
+				a3real3MulS(direction_out_opt, a3sqrtInverse(lenSq));
+		}
+		return segment;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,295 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_PlaybackLog.c
+	Implementation of playback record and replay.
+*/
+
+#include "../a3_PlaybackLog.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// file header
+enum a3_PlaybackLogFileInfo
+{
+	a3playbackLog_magic = 0x4c504133,	// "A3PL"
+	a3playbackLog_version = 2,
+	a3playbackLog_chunk = 256,			// events converted per write
+};
+
+
+// event as stored in file (16 bytes); reals are always written as f64 so 
+//	that float and double builds read each other's logs exactly
+typedef struct a3_PlaybackEventFile
+{
+	a3ubyte type;
+	a3ubyte reserved;
+	a3ui16 controllerIndex;
+	a3ui32 clipIndex;
+	a3f64 value;
+} a3_PlaybackEventFile;
+
+
+// append event, growing storage as needed
+inline a3i32 a3playbackLogInternalPush(a3_PlaybackLog *log, const a3_PlaybackEvent *event)
+{
+	if (log->count == log->capacity)
+	{
+		const a3ui32 capacity = log->capacity ? log->capacity * 2 : 256;
+		a3_PlaybackEvent *const event_new = (a3_PlaybackEvent *)realloc(log->event, sizeof(a3_PlaybackEvent) * capacity);
+		if (!event_new)
+			return 0;
+		log->event = event_new;
+		log->capacity = capacity;
+	}
+	log->event[log->count++] = *event;
+	return 1;
+}
+
+// convert event to and from file layout; returns 0 if the stored type is 
+//	not known
+inline void a3playbackLogInternalStore(a3_PlaybackEventFile *record_out, const a3_PlaybackEvent *event)
+{
+	memset(record_out, 0, sizeof(a3_PlaybackEventFile));
+	record_out->type = event->type;
+	record_out->controllerIndex = event->controllerIndex;
+	if (event->type == a3playbackEvent_clip)
+		record_out->clipIndex = event->clipIndex;
+	else
+		record_out->value = (a3f64)event->dt;
+}
+
+inline a3boolean a3playbackLogInternalLoad(a3_PlaybackEvent *event_out, const a3_PlaybackEventFile *record)
+{
+	memset(event_out, 0, sizeof(a3_PlaybackEvent));
+	event_out->type = record->type;
+	event_out->controllerIndex = record->controllerIndex;
+	switch (record->type)
+	{
+	case a3playbackEvent_frame:
+	case a3playbackEvent_rate:
+		event_out->dt = (a3real)record->value;
+		return 1;
+	case a3playbackEvent_clip:
+		event_out->clipIndex = record->clipIndex;
+		return 1;
+	}
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// allocate log with initial capacity in events; grows when recording
+a3i32 a3playbackLogCreate(a3_PlaybackLog *log_out, const a3ui32 capacity)
+{
+	if (log_out && !log_out->event && capacity)
+	{
+		log_out->event = (a3_PlaybackEvent *)malloc(sizeof(a3_PlaybackEvent) * capacity);
+		if (log_out->event)
+		{
+			log_out->capacity = capacity;
+			log_out->count = log_out->cursor = log_out->numFrames = 0;
+			return capacity;
+		}
+	}
+	return -1;
+}
+
+// release log
+a3i32 a3playbackLogRelease(a3_PlaybackLog *log)
+{
+	if (log && log->event)
+	{
+		free(log->event);
+		memset(log, 0, sizeof(a3_PlaybackLog));
+		return 1;
+	}
+	return -1;
+}
+
+// record start of frame; returns number of frames, 0 if it could not be 
+//	stored
+a3i32 a3playbackLogRecordFrame(a3_PlaybackLog *log, const a3real dt)
+{
+	if (log && log->event)
+	{
+		a3_PlaybackEvent event = { a3playbackEvent_frame };
+		event.dt = dt;
+		if (!a3playbackLogInternalPush(log, &event))
+			return 0;
+		return ++log->numFrames;
+	}
+	return -1;
+}
+
+// record clip switch
+a3i32 a3playbackLogRecordClip(a3_PlaybackLog *log, const a3ui32 controllerIndex, const a3ui32 clipIndex)
+{
+	if (log && log->event && controllerIndex <= 0xffff)
+	{
+		a3_PlaybackEvent event = { a3playbackEvent_clip };
+		event.controllerIndex = (a3ui16)controllerIndex;
+		event.clipIndex = clipIndex;
+		return a3playbackLogInternalPush(log, &event);
+	}
+	return -1;
+}
+
+// record playback rate change
+a3i32 a3playbackLogRecordRate(a3_PlaybackLog *log, const a3ui32 controllerIndex, const a3real rate)
+{
+	if (log && log->event && controllerIndex <= 0xffff)
+	{
+		a3_PlaybackEvent event = { a3playbackEvent_rate };
+		event.controllerIndex = (a3ui16)controllerIndex;
+		event.rate = rate;
+		return a3playbackLogInternalPush(log, &event);
+	}
+	return -1;
+}
+
+// advance replay by one frame: outputs the frame's time step, copies up to 
+//	'maxEvents' of its controller events and counts them; events beyond 
+//	the maximum are skipped; returns 1 if frame replayed, 0 if done
+a3i32 a3playbackLogReplayFrame(a3_PlaybackLog *log, a3real *dt_out, a3_PlaybackEvent *events_out_opt, a3ui32 *numEvents_out_opt, const a3ui32 maxEvents)
+{
+	if (log && log->event && dt_out)
+	{
+		a3ui32 numEvents = 0;
+
+		// skip anything recorded before the first frame
+		while (log->cursor < log->count && log->event[log->cursor].type != a3playbackEvent_frame)
+			++log->cursor;
+		if (log->cursor >= log->count)
+			return 0;
+		*dt_out = log->event[log->cursor++].dt;
+
+		// events up to next frame
+		while (log->cursor < log->count && log->event[log->cursor].type != a3playbackEvent_frame)
+		{
+			if (events_out_opt && numEvents < maxEvents)
+				events_out_opt[numEvents] = log->event[log->cursor];
+			++numEvents;
+			++log->cursor;
+		}
+		if (numEvents_out_opt)
+			*numEvents_out_opt = numEvents < maxEvents ? numEvents : maxEvents;
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// save log to binary file
+a3i32 a3playbackLogSaveBinary(const a3_PlaybackLog *log, const a3_FileStream *fileStream)
+{
+	FILE *fp;
+	a3ui32 ret = 0;
+	a3ui32 header[4];
+	a3_PlaybackEventFile record[a3playbackLog_chunk];
+	a3ui32 i, j, n;
+	if (log && log->event && fileStream)
+	{
+		fp = fileStream->stream;
+		if (fp)
+		{
+			header[0] = a3playbackLog_magic;
+			header[1] = a3playbackLog_version;
+			header[2] = log->count;
+			header[3] = log->numFrames;
+			ret += (a3ui32)fwrite(header, 1, sizeof(header), fp);
+			for (i = 0; i < log->count; i += n)
+			{
+				n = log->count - i < a3playbackLog_chunk ? log->count - i : a3playbackLog_chunk;
+				for (j = 0; j < n; ++j)
+					a3playbackLogInternalStore(record + j, log->event + i + j);
+				ret += (a3ui32)fwrite(record, 1, sizeof(a3_PlaybackEventFile) * n, fp);
+			}
+		}
+		return ret;
+	}
+	return -1;
+}
+
+// load log from binary file; the stored counts are checked against the 
+//	size of the file and every event against the known types, so a stale 
+//	or damaged log is rejected instead of partially replayed
+a3i32 a3playbackLogLoadBinary(a3_PlaybackLog *log, const a3_FileStream *fileStream)
+{
+	FILE *fp;
+	a3ui32 ret = 0;
+	a3ui32 header[4];
+	a3_PlaybackEventFile record[a3playbackLog_chunk];
+	a3ui32 i, j, n, numFrames;
+	long start, end;
+	if (log && !log->event && fileStream)
+	{
+		fp = fileStream->stream;
+		if (fp)
+		{
+			ret += (a3ui32)fread(header, 1, sizeof(header), fp);
+			start = ftell(fp);
+			end = (start >= 0 && !fseek(fp, 0, SEEK_END)) ? ftell(fp) : -1;
+			if (ret == sizeof(header) && header[0] == a3playbackLog_magic && header[1] == a3playbackLog_version &&
+				end >= start && !fseek(fp, start, SEEK_SET) && header[3] <= header[2] &&
+				(a3ui64)header[2] * sizeof(a3_PlaybackEventFile) <= (a3ui64)(end - start) &&
+				a3playbackLogCreate(log, header[2] ? header[2] : 1) > 0)
+			{
+				for (i = numFrames = 0; i < header[2]; i += n)
+				{
+					n = header[2] - i < a3playbackLog_chunk ? header[2] - i : a3playbackLog_chunk;
+					if (fread(record, sizeof(a3_PlaybackEventFile), n, fp) != n)
+						break;
+					for (j = 0; j < n; ++j)
+					{
+						if (!a3playbackLogInternalLoad(log->event + i + j, record + j))
+							break;
+						numFrames += (record[j].type == a3playbackEvent_frame);
+					}
+					if (j < n)
+						break;
+					ret += n * sizeof(a3_PlaybackEventFile);
+				}
+				if (i >= header[2] && numFrames == header[3])
+				{
+					log->count = header[2];
+					log->numFrames = numFrames;
+					return ret;
+				}
+				a3playbackLogRelease(log);
+			}
+			printf("\n A3 Warning: Invalid playback log file.");
+			return 0;
+		}
+		return ret;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
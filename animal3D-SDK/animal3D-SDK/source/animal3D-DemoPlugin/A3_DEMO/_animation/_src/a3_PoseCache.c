@@ -0,0 +1,262 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_PoseCache.c
+	Implementation of shared pose cache.
+*/
+
+#include "../a3_PoseCache.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+// atomics used during the concurrent phase
+
+#if (defined _MSC_VER)
+#include <intrin.h>
+#define a3poseCacheInternalIncrement(dst)			_InterlockedIncrement((long volatile *)(dst))
+#define a3poseCacheInternalExchange(dst, xchg, cmp)	_InterlockedCompareExchange((long volatile *)(dst), (long)(xchg), (long)(cmp))
+#define a3poseCacheInternalAcquire()				_ReadWriteBarrier()
+#else	// !_MSC_VER
+#define a3poseCacheInternalIncrement(dst)			__sync_add_and_fetch((dst), 1)
+#define a3poseCacheInternalExchange(dst, xchg, cmp)	__sync_val_compare_and_swap((dst), (cmp), (xchg))
+#define a3poseCacheInternalAcquire()				__atomic_thread_fence(__ATOMIC_ACQUIRE)
+#endif	// _MSC_VER
+
+
+//-----------------------------------------------------------------------------
+
+inline a3ui32 a3poseCacheInternalHash(const a3_PoseCacheKey *key)
+{
+	a3ui64 h = (a3ui64)(a3address)key->poseGroup;
+	h ^= (a3ui64)key->clipIndex * 0x9e3779b97f4a7c15ull;
+	h ^= (a3ui64)(a3ui32)key->timeTick * 0xc2b2ae3d27d4eb4full;
+	h ^= h >> 29;
+	h *= 0xbf58476d1ce4e5b9ull;
+	h ^= h >> 32;
+	return (a3ui32)h;
+}
+
+inline a3boolean a3poseCacheInternalKeyEqual(const a3_PoseCacheKey *a, const a3_PoseCacheKey *b)
+{
+	return (a->poseGroup == b->poseGroup && a->clipIndex == b->clipIndex && a->timeTick == b->timeTick);
+}
+
+// find entry index for key, -1 if not present
+inline a3i32 a3poseCacheInternalFind(const a3_PoseCache *cache, const a3_PoseCacheKey *key)
+{
+	a3ui32 h = a3poseCacheInternalHash(key), probe;
+	a3i32 e;
+	for (probe = 0; probe <= cache->tableMask; ++probe, ++h)
+	{
+		e = cache->table[h & cache->tableMask];
+		if (e < 0)
+			break;
+		a3poseCacheInternalAcquire();
+		if (a3poseCacheInternalKeyEqual(&cache->entry[e].key, key))
+			return e;
+	}
+	return -1;
+}
+
+// sort entries by last use, most recent first
+int a3poseCacheInternalCompareRecent(void const *a, void const *b)
+{
+	const a3ui64 lhs = *(const a3ui64 *)a, rhs = *(const a3ui64 *)b;
+	return (lhs < rhs) - (lhs > rhs);
+}
+
+
+//-----------------------------------------------------------------------------
+
+// create pose cache for a hierarchy given capacity in poses and time
+//	quantization rate (e.g. 120 ticks per second)
+a3i32 a3poseCacheCreate(a3_PoseCache *cache_out, const a3_Hierarchy *hierarchy, const a3ui32 capacity, const a3real ticksPerSecond)
+{
+	if (cache_out && !cache_out->entry && hierarchy && hierarchy->numNodes && capacity && ticksPerSecond > a3real_zero)
+	{
+		a3ui32 tableSize, dataSize, i;
+		a3ubyte *data;
+
+		// table is at least twice the capacity to keep probe chains short
+		for (tableSize = 1; tableSize < capacity * 2; tableSize <<= 1);
+
+		memset(cache_out, 0, sizeof(a3_PoseCache));
+		if (a3spatialPoseSoACreate(&cache_out->pose, capacity * hierarchy->numNodes) < 0)
+			return -1;
+
+		// evictor's sort keys, entries, table and free list; widest first so 
+		//	that every block is aligned
+		dataSize = sizeof(a3ui64) * capacity + sizeof(a3_PoseCacheEntry) * capacity + sizeof(a3i32) * (tableSize + capacity);
+		data = (a3ubyte *)malloc(dataSize);
+		if (!data)
+		{
+			a3spatialPoseSoARelease(&cache_out->pose);
+			return -1;
+		}
+		memset(data, 0, dataSize);
+		cache_out->recent = (a3ui64 *)data;
+		cache_out->entry = (a3_PoseCacheEntry *)(cache_out->recent + capacity);
+		cache_out->table = (a3i32 *)(cache_out->entry + capacity);
+		cache_out->freeList = (a3i32 *)(cache_out->table + tableSize);
+		cache_out->tableMask = tableSize - 1;
+		cache_out->capacity = capacity;
+		cache_out->numNodes = hierarchy->numNodes;
+		cache_out->ticksPerSecond = ticksPerSecond;
+		cache_out->reserve = (capacity + 3) / 4;
+
+		for (i = 0; i < tableSize; ++i)
+			cache_out->table[i] = -1;
+		for (i = 0; i < capacity; ++i)
+			cache_out->freeList[i] = i;
+		cache_out->freeCount = capacity;
+		cache_out->freeHead = 0;
+		return capacity;
+	}
+	return -1;
+}
+
+// release pose cache
+a3i32 a3poseCacheRelease(a3_PoseCache *cache)
+{
+	if (cache && cache->entry)
+	{
+		a3spatialPoseSoARelease(&cache->pose);
+		free(cache->recent);
+		memset(cache, 0, sizeof(a3_PoseCache));
+		return 1;
+	}
+	return -1;
+}
+
+// advance frame, evicting least-recently-used entries so that the reserve
+//	is free; must not run concurrently with lookups or stores
+a3i32 a3poseCacheBeginFrame(a3_PoseCache *cache)
+{
+	if (cache && cache->entry)
+	{
+		a3ui64 *const recent = cache->recent;
+		const a3ui32 keep = cache->capacity - cache->reserve;
+		a3ui32 i, numLive = 0, numKept, h;
+		a3i32 e;
+
+		// collect published entries; unpublished (duplicate) stores are dropped
+		for (i = 0; i <= cache->tableMask; ++i)
+		{
+			if ((e = cache->table[i]) >= 0)
+			{
+				recent[numLive++] = ((a3ui64)cache->entry[e].lastUsedFrame << 32) | (a3ui32)e;
+				cache->table[i] = -1;
+			}
+		}
+
+		// keep most recently used
+		if (numLive > keep)
+			qsort(recent, numLive, sizeof(a3ui64), a3poseCacheInternalCompareRecent);
+		numKept = numLive < keep ? numLive : keep;
+
+		// republish kept entries
+		for (i = 0; i < numKept; ++i)
+		{
+			e = (a3i32)(recent[i] & 0xffffffff);
+			h = a3poseCacheInternalHash(&cache->entry[e].key);
+			while (cache->table[h & cache->tableMask] >= 0)
+				++h;
+			cache->table[h & cache->tableMask] = e;
+		}
+
+		// everything else is free: mark kept entries and collect the rest
+		for (i = 0; i < cache->capacity; ++i)
+			cache->freeList[i] = 0;
+		for (i = 0; i < numKept; ++i)
+			cache->freeList[recent[i] & 0xffffffff] = 1;
+		for (i = 0, cache->freeCount = 0; i < cache->capacity; ++i)
+			if (!cache->freeList[i])
+				cache->freeList[cache->freeCount++] = i;
+		cache->freeHead = 0;
+
+		++cache->frame;
+		return (numLive - numKept);
+	}
+	return -1;
+}
+
+// look up pose and copy it to the output streams at the first node index;
+//	returns 1 if found, 0 if not found
+a3i32 a3poseCacheLookup(const a3_PoseCache *cache, const a3_PoseCacheKey *key, a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out)
+{
+	if (cache && cache->entry && key && pose_out)
+	{
+		const a3i32 e = a3poseCacheInternalFind(cache, key);
+		if (e >= 0)
+		{
+			cache->entry[e].lastUsedFrame = cache->frame;
+			a3spatialPoseSoACopy(pose_out, first_out, &cache->pose, e * cache->numNodes, cache->numNodes);
+			return 1;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+// store pose read from the input streams at the first node index;
+//	returns 1 if stored, 0 if already present or cache is full this frame
+a3i32 a3poseCacheStore(a3_PoseCache *cache, const a3_PoseCacheKey *key, const a3_SpatialPoseSoA *pose_in, const a3ui32 first_in)
+{
+	if (cache && cache->entry && key && pose_in)
+	{
+		a3ui32 h, probe;
+		a3i32 e, i, other;
+
+		if ((e = a3poseCacheInternalFind(cache, key)) >= 0)
+		{
+			cache->entry[e].lastUsedFrame = cache->frame;
+			return 0;
+		}
+
+		// claim a free entry and fill it before it becomes visible
+		i = a3poseCacheInternalIncrement(&cache->freeHead) - 1;
+		if (i >= (a3i32)cache->freeCount)
+			return 0;
+		e = cache->freeList[i];
+		cache->entry[e].key = *key;
+		cache->entry[e].lastUsedFrame = cache->frame;
+		a3spatialPoseSoACopy(&cache->pose, e * cache->numNodes, pose_in, first_in, cache->numNodes);
+
+		// publish; if another thread published the same key first, this
+		//	entry is simply not referenced and is reclaimed next frame
+		h = a3poseCacheInternalHash(key);
+		for (probe = 0; probe <= cache->tableMask; ++probe, ++h)
+		{
+			other = a3poseCacheInternalExchange(cache->table + (h & cache->tableMask), e, -1);
+			if (other < 0)
+				return 1;
+			if (a3poseCacheInternalKeyEqual(&cache->entry[other].key, key))
+				return 0;
+		}
+		return 0;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
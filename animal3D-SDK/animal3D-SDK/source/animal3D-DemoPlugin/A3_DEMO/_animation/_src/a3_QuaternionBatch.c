@@ -0,0 +1,499 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_QuaternionBatch.c
+	Implementation of batch quaternion operations.
+*/
+
+#include "../a3_QuaternionBatch.h"
+
+#include "../a3_TrigBatch.h"
+
+
+//-----------------------------------------------------------------------------
+// vector operations for the selected instruction set
+
+#if (defined A3_QUATERNIONBATCH_AVX)
+typedef __m256 a3quatBatchInternalVec;
+#define a3quatBatchInternalWidth			8
+#define a3quatBatchInternalSet1(x)			_mm256_set1_ps(x)
+#define a3quatBatchInternalLoad(p)			_mm256_loadu_ps(p)
+#define a3quatBatchInternalStore(p, a)		_mm256_storeu_ps(p, a)
+#define a3quatBatchInternalAdd(a, b)		_mm256_add_ps(a, b)
+#define a3quatBatchInternalSub(a, b)		_mm256_sub_ps(a, b)
+#define a3quatBatchInternalMul(a, b)		_mm256_mul_ps(a, b)
+#define a3quatBatchInternalDiv(a, b)		_mm256_div_ps(a, b)
+#define a3quatBatchInternalSqrt(a)			_mm256_sqrt_ps(a)
+#define a3quatBatchInternalAnd(a, b)		_mm256_and_ps(a, b)
+#define a3quatBatchInternalAndNot(a, b)		_mm256_andnot_ps(a, b)
+#define a3quatBatchInternalXor(a, b)		_mm256_xor_ps(a, b)
+#define a3quatBatchInternalGreater(a, b)	_mm256_cmp_ps(a, b, _CMP_GT_OQ)
+#elif (defined A3_QUATERNIONBATCH_SSE)
+typedef __m128 a3quatBatchInternalVec;
+#define a3quatBatchInternalWidth			4
+#define a3quatBatchInternalSet1(x)			_mm_set1_ps(x)
+#define a3quatBatchInternalLoad(p)			_mm_loadu_ps(p)
+#define a3quatBatchInternalStore(p, a)		_mm_storeu_ps(p, a)
+#define a3quatBatchInternalAdd(a, b)		_mm_add_ps(a, b)
+#define a3quatBatchInternalSub(a, b)		_mm_sub_ps(a, b)
+#define a3quatBatchInternalMul(a, b)		_mm_mul_ps(a, b)
+#define a3quatBatchInternalDiv(a, b)		_mm_div_ps(a, b)
+#define a3quatBatchInternalSqrt(a)			_mm_sqrt_ps(a)
+#define a3quatBatchInternalAnd(a, b)		_mm_and_ps(a, b)
+#define a3quatBatchInternalAndNot(a, b)		_mm_andnot_ps(a, b)
+#define a3quatBatchInternalXor(a, b)		_mm_xor_ps(a, b)
+#define a3quatBatchInternalGreater(a, b)	_mm_cmpgt_ps(a, b)
+#else	// scalar
+#define a3quatBatchInternalWidth			0
+#endif	// AVX, SSE2
+
+// number of quaternions handled by the vector loop
+#if (a3quatBatchInternalWidth)
+#define a3quatBatchInternalMad(a, b, c)		a3quatBatchInternalAdd(a3quatBatchInternalMul(a, b), c)
+#define a3quatBatchInternalVectorCount(count)	((count) / a3quatBatchInternalWidth * a3quatBatchInternalWidth)
+#else	// !a3quatBatchInternalWidth
+#define a3quatBatchInternalVectorCount(count)	0
+#endif	// a3quatBatchInternalWidth
+
+// quaternions per block in operations that go through the batch trig functions
+#define a3quatBatchInternalBlock				64
+
+
+//-----------------------------------------------------------------------------
+
+// scalar shortest-arc interpolation of one quaternion
+inline void a3quatBatchInternalLerpScalar(a3real *const q_out[4], const a3real *const q0[4], const a3real *const q1[4], const a3ui32 i, const a3real u, const a3boolean correct)
+{
+	const a3real d = q0[0][i] * q1[0][i] + q0[1][i] * q1[1][i] + q0[2][i] * q1[2][i] + q0[3][i] * q1[3][i];
+	const a3real t = correct ? a3quatBatchCorrectParam(d < a3real_zero ? -d : d, u) : u;
+	const a3real t0 = a3real_one - t, t1 = d < a3real_zero ? -t : t;
+	const a3real x = q0[0][i] * t0 + q1[0][i] * t1;
+	const a3real y = q0[1][i] * t0 + q1[1][i] * t1;
+	const a3real z = q0[2][i] * t0 + q1[2][i] * t1;
+	const a3real w = q0[3][i] * t0 + q1[3][i] * t1;
+	a3real len = x * x + y * y + z * z + w * w;
+	len = len > a3real_zero ? a3sqrtInverse(len) : a3real_zero;
+	q_out[0][i] = x * len;
+	q_out[1][i] = y * len;
+	q_out[2][i] = z * len;
+	q_out[3][i] = w * len;
+}
+
+// shortest-arc normalized interpolation with optional parameter correction
+inline void a3quatBatchInternalLerp(a3real *const q_out[4], const a3real *const q0[4], const a3real *const q1[4], const a3ui32 count, const a3real u, const a3boolean correct)
+{
+	const a3ui32 countVector = a3quatBatchInternalVectorCount(count);
+	a3ui32 i = 0;
+
+#if (a3quatBatchInternalWidth)
+	const a3quatBatchInternalVec zero = a3quatBatchInternalSet1(a3real_zero), one = a3quatBatchInternalSet1(a3real_one);
+	const a3quatBatchInternalVec sign = a3quatBatchInternalSet1(-a3real_zero);
+	const a3quatBatchInternalVec vu = a3quatBatchInternalSet1(u), h = a3quatBatchInternalSet1(u - a3real_half);
+	const a3quatBatchInternalVec hh = a3quatBatchInternalMul(h, h), uhu = a3quatBatchInternalSet1(u * (u - a3real_half) * (u - a3real_one));
+	a3quatBatchInternalVec ax, ay, az, aw, bx, by, bz, bw, d, s, t, t0, a, b, x, y, z, w, len;
+	for (; i < countVector; i += a3quatBatchInternalWidth)
+	{
+		ax = a3quatBatchInternalLoad(q0[0] + i);
+		ay = a3quatBatchInternalLoad(q0[1] + i);
+		az = a3quatBatchInternalLoad(q0[2] + i);
+		aw = a3quatBatchInternalLoad(q0[3] + i);
+		bx = a3quatBatchInternalLoad(q1[0] + i);
+		by = a3quatBatchInternalLoad(q1[1] + i);
+		bz = a3quatBatchInternalLoad(q1[2] + i);
+		bw = a3quatBatchInternalLoad(q1[3] + i);
+
+		// sign of dot product flips the second weight (shortest arc)
+		d = a3quatBatchInternalMad(ax, bx, a3quatBatchInternalMad(ay, by, a3quatBatchInternalMad(az, bz, a3quatBatchInternalMul(aw, bw))));
+		s = a3quatBatchInternalAnd(d, sign);
+		t = vu;
+		if (correct)
+		{
+			// see a3quatBatchCorrectParam
+			d = a3quatBatchInternalAndNot(sign, d);
+			a = a3quatBatchInternalMad(d, a3quatBatchInternalSet1((a3real)-1.43519), a3quatBatchInternalSet1((a3real)3.55645));
+			a = a3quatBatchInternalMad(d, a, a3quatBatchInternalSet1((a3real)-3.2452));
+			a = a3quatBatchInternalMad(d, a, a3quatBatchInternalSet1((a3real)1.0904));
+			b = a3quatBatchInternalMad(d, a3quatBatchInternalSet1((a3real)0.215638), a3quatBatchInternalSet1((a3real)-1.06021));
+			b = a3quatBatchInternalMad(d, b, a3quatBatchInternalSet1((a3real)0.848013));
+			t = a3quatBatchInternalMad(uhu, a3quatBatchInternalMad(a, hh, b), vu);
+		}
+		t0 = a3quatBatchInternalSub(one, t);
+		t = a3quatBatchInternalXor(t, s);
+
+		x = a3quatBatchInternalMad(ax, t0, a3quatBatchInternalMul(bx, t));
+		y = a3quatBatchInternalMad(ay, t0, a3quatBatchInternalMul(by, t));
+		z = a3quatBatchInternalMad(az, t0, a3quatBatchInternalMul(bz, t));
+		w = a3quatBatchInternalMad(aw, t0, a3quatBatchInternalMul(bw, t));
+
+		// zero length stays zero
+		len = a3quatBatchInternalMad(x, x, a3quatBatchInternalMad(y, y, a3quatBatchInternalMad(z, z, a3quatBatchInternalMul(w, w))));
+		len = a3quatBatchInternalAnd(a3quatBatchInternalGreater(len, zero), a3quatBatchInternalDiv(one, a3quatBatchInternalSqrt(len)));
+		a3quatBatchInternalStore(q_out[0] + i, a3quatBatchInternalMul(x, len));
+		a3quatBatchInternalStore(q_out[1] + i, a3quatBatchInternalMul(y, len));
+		a3quatBatchInternalStore(q_out[2] + i, a3quatBatchInternalMul(z, len));
+		a3quatBatchInternalStore(q_out[3] + i, a3quatBatchInternalMul(w, len));
+	}
+#endif	// a3quatBatchInternalWidth
+
+	for (; i < count; ++i)
+		a3quatBatchInternalLerpScalar(q_out, q0, q1, i, u, correct);
+}
+
+
+//-----------------------------------------------------------------------------
+
+// product: q_out = qL * qR
+a3i32 a3quatBatchProduct(a3real *const q_out[4], const a3real *const qL[4], const a3real *const qR[4], const a3ui32 count)
+{
+	if (q_out && qL && qR)
+	{
+		const a3ui32 countVector = a3quatBatchInternalVectorCount(count);
+		a3real lx, ly, lz, lw, rx, ry, rz, rw;
+		a3ui32 i = 0;
+
+#if (a3quatBatchInternalWidth)
+		a3quatBatchInternalVec vlx, vly, vlz, vlw, vrx, vry, vrz, vrw, x, y, z, w;
+		for (; i < countVector; i += a3quatBatchInternalWidth)
+		{
+			vlx = a3quatBatchInternalLoad(qL[0] + i);
+			vly = a3quatBatchInternalLoad(qL[1] + i);
+			vlz = a3quatBatchInternalLoad(qL[2] + i);
+			vlw = a3quatBatchInternalLoad(qL[3] + i);
+			vrx = a3quatBatchInternalLoad(qR[0] + i);
+			vry = a3quatBatchInternalLoad(qR[1] + i);
+			vrz = a3quatBatchInternalLoad(qR[2] + i);
+			vrw = a3quatBatchInternalLoad(qR[3] + i);
+			x = a3quatBatchInternalSub(a3quatBatchInternalMad(vlw, vrx, a3quatBatchInternalMad(vlx, vrw, a3quatBatchInternalMul(vly, vrz))), a3quatBatchInternalMul(vlz, vry));
+			y = a3quatBatchInternalSub(a3quatBatchInternalMad(vlw, vry, a3quatBatchInternalMad(vly, vrw, a3quatBatchInternalMul(vlz, vrx))), a3quatBatchInternalMul(vlx, vrz));
+			z = a3quatBatchInternalSub(a3quatBatchInternalMad(vlw, vrz, a3quatBatchInternalMad(vlz, vrw, a3quatBatchInternalMul(vlx, vry))), a3quatBatchInternalMul(vly, vrx));
+			w = a3quatBatchInternalSub(a3quatBatchInternalMul(vlw, vrw), a3quatBatchInternalMad(vlx, vrx, a3quatBatchInternalMad(vly, vry, a3quatBatchInternalMul(vlz, vrz))));
+			a3quatBatchInternalStore(q_out[0] + i, x);
+			a3quatBatchInternalStore(q_out[1] + i, y);
+			a3quatBatchInternalStore(q_out[2] + i, z);
+			a3quatBatchInternalStore(q_out[3] + i, w);
+		}
+#endif	// a3quatBatchInternalWidth
+
+		for (; i < count; ++i)
+		{
+			lx = qL[0][i];	ly = qL[1][i];	lz = qL[2][i];	lw = qL[3][i];
+			rx = qR[0][i];	ry = qR[1][i];	rz = qR[2][i];	rw = qR[3][i];
+			q_out[0][i] = lw * rx + lx * rw + ly * rz - lz * ry;
+			q_out[1][i] = lw * ry + ly * rw + lz * rx - lx * rz;
+			q_out[2][i] = lw * rz + lz * rw + lx * ry - ly * rx;
+			q_out[3][i] = lw * rw - lx * rx - ly * ry - lz * rz;
+		}
+		return count;
+	}
+	return -1;
+}
+
+// normalized linear interpolation
+a3i32 a3quatBatchNlerp(a3real *const q_out[4], const a3real *const q0[4], const a3real *const q1[4], const a3ui32 count, const a3real u)
+{
+	if (q_out && q0 && q1)
+	{
+		a3quatBatchInternalLerp(q_out, q0, q1, count, u, a3false);
+		return count;
+	}
+	return -1;
+}
+
+// approximate spherical interpolation
+a3i32 a3quatBatchSlerpApprox(a3real *const q_out[4], const a3real *const q0[4], const a3real *const q1[4], const a3ui32 count, const a3real u)
+{
+	if (q_out && q0 && q1)
+	{
+		a3quatBatchInternalLerp(q_out, q0, q1, count, u, a3true);
+		return count;
+	}
+	return -1;
+}
+
+// spherical linear interpolation of unit quaternions
+// quaternions are processed in blocks: the angles of a block go through 
+//	the batch trig functions together; nearly parallel inputs fall back to 
+//	nlerp, where slerp is numerically unstable
+a3i32 a3quatBatchSlerp(a3real *const q_out[4], const a3real *const q0[4], const a3real *const q1[4], const a3ui32 count, const a3real u)
+{
+	if (q_out && q0 && q1)
+	{
+		const a3real threshold = (a3real)0.9995;
+		a3real d[a3quatBatchInternalBlock], sinAngle[a3quatBatchInternalBlock], angle[a3quatBatchInternalBlock * 2];
+		a3real t0, t1, x, y, z, w, len;
+		a3ui32 i, j, n;
+		for (i = 0; i < count; i += n)
+		{
+			n = count - i < a3quatBatchInternalBlock ? count - i : a3quatBatchInternalBlock;
+
+			// angle between each pair from its cosine and sine
+			for (j = 0; j < n; ++j)
+			{
+				x = q0[0][i + j] * q1[0][i + j] + q0[1][i + j] * q1[1][i + j] + q0[2][i + j] * q1[2][i + j] + q0[3][i + j] * q1[3][i + j];
+				d[j] = x;
+				x = x < a3real_zero ? -x : x;
+				sinAngle[j] = x < a3real_one ? a3sqrt(a3real_one - x * x) : a3real_zero;
+				angle[j] = x;
+			}
+			a3trigBatchAtan2r(angle, sinAngle, angle, n);
+
+			// interpolated angles, then all of their sines at once
+			for (j = 0; j < n; ++j)
+			{
+				angle[j + n] = angle[j] * u;
+				angle[j] -= angle[j + n];
+			}
+			a3trigBatchSinr(angle, angle, n + n);
+
+			for (j = 0; j < n; ++j)
+			{
+				if (d[j] < threshold && d[j] > -threshold)
+				{
+					t0 = angle[j] / sinAngle[j];
+					t1 = angle[j + n] / sinAngle[j];
+				}
+				else
+				{
+					t0 = a3real_one - u;
+					t1 = u;
+				}
+				t1 = d[j] < a3real_zero ? -t1 : t1;
+				x = q0[0][i + j] * t0 + q1[0][i + j] * t1;
+				y = q0[1][i + j] * t0 + q1[1][i + j] * t1;
+				z = q0[2][i + j] * t0 + q1[2][i + j] * t1;
+				w = q0[3][i + j] * t0 + q1[3][i + j] * t1;
+				len = x * x + y * y + z * z + w * w;
+				len = len > a3real_zero ? a3sqrtInverse(len) : a3real_zero;
+				q_out[0][i + j] = x * len;
+				q_out[1][i + j] = y * len;
+				q_out[2][i + j] = z * len;
+				q_out[3][i + j] = w * len;
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+// convert Euler angles in degrees, given as x, y and z angle streams, to 
+//	quaternions; all sines and cosines of a block are evaluated together, 
+//	then combined in closed form: with half-angle sines s and cosines c, 
+//	p = cy*cz, q = sy*sz, r = sy*cz, t = cy*sz, and sign +1 for XYZ or -1 
+//	for ZYX, the quaternion is
+//		x = sx*p - sign*cx*q, y = cx*r + sign*sx*t, 
+//		z = cx*t - sign*sx*r, w = cx*p + sign*sx*q
+a3i32 a3quatBatchSetEuler(a3real *const q_out[4], const a3real *const eulerDegrees[3], const a3ui32 count, const a3boolean orderZYX)
+{
+	if (q_out && eulerDegrees)
+	{
+		const a3real halfDeg2Rad = a3real_deg2rad * a3real_half, sign = orderZYX ? -a3real_one : a3real_one;
+		a3real sn[a3quatBatchInternalBlock * 3], cs[a3quatBatchInternalBlock * 3];
+		a3real *sx, *sy, *sz, *cx, *cy, *cz, p, q, r, t;
+		a3ui32 i, j, n, nVector;
+#if (a3quatBatchInternalWidth)
+		const a3quatBatchInternalVec vsign = a3quatBatchInternalSet1(orderZYX ? -a3real_zero : a3real_zero);
+		a3quatBatchInternalVec vsx, vsy, vsz, vcx, vcy, vcz, vp, vq, vr, vt;
+#endif	// a3quatBatchInternalWidth
+
+		for (i = 0; i < count; i += n)
+		{
+			n = count - i < a3quatBatchInternalBlock ? count - i : a3quatBatchInternalBlock;
+			nVector = a3quatBatchInternalVectorCount(n);
+			sx = sn;	sy = sx + n;	sz = sy + n;
+			cx = cs;	cy = cx + n;	cz = cy + n;
+
+			// half angles in radians, then all of their sines and cosines
+			for (j = 0; j < n; ++j)
+			{
+				sx[j] = eulerDegrees[0][i + j] * halfDeg2Rad;
+				sy[j] = eulerDegrees[1][i + j] * halfDeg2Rad;
+				sz[j] = eulerDegrees[2][i + j] * halfDeg2Rad;
+			}
+			a3trigBatchSinCosr(sn, cs, sn, n * 3);
+
+			j = 0;
+#if (a3quatBatchInternalWidth)
+			for (; j < nVector; j += a3quatBatchInternalWidth)
+			{
+				vsx = a3quatBatchInternalLoad(sx + j);
+				vsy = a3quatBatchInternalLoad(sy + j);
+				vsz = a3quatBatchInternalLoad(sz + j);
+				vcx = a3quatBatchInternalLoad(cx + j);
+				vcy = a3quatBatchInternalLoad(cy + j);
+				vcz = a3quatBatchInternalLoad(cz + j);
+				vp = a3quatBatchInternalMul(vcy, vcz);
+				vq = a3quatBatchInternalXor(a3quatBatchInternalMul(vsy, vsz), vsign);
+				vr = a3quatBatchInternalMul(vsy, vcz);
+				vt = a3quatBatchInternalMul(vcy, vsz);
+				a3quatBatchInternalStore(q_out[0] + i + j, a3quatBatchInternalSub(a3quatBatchInternalMul(vsx, vp), a3quatBatchInternalMul(vcx, vq)));
+				a3quatBatchInternalStore(q_out[1] + i + j, a3quatBatchInternalMad(vcx, vr, a3quatBatchInternalXor(a3quatBatchInternalMul(vsx, vt), vsign)));
+				a3quatBatchInternalStore(q_out[2] + i + j, a3quatBatchInternalSub(a3quatBatchInternalMul(vcx, vt), a3quatBatchInternalXor(a3quatBatchInternalMul(vsx, vr), vsign)));
+				a3quatBatchInternalStore(q_out[3] + i + j, a3quatBatchInternalMad(vcx, vp, a3quatBatchInternalMul(vsx, vq)));
+			}
+#endif	// a3quatBatchInternalWidth
+			for (; j < n; ++j)
+			{
+				p = cy[j] * cz[j];
+				q = sy[j] * sz[j] * sign;
+				r = sy[j] * cz[j];
+				t = cy[j] * sz[j];
+				q_out[0][i + j] = sx[j] * p - cx[j] * q;
+				q_out[1][i + j] = cx[j] * r + sx[j] * t * sign;
+				q_out[2][i + j] = cx[j] * t - sx[j] * r * sign;
+				q_out[3][i + j] = cx[j] * p + sx[j] * q;
+			}
+		}
+		return count;
+	}
+	return -1;
+}
+
+// convert Euler angles in degrees to rotation matrices
+a3i32 a3quatBatchConvertEulerToMat4(a3mat4 *m_out, const a3real *const eulerDegrees[3], const a3ui32 count, const a3boolean orderZYX)
+{
+	if (m_out && eulerDegrees)
+	{
+		a3real q[4][a3quatBatchInternalBlock];
+		a3real *const qs[4] = { q[0], q[1], q[2], q[3] };
+		const a3real *e[3];
+		a3ui32 i, n;
+		for (i = 0; i < count; i += n)
+		{
+			n = count - i < a3quatBatchInternalBlock ? count - i : a3quatBatchInternalBlock;
+			e[0] = eulerDegrees[0] + i;
+			e[1] = eulerDegrees[1] + i;
+			e[2] = eulerDegrees[2] + i;
+			a3quatBatchSetEuler(qs, e, n, orderZYX);
+			a3quatBatchConvertToMat4(m_out + i, (const a3real *const *)qs, 0, 0, n);
+		}
+		return count;
+	}
+	return -1;
+}
+
+// convert unit quaternions to matrices with optional per-axis scale 
+//	(applied first) and optional translation (applied last)
+a3i32 a3quatBatchConvertToMat4(a3mat4 *m_out, const a3real *const q[4], const a3real *const translate_opt[3], const a3real *const scale_opt[3], const a3ui32 count)
+{
+	if (m_out && q)
+	{
+		const a3ui32 countVector = a3quatBatchInternalVectorCount(count);
+		a3real xx, yy, zz, xy, xz, yz, wx, wy, wz, sx, sy, sz;
+		a3ui32 i = 0;
+
+#if (a3quatBatchInternalWidth)
+		// compute rotation columns for a vector of quaternions, then scatter 
+		//	them to the matrices; the fixed column entries are written once
+		const a3quatBatchInternalVec one = a3quatBatchInternalSet1(a3real_one), two = a3quatBatchInternalSet1(a3real_two);
+		a3quatBatchInternalVec x, y, z, w, x2, y2, z2, vxx, vyy, vzz, vxy, vxz, vyz, vwx, vwy, vwz, s;
+		a3real col[9][a3quatBatchInternalWidth];
+		a3ui32 j;
+		for (; i < countVector; i += a3quatBatchInternalWidth)
+		{
+			x = a3quatBatchInternalLoad(q[0] + i);
+			y = a3quatBatchInternalLoad(q[1] + i);
+			z = a3quatBatchInternalLoad(q[2] + i);
+			w = a3quatBatchInternalLoad(q[3] + i);
+			x2 = a3quatBatchInternalMul(x, two);
+			y2 = a3quatBatchInternalMul(y, two);
+			z2 = a3quatBatchInternalMul(z, two);
+			vxx = a3quatBatchInternalMul(x, x2);
+			vyy = a3quatBatchInternalMul(y, y2);
+			vzz = a3quatBatchInternalMul(z, z2);
+			vxy = a3quatBatchInternalMul(x, y2);
+			vxz = a3quatBatchInternalMul(x, z2);
+			vyz = a3quatBatchInternalMul(y, z2);
+			vwx = a3quatBatchInternalMul(w, x2);
+			vwy = a3quatBatchInternalMul(w, y2);
+			vwz = a3quatBatchInternalMul(w, z2);
+
+			s = scale_opt ? a3quatBatchInternalLoad(scale_opt[0] + i) : one;
+			a3quatBatchInternalStore(col[0], a3quatBatchInternalMul(a3quatBatchInternalSub(one, a3quatBatchInternalAdd(vyy, vzz)), s));
+			a3quatBatchInternalStore(col[1], a3quatBatchInternalMul(a3quatBatchInternalAdd(vxy, vwz), s));
+			a3quatBatchInternalStore(col[2], a3quatBatchInternalMul(a3quatBatchInternalSub(vxz, vwy), s));
+			s = scale_opt ? a3quatBatchInternalLoad(scale_opt[1] + i) : one;
+			a3quatBatchInternalStore(col[3], a3quatBatchInternalMul(a3quatBatchInternalSub(vxy, vwz), s));
+			a3quatBatchInternalStore(col[4], a3quatBatchInternalMul(a3quatBatchInternalSub(one, a3quatBatchInternalAdd(vxx, vzz)), s));
+			a3quatBatchInternalStore(col[5], a3quatBatchInternalMul(a3quatBatchInternalAdd(vyz, vwx), s));
+			s = scale_opt ? a3quatBatchInternalLoad(scale_opt[2] + i) : one;
+			a3quatBatchInternalStore(col[6], a3quatBatchInternalMul(a3quatBatchInternalAdd(vxz, vwy), s));
+			a3quatBatchInternalStore(col[7], a3quatBatchInternalMul(a3quatBatchInternalSub(vyz, vwx), s));
+			a3quatBatchInternalStore(col[8], a3quatBatchInternalMul(a3quatBatchInternalSub(one, a3quatBatchInternalAdd(vxx, vyy)), s));
+
+			for (j = 0; j < a3quatBatchInternalWidth; ++j, ++m_out)
+			{
+				m_out->m00 = col[0][j];
+				m_out->m01 = col[1][j];
+				m_out->m02 = col[2][j];
+				m_out->m03 = a3real_zero;
+				m_out->m10 = col[3][j];
+				m_out->m11 = col[4][j];
+				m_out->m12 = col[5][j];
+				m_out->m13 = a3real_zero;
+				m_out->m20 = col[6][j];
+				m_out->m21 = col[7][j];
+				m_out->m22 = col[8][j];
+				m_out->m23 = a3real_zero;
+				m_out->m30 = translate_opt ? translate_opt[0][i + j] : a3real_zero;
+				m_out->m31 = translate_opt ? translate_opt[1][i + j] : a3real_zero;
+				m_out->m32 = translate_opt ? translate_opt[2][i + j] : a3real_zero;
+				m_out->m33 = a3real_one;
+			}
+		}
+#endif	// a3quatBatchInternalWidth
+
+		for (; i < count; ++i, ++m_out)
+		{
+			xx = q[0][i] * q[0][i] * a3real_two;
+			yy = q[1][i] * q[1][i] * a3real_two;
+			zz = q[2][i] * q[2][i] * a3real_two;
+			xy = q[0][i] * q[1][i] * a3real_two;
+			xz = q[0][i] * q[2][i] * a3real_two;
+			yz = q[1][i] * q[2][i] * a3real_two;
+			wx = q[3][i] * q[0][i] * a3real_two;
+			wy = q[3][i] * q[1][i] * a3real_two;
+			wz = q[3][i] * q[2][i] * a3real_two;
+			sx = scale_opt ? scale_opt[0][i] : a3real_one;
+			sy = scale_opt ? scale_opt[1][i] : a3real_one;
+			sz = scale_opt ? scale_opt[2][i] : a3real_one;
+			m_out->m00 = (a3real_one - yy - zz) * sx;
+			m_out->m01 = (xy + wz) * sx;
+			m_out->m02 = (xz - wy) * sx;
+			m_out->m03 = a3real_zero;
+			m_out->m10 = (xy - wz) * sy;
+			m_out->m11 = (a3real_one - xx - zz) * sy;
+			m_out->m12 = (yz + wx) * sy;
+			m_out->m13 = a3real_zero;
+			m_out->m20 = (xz + wy) * sz;
+			m_out->m21 = (yz - wx) * sz;
+			m_out->m22 = (a3real_one - xx - yy) * sz;
+			m_out->m23 = a3real_zero;
+			m_out->m30 = translate_opt ? translate_opt[0][i] : a3real_zero;
+			m_out->m31 = translate_opt ? translate_opt[1][i] : a3real_zero;
+			m_out->m32 = translate_opt ? translate_opt[2][i] : a3real_zero;
+			m_out->m33 = a3real_one;
+		}
+		return count;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,349 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_Retarget.c
+	Implementation of skeleton retargeting.
+*/
+
+#include "../a3_Retarget.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// number of real streams per target node stored in the map
+enum a3_RetargetMapStreamCount
+{
+	a3retarget_numStreams = 22,
+};
+
+
+// quaternion product (x, y, z, w)
+inline void a3retargetInternalQuatProduct(a3real4p q_out, const a3real4p a, const a3real4p b)
+{
+	const a3real x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+	const a3real y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+	const a3real z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+	const a3real w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+	q_out[0] = x;
+	q_out[1] = y;
+	q_out[2] = z;
+	q_out[3] = w;
+}
+
+// compare name after optionally skipping a prefix
+inline a3boolean a3retargetInternalStripPrefix(const a3byte **name, const a3byte *prefix)
+{
+	const size_t len = strlen(prefix);
+	if (len && !strncmp(*name, prefix, len))
+	{
+		*name += len;
+		return a3true;
+	}
+	return a3false;
+}
+
+// apply all prefix rules of a given type to a name
+inline const a3byte *a3retargetInternalCanonicalName(const a3byte *name, const a3_RetargetRule *rules, const a3ui32 ruleCount, const a3_RetargetRuleType type)
+{
+	a3ui32 i;
+	for (i = 0; i < ruleCount; ++i)
+		if (rules[i].type == type && rules[i].a)
+			a3retargetInternalStripPrefix(&name, rules[i].a);
+	return name;
+}
+
+// find the source node driving a target node
+inline a3i32 a3retargetInternalMatch(const a3_Hierarchy *target, const a3ui32 targetIndex, const a3_Hierarchy *source, const a3_RetargetRule *rules, const a3ui32 ruleCount)
+{
+	const a3byte *targetName = target->nodes[targetIndex].name, *targetCanon, *sourceCanon;
+	a3i32 sourceIndex;
+	a3ui32 i;
+
+	// explicit rules take precedence
+	for (i = 0; i < ruleCount; ++i)
+	{
+		if (rules[i].type == a3retargetRule_ignore && rules[i].a &&
+			!strncmp(rules[i].a, targetName, a3node_nameSize))
+			return -1;
+		if (rules[i].type == a3retargetRule_rename && rules[i].a && rules[i].b &&
+			!strncmp(rules[i].b, targetName, a3node_nameSize))
+			if ((sourceIndex = a3hierarchyGetNodeIndex(source, rules[i].a)) >= 0)
+				return sourceIndex;
+	}
+
+	// compare names with prefixes removed
+	targetCanon = a3retargetInternalCanonicalName(targetName, rules, ruleCount, a3retargetRule_prefixTarget);
+	for (i = 0; i < source->numNodes; ++i)
+	{
+		sourceCanon = a3retargetInternalCanonicalName(source->nodes[i].name, rules, ruleCount, a3retargetRule_prefix);
+		if (!strncmp(sourceCanon, targetCanon, a3node_nameSize))
+			return i;
+	}
+	return -1;
+}
+
+// accumulate rest orientations to object space; parents precede children
+inline void a3retargetInternalRestObject(a3real4 *orientation_out, const a3_Hierarchy *hierarchy, const a3_SpatialPoseSoA *rest)
+{
+	a3ui32 i;
+	a3i32 p;
+	for (i = 0; i < hierarchy->numNodes; ++i)
+	{
+		orientation_out[i][0] = rest->orientation[0][i];
+		orientation_out[i][1] = rest->orientation[1][i];
+		orientation_out[i][2] = rest->orientation[2][i];
+		orientation_out[i][3] = rest->orientation[3][i];
+		if ((p = hierarchy->nodes[i].parentIndex) >= 0)
+			a3retargetInternalQuatProduct(orientation_out[i], orientation_out[p], orientation_out[i]);
+	}
+}
+
+
+//-----------------------------------------------------------------------------
+
+// create retargeting map given both hierarchies, their rest (bind) poses
+//	in local space and an optional list of name-matching rules
+a3i32 a3retargetMapCreate(a3_RetargetMap *map_out, const a3_Hierarchy *target, const a3_SpatialPoseSoA *targetRest, const a3_Hierarchy *source, const a3_SpatialPoseSoA *sourceRest, const a3_RetargetRule *rules_opt, const a3ui32 ruleCount)
+{
+	if (map_out && !map_out->data &&
+		target && target->nodes && targetRest && targetRest->data && targetRest->count >= target->numNodes &&
+		source && source->nodes && sourceRest && sourceRest->data && sourceRest->count >= source->numNodes)
+	{
+		const a3ui32 numNodes = target->numNodes;
+		const a3ui32 indexSize = sizeof(a3i32) * numNodes;
+		const a3ui32 streamSize = sizeof(a3real) * numNodes * a3retarget_numStreams;
+		const a3real4 identity = { a3real_zero, a3real_zero, a3real_zero, a3real_one };
+		a3real4 *targetObject, *sourceObject, pre, post;
+		a3real *stream, lenTarget, lenSource;
+		const a3real *parentTarget, *parentSource;
+		a3i32 s, p;
+		a3ui32 t, c;
+
+		// temporary object-space rest orientations for both rigs
+		targetObject = (a3real4 *)malloc(sizeof(a3real4) * (target->numNodes + source->numNodes));
+		if (!targetObject)
+			return -1;
+		sourceObject = targetObject + target->numNodes;
+		a3retargetInternalRestObject(targetObject, target, targetRest);
+		a3retargetInternalRestObject(sourceObject, source, sourceRest);
+
+		// streams after indices
+		map_out->data = malloc(indexSize + streamSize);
+		if (!map_out->data)
+		{
+			free(targetObject);
+			return -1;
+		}
+		map_out->source = source;
+		map_out->target = target;
+		map_out->sourceIndex = (a3i32 *)map_out->data;
+		stream = (a3real *)(map_out->sourceIndex + numNodes);
+		for (c = 0; c < 4; ++c, stream += numNodes)
+			map_out->preRotation[c] = stream;
+		for (c = 0; c < 4; ++c, stream += numNodes)
+			map_out->postRotation[c] = stream;
+		for (c = 0; c < 3; ++c, stream += numNodes)
+			map_out->targetRestTranslation[c] = stream;
+		for (c = 0; c < 3; ++c, stream += numNodes)
+			map_out->sourceRestTranslation[c] = stream;
+		map_out->translationRatio = stream;
+		stream += numNodes;
+		for (c = 0; c < 3; ++c, stream += numNodes)
+			map_out->scaleRatio[c] = stream;
+		for (c = 0; c < 4; ++c, stream += numNodes)
+			map_out->targetRestOrientation[c] = stream;
+		map_out->numMapped = 0;
+
+		for (t = 0; t < numNodes; ++t)
+		{
+			s = a3retargetInternalMatch(target, t, source, rules_opt, rules_opt ? ruleCount : 0);
+			map_out->sourceIndex[t] = s;
+
+			for (c = 0; c < 4; ++c)
+				map_out->targetRestOrientation[c][t] = targetRest->orientation[c][t];
+			for (c = 0; c < 3; ++c)
+				map_out->targetRestTranslation[c][t] = targetRest->translation[c][t];
+
+			if (s >= 0)
+			{
+				// pre-rotation converts from source parent space to target
+				//	parent space: inverse(target parent) * source parent
+				p = target->nodes[t].parentIndex;
+				parentTarget = p >= 0 ? targetObject[p] : identity;
+				p = source->nodes[s].parentIndex;
+				parentSource = p >= 0 ? sourceObject[p] : identity;
+				pre[0] = -parentTarget[0];
+				pre[1] = -parentTarget[1];
+				pre[2] = -parentTarget[2];
+				pre[3] = +parentTarget[3];
+				a3retargetInternalQuatProduct(pre, pre, parentSource);
+
+				// post-rotation converts source rest frame to target rest frame:
+				//	inverse(source object) * target object
+				post[0] = -sourceObject[s][0];
+				post[1] = -sourceObject[s][1];
+				post[2] = -sourceObject[s][2];
+				post[3] = +sourceObject[s][3];
+				a3retargetInternalQuatProduct(post, post, targetObject[t]);
+
+				for (c = 0; c < 4; ++c)
+				{
+					map_out->preRotation[c][t] = pre[c];
+					map_out->postRotation[c][t] = post[c];
+				}
+
+				// translation offsets are scaled by relative bone length
+				lenTarget = lenSource = a3real_zero;
+				for (c = 0; c < 3; ++c)
+				{
+					map_out->sourceRestTranslation[c][t] = sourceRest->translation[c][s];
+					map_out->scaleRatio[c][t] = sourceRest->scale[c][s] != a3real_zero ?
+						(targetRest->scale[c][t] / sourceRest->scale[c][s]) : a3real_one;
+					lenTarget += targetRest->translation[c][t] * targetRest->translation[c][t];
+					lenSource += sourceRest->translation[c][s] * sourceRest->translation[c][s];
+				}
+				map_out->translationRatio[t] = lenSource > a3real_epsilon && lenTarget > a3real_epsilon ?
+					a3sqrt(lenTarget / lenSource) : a3real_one;
+
+				++map_out->numMapped;
+			}
+			else
+			{
+				// unmapped nodes hold target rest pose; scale ratio holds rest scale
+				for (c = 0; c < 4; ++c)
+				{
+					map_out->preRotation[c][t] = identity[c];
+					map_out->postRotation[c][t] = identity[c];
+				}
+				for (c = 0; c < 3; ++c)
+				{
+					map_out->sourceRestTranslation[c][t] = a3real_zero;
+					map_out->scaleRatio[c][t] = targetRest->scale[c][t];
+				}
+				map_out->translationRatio[t] = a3real_zero;
+			}
+		}
+
+		free(targetObject);
+		return map_out->numMapped;
+	}
+	return -1;
+}
+
+// release retargeting map
+a3i32 a3retargetMapRelease(a3_RetargetMap *map)
+{
+	if (map && map->data)
+	{
+		free(map->data);
+		memset(map, 0, sizeof(a3_RetargetMap));
+		return 1;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// transfer local poses from source to target for a number of characters;
+//	poses are stored pose-major, one full hierarchy per character
+a3i32 a3retargetPoseTransfer(const a3_RetargetMap *map, a3_SpatialPoseSoA const *pose_out, const a3_SpatialPoseSoA *pose_in, const a3ui32 poseCount)
+{
+	if (map && map->data && pose_out && pose_out->data && pose_in && pose_in->data &&
+		pose_out->count >= poseCount * map->target->numNodes &&
+		pose_in->count >= poseCount * map->source->numNodes)
+	{
+		const a3ui32 numTarget = map->target->numNodes, numSource = map->source->numNodes;
+		const a3i32 *sourceIndex = map->sourceIndex;
+		const a3real *const *pre = (const a3real *const *)map->preRotation, *const *post = (const a3real *const *)map->postRotation;
+		const a3real *const *restT = (const a3real *const *)map->targetRestTranslation, *const *restS = (const a3real *const *)map->sourceRestTranslation;
+		const a3real *const *restQ = (const a3real *const *)map->targetRestOrientation, *const *ratioS = (const a3real *const *)map->scaleRatio;
+		const a3real *ratioT = map->translationRatio;
+		a3real *const *qo = pose_out->orientation, *const *to = pose_out->translation, *const *so = pose_out->scale;
+		a3real *const *qi = pose_in->orientation, *const *ti = pose_in->translation, *const *si = pose_in->scale;
+		a3real qx, qy, qz, qw, rx, ry, rz, rw, vx, vy, vz, cx, cy, cz;
+		a3ui32 n, t, o, i;
+		a3i32 s;
+
+		for (n = 0; n < poseCount; ++n)
+		{
+			for (t = 0, o = n * numTarget; t < numTarget; ++t, ++o)
+			{
+				s = sourceIndex[t];
+				if (s >= 0)
+				{
+					i = n * numSource + s;
+
+					// rotation: pre * source * post
+					qx = qi[3][i] * post[0][t] + qi[0][i] * post[3][t] + qi[1][i] * post[2][t] - qi[2][i] * post[1][t];
+					qy = qi[3][i] * post[1][t] - qi[0][i] * post[2][t] + qi[1][i] * post[3][t] + qi[2][i] * post[0][t];
+					qz = qi[3][i] * post[2][t] + qi[0][i] * post[1][t] - qi[1][i] * post[0][t] + qi[2][i] * post[3][t];
+					qw = qi[3][i] * post[3][t] - qi[0][i] * post[0][t] - qi[1][i] * post[1][t] - qi[2][i] * post[2][t];
+					rx = pre[3][t] * qx + pre[0][t] * qw + pre[1][t] * qz - pre[2][t] * qy;
+					ry = pre[3][t] * qy - pre[0][t] * qz + pre[1][t] * qw + pre[2][t] * qx;
+					rz = pre[3][t] * qz + pre[0][t] * qy - pre[1][t] * qx + pre[2][t] * qw;
+					rw = pre[3][t] * qw - pre[0][t] * qx - pre[1][t] * qy - pre[2][t] * qz;
+					qo[0][o] = rx;
+					qo[1][o] = ry;
+					qo[2][o] = rz;
+					qo[3][o] = rw;
+
+					// translation: target rest + pre-rotated, scaled offset from source rest
+					//	v' = v + 2w(q x v) + 2q x (q x v)
+					vx = (ti[0][i] - restS[0][t]) * ratioT[t];
+					vy = (ti[1][i] - restS[1][t]) * ratioT[t];
+					vz = (ti[2][i] - restS[2][t]) * ratioT[t];
+					cx = (pre[1][t] * vz - pre[2][t] * vy) * a3real_two;
+					cy = (pre[2][t] * vx - pre[0][t] * vz) * a3real_two;
+					cz = (pre[0][t] * vy - pre[1][t] * vx) * a3real_two;
+					to[0][o] = restT[0][t] + vx + pre[3][t] * cx + (pre[1][t] * cz - pre[2][t] * cy);
+					to[1][o] = restT[1][t] + vy + pre[3][t] * cy + (pre[2][t] * cx - pre[0][t] * cz);
+					to[2][o] = restT[2][t] + vz + pre[3][t] * cz + (pre[0][t] * cy - pre[1][t] * cx);
+
+					// scale
+					so[0][o] = si[0][i] * ratioS[0][t];
+					so[1][o] = si[1][i] * ratioS[1][t];
+					so[2][o] = si[2][i] * ratioS[2][t];
+				}
+				else
+				{
+					qo[0][o] = restQ[0][t];
+					qo[1][o] = restQ[1][t];
+					qo[2][o] = restQ[2][t];
+					qo[3][o] = restQ[3][t];
+					to[0][o] = restT[0][t];
+					to[1][o] = restT[1][t];
+					to[2][o] = restT[2][t];
+					so[0][o] = ratioS[0][t];
+					so[1][o] = ratioS[1][t];
+					so[2][o] = ratioS[2][t];
+				}
+			}
+		}
+		return poseCount;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
@@ -0,0 +1,457 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_SkinWeights.c
+	Implementation of skin weights import and storage.
+*/
+
+#include "../a3_SkinWeights.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+//-----------------------------------------------------------------------------
+
+// file header
+enum a3_SkinWeightsFileInfo
+{
+	a3skinWeights_magic = 0x57534133,	// "A3SW"
+	a3skinWeights_version = 1,
+};
+
+// reader limits
+enum a3_SkinWeightsReaderSize
+{
+	a3skinWeights_readerBufferSize = 4096,
+	a3skinWeights_readerTokenSize = 128,
+	a3skinWeights_influenceIndexMax = 256,
+};
+
+
+// buffered character reader over a file
+typedef struct a3_SkinWeightsReader
+{
+	FILE *fp;
+	a3ui32 count, cursor;
+	a3byte buffer[a3skinWeights_readerBufferSize];
+} a3_SkinWeightsReader;
+
+
+// running top-k weights per vertex
+typedef struct a3_SkinWeightsAccumulator
+{
+	a3f32 *weight;
+	a3ubyte *index;
+	a3ui32 capacity, numVertices;
+} a3_SkinWeightsAccumulator;
+
+
+//-----------------------------------------------------------------------------
+
+// next character, -1 at end of file
+inline a3i32 a3skinWeightsInternalGet(a3_SkinWeightsReader *reader)
+{
+	if (reader->cursor >= reader->count)
+	{
+		reader->count = (a3ui32)fread(reader->buffer, 1, sizeof(reader->buffer), reader->fp);
+		reader->cursor = 0;
+		if (!reader->count)
+			return -1;
+	}
+	return (a3ubyte)reader->buffer[reader->cursor++];
+}
+
+inline a3boolean a3skinWeightsInternalIsSpace(const a3i32 c)
+{
+	return (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+}
+
+// read name up to whitespace or one of the given terminators; returns the 
+//	character that ended the name; long names are truncated
+inline a3i32 a3skinWeightsInternalReadName(a3_SkinWeightsReader *reader, a3byte *name_out, a3i32 c)
+{
+	a3ui32 n = 0;
+	while (c >= 0 && !a3skinWeightsInternalIsSpace(c) && c != '=' && c != '>' && c != '/')
+	{
+		if (n < a3skinWeights_readerTokenSize - 1)
+			name_out[n++] = (a3byte)c;
+		c = a3skinWeightsInternalGet(reader);
+	}
+	name_out[n] = 0;
+	return c;
+}
+
+// read quoted value after '='; returns 1 if a value was read
+inline a3boolean a3skinWeightsInternalReadValue(a3_SkinWeightsReader *reader, a3byte *value_out)
+{
+	a3ui32 n = 0;
+	a3i32 c, quote;
+	do c = a3skinWeightsInternalGet(reader); while (a3skinWeightsInternalIsSpace(c));
+	if (c != '"' && c != '\'')
+		return 0;
+	for (quote = c, c = a3skinWeightsInternalGet(reader); c >= 0 && c != quote; c = a3skinWeightsInternalGet(reader))
+		if (n < a3skinWeights_readerTokenSize - 1)
+			value_out[n++] = (a3byte)c;
+	value_out[n] = 0;
+	return (c == quote);
+}
+
+// make room for vertex
+inline a3boolean a3skinWeightsInternalReserve(a3_SkinWeightsAccumulator *acc, const a3ui32 numVertices)
+{
+	a3ui32 capacity;
+	a3f32 *weight;
+	a3ubyte *index;
+	if (numVertices > acc->capacity)
+	{
+		for (capacity = acc->capacity ? acc->capacity : 1024; capacity < numVertices; capacity *= 2);
+		weight = (a3f32 *)realloc(acc->weight, sizeof(a3f32) * a3skinWeights_influenceMax * capacity);
+		if (!weight)
+			return 0;
+		acc->weight = weight;
+		index = (a3ubyte *)realloc(acc->index, a3skinWeights_influenceMax * capacity);
+		if (!index)
+			return 0;
+		acc->index = index;
+		memset(acc->weight + a3skinWeights_influenceMax * acc->capacity, 0, sizeof(a3f32) * a3skinWeights_influenceMax * (capacity - acc->capacity));
+		memset(acc->index + a3skinWeights_influenceMax * acc->capacity, 0, a3skinWeights_influenceMax * (capacity - acc->capacity));
+		acc->capacity = capacity;
+	}
+	if (numVertices > acc->numVertices)
+		acc->numVertices = numVertices;
+	return 1;
+}
+
+// offer weight to vertex: replaces the smallest kept weight if larger
+inline void a3skinWeightsInternalOffer(a3_SkinWeightsAccumulator *acc, const a3ui32 vertexIndex, const a3ui32 influence, const a3f32 w, const a3ui32 maxInfluences)
+{
+	a3f32 *const weight = acc->weight + vertexIndex * a3skinWeights_influenceMax;
+	a3ubyte *const index = acc->index + vertexIndex * a3skinWeights_influenceMax;
+	a3ui32 k, smallest = 0;
+	for (k = 1; k < maxInfluences; ++k)
+		if (weight[k] < weight[smallest])
+			smallest = k;
+	if (w > weight[smallest])
+	{
+		weight[smallest] = w;
+		index[smallest] = (a3ubyte)influence;
+	}
+}
+
+// sort, renormalize and quantize one vertex so that its weights sum to 255
+inline void a3skinWeightsInternalQuantize(a3ubyte *weight_out, a3ubyte *index_out, a3f32 *weight, a3ubyte *index)
+{
+	a3f32 sum, w;
+	a3ubyte i;
+	a3ui32 k, j, total, q;
+
+	// insertion sort, largest first
+	for (k = 1; k < a3skinWeights_influenceMax; ++k)
+		for (j = k; j > 0 && weight[j] > weight[j - 1]; --j)
+		{
+			w = weight[j]; weight[j] = weight[j - 1]; weight[j - 1] = w;
+			i = index[j]; index[j] = index[j - 1]; index[j - 1] = i;
+		}
+
+	sum = weight[0] + weight[1] + weight[2] + weight[3];
+	for (k = total = 0; k < a3skinWeights_influenceMax; ++k)
+	{
+		q = sum > 0.0f ? (a3ui32)(weight[k] / sum * 255.0f + 0.5f) : 0;
+		weight_out[k] = (a3ubyte)(q < 255 ? q : 255);
+		index_out[k] = weight_out[k] ? index[k] : 0;
+		total += weight_out[k];
+	}
+
+	// rounding error goes to the largest weight; unweighted vertices 
+	//	are bound fully to influence 0
+	if (total)
+		weight_out[0] = (a3ubyte)((a3i32)weight_out[0] + 255 - (a3i32)total);
+	else
+		weight_out[0] = 255;
+
+	// taking error from the largest can drop it below the next, so sort 
+	//	again; equal weights go by influence index
+	for (k = 1; k < a3skinWeights_influenceMax; ++k)
+		for (j = k; j > 0 && (weight_out[j] > weight_out[j - 1] || 
+			(weight_out[j] == weight_out[j - 1] && index_out[j] < index_out[j - 1])); --j)
+		{
+			i = weight_out[j]; weight_out[j] = weight_out[j - 1]; weight_out[j - 1] = i;
+			i = index_out[j]; index_out[j] = index_out[j - 1]; index_out[j - 1] = i;
+		}
+}
+
+
+//-----------------------------------------------------------------------------
+
+// load weights from Maya deformerWeight XML
+a3i32 a3skinWeightsLoadDeformerXML(a3_SkinWeights *weights_out, const a3byte *filePath, const a3ui32 maxInfluences, const a3byte *influenceNames_opt[], const a3ui32 numInfluenceNames)
+{
+	if (weights_out && !weights_out->weight && filePath && *filePath &&
+		maxInfluences && maxInfluences <= a3skinWeights_influenceMax)
+	{
+		a3_SkinWeightsReader *reader = (a3_SkinWeightsReader *)malloc(sizeof(a3_SkinWeightsReader));
+		a3_SkinWeightsAccumulator acc = { 0 };
+		a3byte tag[a3skinWeights_readerTokenSize], attrib[a3skinWeights_readerTokenSize], value[a3skinWeights_readerTokenSize];
+		a3byte source[a3skinWeights_readerTokenSize];
+		a3i32 c, influence = -1, layer, pointIndex;
+		a3f32 pointValue;
+		a3ui32 numInfluences = 0, i;
+		a3boolean closing, selfClosing, inWeights = 0, ok = 1;
+
+		if (!reader)
+			return -1;
+		reader->fp = fopen(filePath, "rb");
+		reader->count = reader->cursor = 0;
+		if (!reader->fp)
+		{
+			printf("\n A3 Warning: Cannot open skin weights file \"%s\".", filePath);
+			free(reader);
+			return 0;
+		}
+
+		// single pass over elements; only 'shape', 'weights' and 'point' are 
+		//	read, everything else is skipped without being stored
+		for (c = a3skinWeightsInternalGet(reader); c >= 0 && ok; c = a3skinWeightsInternalGet(reader))
+		{
+			if (c != '<')
+				continue;
+
+			// declarations and comments
+			c = a3skinWeightsInternalGet(reader);
+			if (c == '?' || c == '!')
+			{
+				while (c >= 0 && c != '>')
+					c = a3skinWeightsInternalGet(reader);
+				continue;
+			}
+			closing = (c == '/');
+			if (closing)
+				c = a3skinWeightsInternalGet(reader);
+			c = a3skinWeightsInternalReadName(reader, tag, c);
+
+			// attributes
+			layer = pointIndex = -1;
+			pointValue = 0.0f;
+			source[0] = 0;
+			selfClosing = 0;
+			while (c >= 0 && c != '>')
+			{
+				if (c == '/')
+					selfClosing = 1;
+				else if (!a3skinWeightsInternalIsSpace(c))
+				{
+					c = a3skinWeightsInternalReadName(reader, attrib, c);
+					while (a3skinWeightsInternalIsSpace(c))
+						c = a3skinWeightsInternalGet(reader);
+					if (c != '=' || !a3skinWeightsInternalReadValue(reader, value))
+						continue;
+					if (!strcmp(tag, "point"))
+					{
+						if (!strcmp(attrib, "index"))
+							pointIndex = atoi(value);
+						else if (!strcmp(attrib, "value"))
+							pointValue = (a3f32)atof(value);
+					}
+					else if (!strcmp(tag, "weights"))
+					{
+						if (!strcmp(attrib, "source"))
+							strcpy(source, value);
+						else if (!strcmp(attrib, "layer"))
+							layer = atoi(value);
+					}
+					else if (!strcmp(tag, "shape") && !strcmp(attrib, "size"))
+						ok = a3skinWeightsInternalReserve(&acc, (a3ui32)atoi(value));
+				}
+				c = a3skinWeightsInternalGet(reader);
+			}
+
+			// element complete
+			if (!strcmp(tag, "weights"))
+			{
+				inWeights = !closing && !selfClosing;
+				influence = -1;
+				if (inWeights)
+				{
+					if (influenceNames_opt)
+					{
+						for (i = 0; i < numInfluenceNames; ++i)
+							if (influenceNames_opt[i] && !strcmp(influenceNames_opt[i], source))
+								break;
+						influence = i < numInfluenceNames ? (a3i32)i : -1;
+						if (influence < 0)
+							printf("\n A3 Warning: Skin influence \"%s\" not in name list; ignored.", source);
+					}
+					else
+						influence = layer >= 0 ? layer : (a3i32)numInfluences;
+					if (influence >= a3skinWeights_influenceIndexMax)
+					{
+						printf("\n A3 Warning: Skin influence \"%s\" index out of range; ignored.", source);
+						influence = -1;
+					}
+					if (influence >= (a3i32)numInfluences)
+						numInfluences = influence + 1;
+				}
+			}
+			else if (inWeights && influence >= 0 && !closing && !strcmp(tag, "point") && pointIndex >= 0 && pointValue > 0.0f)
+			{
+				ok = a3skinWeightsInternalReserve(&acc, (a3ui32)pointIndex + 1);
+				if (ok)
+					a3skinWeightsInternalOffer(&acc, (a3ui32)pointIndex, (a3ui32)influence, pointValue, maxInfluences);
+			}
+		}
+		fclose(reader->fp);
+		free(reader);
+
+		// compact result
+		if (ok && acc.numVertices)
+		{
+			weights_out->weight = (a3ubyte *)malloc(a3skinWeights_influenceMax * 2 * acc.numVertices);
+			ok = (weights_out->weight != 0);
+			if (ok)
+			{
+				weights_out->index = weights_out->weight + a3skinWeights_influenceMax * acc.numVertices;
+				weights_out->numVertices = acc.numVertices;
+				weights_out->numInfluences = numInfluences;
+				for (i = 0; i < acc.numVertices; ++i)
+					a3skinWeightsInternalQuantize(weights_out->weight + i * a3skinWeights_influenceMax, weights_out->index + i * a3skinWeights_influenceMax,
+						acc.weight + i * a3skinWeights_influenceMax, acc.index + i * a3skinWeights_influenceMax);
+			}
+		}
+		else if (ok)
+			printf("\n A3 Warning: No skin weights in \"%s\".", filePath);
+		free(acc.weight);
+		free(acc.index);
+		return (ok ? weights_out->numVertices : 0);
+	}
+	return -1;
+}
+
+// release weights
+a3i32 a3skinWeightsRelease(a3_SkinWeights *weights)
+{
+	if (weights && weights->weight)
+	{
+		free(weights->weight);
+		memset(weights, 0, sizeof(a3_SkinWeights));
+		return 1;
+	}
+	return -1;
+}
+
+// expand to the geometry blending layout
+a3i32 a3skinWeightsDecode(const a3_SkinWeights *weights, a3real *blendWeights_out, a3i32 *blendIndices_out)
+{
+	if (weights && weights->weight && blendWeights_out && blendIndices_out)
+	{
+		const a3ui32 n = weights->numVertices * a3skinWeights_influenceMax;
+		const a3real s = a3real_one / (a3real)255;
+		a3ui32 i;
+		for (i = 0; i < n; ++i)
+		{
+			blendWeights_out[i] = (a3real)weights->weight[i] * s;
+			blendIndices_out[i] = (a3i32)weights->index[i];
+		}
+		return weights->numVertices;
+	}
+	return -1;
+}
+
+// check that every vertex sums to 255 and is sorted
+a3i32 a3skinWeightsValidate(const a3_SkinWeights *weights)
+{
+	if (weights && weights->weight)
+	{
+		const a3ubyte *weight = weights->weight, *index = weights->index;
+		a3ui32 i, k, total;
+		for (i = 0; i < weights->numVertices; ++i, weight += a3skinWeights_influenceMax, index += a3skinWeights_influenceMax)
+		{
+			for (k = total = 0; k < a3skinWeights_influenceMax; ++k)
+			{
+				if ((k && weight[k] > weight[k - 1]) || (!weight[k] && index[k]))
+					return 0;
+				total += weight[k];
+			}
+			if (total != 255)
+				return 0;
+		}
+		return weights->numVertices;
+	}
+	return -1;
+}
+
+// save weights to binary file
+a3i32 a3skinWeightsSaveBinary(const a3_SkinWeights *weights, const a3_FileStream *fileStream)
+{
+	FILE *fp;
+	a3ui32 ret = 0;
+	a3ui32 header[4];
+	if (weights && weights->weight && fileStream)
+	{
+		fp = fileStream->stream;
+		if (fp)
+		{
+			header[0] = a3skinWeights_magic;
+			header[1] = a3skinWeights_version;
+			header[2] = weights->numVertices;
+			header[3] = weights->numInfluences;
+			ret += (a3ui32)fwrite(header, 1, sizeof(header), fp);
+			ret += (a3ui32)fwrite(weights->weight, 1, a3skinWeights_influenceMax * 2 * weights->numVertices, fp);
+		}
+		return ret;
+	}
+	return -1;
+}
+
+// load weights from binary file
+a3i32 a3skinWeightsLoadBinary(a3_SkinWeights *weights_out, const a3_FileStream *fileStream)
+{
+	FILE *fp;
+	a3ui32 ret = 0;
+	a3ui32 header[4];
+	a3ui32 dataSize;
+	if (weights_out && !weights_out->weight && fileStream)
+	{
+		fp = fileStream->stream;
+		if (fp)
+		{
+			ret += (a3ui32)fread(header, 1, sizeof(header), fp);
+			dataSize = a3skinWeights_influenceMax * 2 * header[2];
+			if (ret == sizeof(header) && header[0] == a3skinWeights_magic && header[1] == a3skinWeights_version && header[2] &&
+				(weights_out->weight = (a3ubyte *)malloc(dataSize)) != 0)
+			{
+				weights_out->index = weights_out->weight + a3skinWeights_influenceMax * header[2];
+				weights_out->numVertices = header[2];
+				weights_out->numInfluences = header[3];
+				if (fread(weights_out->weight, 1, dataSize, fp) == dataSize)
+					return (ret + dataSize);
+				a3skinWeightsRelease(weights_out);
+			}
+			printf("\n A3 Warning: Invalid skin weights file.");
+			return 0;
+		}
+		return ret;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
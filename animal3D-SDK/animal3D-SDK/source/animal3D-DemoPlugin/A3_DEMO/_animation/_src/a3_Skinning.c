@@ -0,0 +1,382 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_Skinning.c
+	Implementation of CPU skinning.
+*/
+
+#include "../a3_Skinning.h"
+
+
+//-----------------------------------------------------------------------------
+// SSE is used when reals are single precision and the target has SSE2
+
+#if ((defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__) && !(defined A3_REAL_F64 || defined A3_REAL_F128))
+#define A3_SKINNING_SSE
+#include <emmintrin.h>
+#endif	// SSE2
+
+
+// range of vertices for one worker thread
+typedef struct a3_SkinningRange
+{
+	const a3_SkinningJob *job;
+	a3ui32 first, count;
+} a3_SkinningRange;
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef A3_SKINNING_SSE
+
+// store xyz of vector without touching the fourth lane in memory
+inline void a3skinningInternalStore3(a3real *v_out, const __m128 v)
+{
+	_mm_storel_pi((__m64 *)v_out, v);
+	_mm_store_ss(v_out + 2, _mm_movehl_ps(v, v));
+}
+
+// linear blend skinning with blended matrix columns in SSE registers
+inline void a3skinningInternalLinearBlendSSE(const a3_SkinningJob *job, const a3ui32 first, const a3ui32 count)
+{
+	const a3real *weight = job->blendWeights + first * 4;
+	const a3i32 *index = job->blendIndices + first * 4;
+	const a3ui32 stride = job->outputStride;
+	const a3real *m;
+	a3ui32 i, i3, o, k;
+	a3boolean influenced;
+	__m128 c0, c1, c2, c3, w, v;
+
+	for (i = first, i3 = first * 3, o = first * stride; i < first + count; ++i, i3 += 3, o += stride, weight += 4, index += 4)
+	{
+		// blend matrices
+		c0 = c1 = c2 = c3 = _mm_setzero_ps();
+		for (k = 0, influenced = 0; k < 4; ++k)
+		{
+			if (weight[k] > a3real_zero && index[k] >= 0 && (a3ui32)index[k] < job->paletteSize)
+			{
+				m = job->palette[index[k]].mm;
+				w = _mm_set1_ps(weight[k]);
+				c0 = _mm_add_ps(c0, _mm_mul_ps(w, _mm_loadu_ps(m + 0)));
+				c1 = _mm_add_ps(c1, _mm_mul_ps(w, _mm_loadu_ps(m + 4)));
+				c2 = _mm_add_ps(c2, _mm_mul_ps(w, _mm_loadu_ps(m + 8)));
+				c3 = _mm_add_ps(c3, _mm_mul_ps(w, _mm_loadu_ps(m + 12)));
+				influenced = 1;
+			}
+		}
+		if (!influenced)
+		{
+			c0 = _mm_set_ps(a3real_zero, a3real_zero, a3real_zero, a3real_one);
+			c1 = _mm_set_ps(a3real_zero, a3real_zero, a3real_one, a3real_zero);
+			c2 = _mm_set_ps(a3real_zero, a3real_one, a3real_zero, a3real_zero);
+		}
+
+		// transform
+		v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(job->position[i3 + 0])), _mm_mul_ps(c1, _mm_set1_ps(job->position[i3 + 1]))),
+			_mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(job->position[i3 + 2])), c3));
+		a3skinningInternalStore3(job->position_out + o, v);
+		if (job->normal_out)
+		{
+			v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(job->normal[i3 + 0])), _mm_mul_ps(c1, _mm_set1_ps(job->normal[i3 + 1]))),
+				_mm_mul_ps(c2, _mm_set1_ps(job->normal[i3 + 2])));
+			a3skinningInternalStore3(job->normal_out + o, v);
+		}
+		if (job->tangent_out)
+		{
+			v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(job->tangent[i3 + 0])), _mm_mul_ps(c1, _mm_set1_ps(job->tangent[i3 + 1]))),
+				_mm_mul_ps(c2, _mm_set1_ps(job->tangent[i3 + 2])));
+			a3skinningInternalStore3(job->tangent_out + o, v);
+		}
+		if (job->bitangent_out)
+		{
+			v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(job->bitangent[i3 + 0])), _mm_mul_ps(c1, _mm_set1_ps(job->bitangent[i3 + 1]))),
+				_mm_mul_ps(c2, _mm_set1_ps(job->bitangent[i3 + 2])));
+			a3skinningInternalStore3(job->bitangent_out + o, v);
+		}
+	}
+}
+
+#else	// !A3_SKINNING_SSE
+
+// transform by 3x4 part of column-major matrix
+inline void a3skinningInternalTransform(a3real *v_out, const a3real *c, const a3real *v, const a3real w)
+{
+	v_out[0] = c[0] * v[0] + c[4] * v[1] + c[8] * v[2] + c[12] * w;
+	v_out[1] = c[1] * v[0] + c[5] * v[1] + c[9] * v[2] + c[13] * w;
+	v_out[2] = c[2] * v[0] + c[6] * v[1] + c[10] * v[2] + c[14] * w;
+}
+
+// linear blend skinning, scalar
+inline void a3skinningInternalLinearBlendScalar(const a3_SkinningJob *job, const a3ui32 first, const a3ui32 count)
+{
+	const a3real *weight = job->blendWeights + first * 4;
+	const a3i32 *index = job->blendIndices + first * 4;
+	const a3ui32 stride = job->outputStride;
+	const a3real *m;
+	a3ui32 i, i3, o, k, e;
+	a3boolean influenced;
+	a3real c[16];
+
+	for (i = first, i3 = first * 3, o = first * stride; i < first + count; ++i, i3 += 3, o += stride, weight += 4, index += 4)
+	{
+		// blend matrices
+		for (e = 0; e < 16; ++e)
+			c[e] = a3real_zero;
+		for (k = 0, influenced = 0; k < 4; ++k)
+		{
+			if (weight[k] > a3real_zero && index[k] >= 0 && (a3ui32)index[k] < job->paletteSize)
+			{
+				m = job->palette[index[k]].mm;
+				for (e = 0; e < 16; ++e)
+					c[e] += m[e] * weight[k];
+				influenced = 1;
+			}
+		}
+		if (!influenced)
+			c[0] = c[5] = c[10] = a3real_one;
+
+		// transform
+		a3skinningInternalTransform(job->position_out + o, c, job->position + i3, a3real_one);
+		if (job->normal_out)
+			a3skinningInternalTransform(job->normal_out + o, c, job->normal + i3, a3real_zero);
+		if (job->tangent_out)
+			a3skinningInternalTransform(job->tangent_out + o, c, job->tangent + i3, a3real_zero);
+		if (job->bitangent_out)
+			a3skinningInternalTransform(job->bitangent_out + o, c, job->bitangent + i3, a3real_zero);
+	}
+}
+
+#endif	// A3_SKINNING_SSE
+
+
+// worker thread entry
+a3ret a3skinningInternalThread(void *args)
+{
+	const a3_SkinningRange *range = (const a3_SkinningRange *)args;
+	return a3skinningLinearBlendRange(range->job, range->first, range->count);
+}
+
+
+//-----------------------------------------------------------------------------
+
+// initialize linear blend skinning job
+a3i32 a3skinningJobInit(a3_SkinningJob *job_out, const a3_GeometryData *geom, const a3mat4 *palette, const a3ui32 paletteSize, a3real *position_out, a3real *normal_out_opt, a3real *tangent_out_opt, a3real *bitangent_out_opt, const a3ui32 outputStride)
+{
+	if (job_out && geom && geom->data && palette && paletteSize && position_out && outputStride >= 3 &&
+		geom->attribData[a3attrib_geomPosition] && geom->attribData[a3attrib_geomBlending])
+	{
+		const void *bitangent = 0, *blendIndices = 0;
+		a3geometryGetAddressBitangent(&bitangent, geom);
+		a3geometryGetAddressBlendingInd(&blendIndices, geom);
+		job_out->position = (const a3real *)geom->attribData[a3attrib_geomPosition];
+		job_out->normal = (const a3real *)geom->attribData[a3attrib_geomNormal];
+		job_out->tangent = (const a3real *)geom->attribData[a3attrib_geomTangent];
+		job_out->bitangent = (const a3real *)bitangent;
+		job_out->blendWeights = (const a3real *)geom->attribData[a3attrib_geomBlending];
+		job_out->blendIndices = (const a3i32 *)blendIndices;
+		job_out->numVertices = geom->numVertices;
+		job_out->palette = palette;
+		job_out->paletteSize = paletteSize;
+		job_out->position_out = position_out;
+		job_out->normal_out = job_out->normal ? normal_out_opt : 0;
+		job_out->tangent_out = job_out->tangent ? tangent_out_opt : 0;
+		job_out->bitangent_out = job_out->bitangent ? bitangent_out_opt : 0;
+		job_out->outputStride = outputStride;
+		return geom->numVertices;
+	}
+	return -1;
+}
+
+// linear blend skinning of a range of vertices on the calling thread
+a3i32 a3skinningLinearBlendRange(const a3_SkinningJob *job, const a3ui32 first, const a3ui32 count)
+{
+	if (job && job->position_out && first + count <= job->numVertices)
+	{
+#ifdef A3_SKINNING_SSE
+		a3skinningInternalLinearBlendSSE(job, first, count);
+#else	// !A3_SKINNING_SSE
+		a3skinningInternalLinearBlendScalar(job, first, count);
+#endif	// A3_SKINNING_SSE
+		return count;
+	}
+	return -1;
+}
+
+// linear blend skinning of all vertices over multiple threads
+a3i32 a3skinningLinearBlend(const a3_SkinningJob *job, const a3ui32 numThreads)
+{
+	if (job && job->position_out && numThreads)
+	{
+		a3_Thread thread[a3skinning_threadMax] = { 0 };
+		a3_SkinningRange range[a3skinning_threadMax];
+		a3boolean launched[a3skinning_threadMax];
+		a3ui32 n = numThreads < a3skinning_threadMax ? numThreads : a3skinning_threadMax, i;
+
+		// don't bother with threads for tiny ranges
+		if (n > job->numVertices / 256)
+			n = job->numVertices / 256 + 1;
+
+		for (i = 0; i < n; ++i)
+		{
+			range[i].job = job;
+			range[i].first = (a3ui32)((a3ui64)job->numVertices * i / n);
+			range[i].count = (a3ui32)((a3ui64)job->numVertices * (i + 1) / n) - range[i].first;
+		}
+		// if a thread fails to launch, its range runs here instead
+		for (i = 1; i < n; ++i)
+			if ((launched[i] = (a3threadLaunch(thread + i, a3skinningInternalThread, range + i, 0) > 0)) == 0)
+				a3skinningInternalThread(range + i);
+		a3skinningInternalThread(range);
+		for (i = 1; i < n; ++i)
+			if (launched[i])
+				a3threadWait(thread + i);
+		return job->numVertices;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// blend up to four palette entries for one vertex and normalize; 
+//	returns 0 if the vertex has no valid influence
+inline a3boolean a3skinningInternalBlendDualQuat(a3dualquat *dq_out, const a3dualquat *palette, const a3ui32 paletteSize, const a3real *weight, const a3i32 *index)
+{
+	const a3dualquat *dq, *dq0 = 0;
+	a3real w, lenSq;
+	a3ui32 k;
+
+	dq_out->rx = dq_out->ry = dq_out->rz = dq_out->rw = a3real_zero;
+	dq_out->dx = dq_out->dy = dq_out->dz = dq_out->dw = a3real_zero;
+	for (k = 0; k < 4; ++k)
+	{
+		if (weight[k] > a3real_zero && index[k] >= 0 && (a3ui32)index[k] < paletteSize)
+		{
+			dq = palette + index[k];
+			w = weight[k];
+
+			// keep all influences in the hemisphere of the first
+			if (!dq0)
+				dq0 = dq;
+			else if (dq->rx * dq0->rx + dq->ry * dq0->ry + dq->rz * dq0->rz + dq->rw * dq0->rw < a3real_zero)
+				w = -w;
+
+			dq_out->rx += dq->rx * w;
+			dq_out->ry += dq->ry * w;
+			dq_out->rz += dq->rz * w;
+			dq_out->rw += dq->rw * w;
+			dq_out->dx += dq->dx * w;
+			dq_out->dy += dq->dy * w;
+			dq_out->dz += dq->dz * w;
+			dq_out->dw += dq->dw * w;
+		}
+	}
+
+	lenSq = dq_out->rx * dq_out->rx + dq_out->ry * dq_out->ry + dq_out->rz * dq_out->rz + dq_out->rw * dq_out->rw;
+	if (lenSq > a3real_zero)
+	{
+		w = a3sqrtInverse(lenSq);
+		dq_out->rx *= w;
+		dq_out->ry *= w;
+		dq_out->rz *= w;
+		dq_out->rw *= w;
+		dq_out->dx *= w;
+		dq_out->dy *= w;
+		dq_out->dz *= w;
+		dq_out->dw *= w;
+		return 1;
+	}
+	return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+
+// dual quaternion skinning reference
+a3i32 a3skinningDualQuatReference(a3real *position_out, a3real *normal_out_opt, a3real *tangent_out_opt, a3real *bitangent_out_opt, const a3_GeometryData *geom, const a3dualquat *palette, const a3ui32 paletteSize)
+{
+	if (position_out && geom && geom->data && palette && paletteSize &&
+		geom->attribData[a3attrib_geomPosition] && geom->attribData[a3attrib_geomBlending])
+	{
+		const a3real *position = (const a3real *)geom->attribData[a3attrib_geomPosition];
+		const a3real *normal = (const a3real *)geom->attribData[a3attrib_geomNormal];
+		const a3real *tangent = (const a3real *)geom->attribData[a3attrib_geomTangent];
+		const a3real *bitangent;
+		const a3real *weight = (const a3real *)geom->attribData[a3attrib_geomBlending];
+		const a3i32 *index;
+		const void *address = 0;
+		a3dualquat dq;
+		a3ui32 i, i3;
+
+		a3geometryGetAddressBitangent(&address, geom);
+		bitangent = (const a3real *)address;
+		a3geometryGetAddressBlendingInd(&address, geom);
+		index = (const a3i32 *)address;
+
+		if (!normal)
+			normal_out_opt = 0;
+		if (!tangent)
+			tangent_out_opt = bitangent_out_opt = 0;
+
+		for (i = i3 = 0; i < geom->numVertices; ++i, i3 += 3, weight += 4, index += 4)
+		{
+			if (a3skinningInternalBlendDualQuat(&dq, palette, paletteSize, weight, index))
+			{
+				a3skinningDualQuatTransformPoint(position_out + i3, &dq, position + i3);
+				if (normal_out_opt)
+					a3skinningDualQuatRotateVector(normal_out_opt + i3, &dq, normal + i3);
+				if (tangent_out_opt)
+					a3skinningDualQuatRotateVector(tangent_out_opt + i3, &dq, tangent + i3);
+				if (bitangent_out_opt)
+					a3skinningDualQuatRotateVector(bitangent_out_opt + i3, &dq, bitangent + i3);
+			}
+			else
+			{
+				// no influence: vertex stays in bind pose
+				position_out[i3 + 0] = position[i3 + 0];
+				position_out[i3 + 1] = position[i3 + 1];
+				position_out[i3 + 2] = position[i3 + 2];
+				if (normal_out_opt)
+				{
+					normal_out_opt[i3 + 0] = normal[i3 + 0];
+					normal_out_opt[i3 + 1] = normal[i3 + 1];
+					normal_out_opt[i3 + 2] = normal[i3 + 2];
+				}
+				if (tangent_out_opt)
+				{
+					tangent_out_opt[i3 + 0] = tangent[i3 + 0];
+					tangent_out_opt[i3 + 1] = tangent[i3 + 1];
+					tangent_out_opt[i3 + 2] = tangent[i3 + 2];
+				}
+				if (bitangent_out_opt)
+				{
+					bitangent_out_opt[i3 + 0] = bitangent[i3 + 0];
+					bitangent_out_opt[i3 + 1] = bitangent[i3 + 1];
+					bitangent_out_opt[i3 + 2] = bitangent[i3 + 2];
+				}
+			}
+		}
+		return geom->numVertices;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
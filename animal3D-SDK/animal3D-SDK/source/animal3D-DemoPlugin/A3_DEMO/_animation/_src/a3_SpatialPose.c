@@ -24,9 +24,86 @@
 
 #include "../a3_SpatialPose.h"
 
+#include "../a3_QuaternionBatch.h"
+
+#include <stdlib.h>
+#include <string.h>
+
 
 //-----------------------------------------------------------------------------
 
+// allocate SoA pose storage for a number of node poses, reset to identity
+a3i32 a3spatialPoseSoACreate(a3_SpatialPoseSoA *pose_out, const a3ui32 count)
+{
+	if (pose_out && !pose_out->data && count)
+	{
+		// 10 streams: 4 orientation, 3 translation, 3 scale
+		a3real *stream = (a3real *)malloc(sizeof(a3real) * count * 10);
+		if (stream)
+		{
+			a3ui32 c;
+			pose_out->data = stream;
+			pose_out->count = count;
+			for (c = 0; c < 4; ++c, stream += count)
+				pose_out->orientation[c] = stream;
+			for (c = 0; c < 3; ++c, stream += count)
+				pose_out->translation[c] = stream;
+			for (c = 0; c < 3; ++c, stream += count)
+				pose_out->scale[c] = stream;
+			a3spatialPoseSoAReset(pose_out, 0, count);
+			return count;
+		}
+	}
+	return -1;
+}
+
+// release SoA pose storage
+a3i32 a3spatialPoseSoARelease(a3_SpatialPoseSoA *pose)
+{
+	if (pose && pose->data)
+	{
+		free(pose->data);
+		memset(pose, 0, sizeof(a3_SpatialPoseSoA));
+		return 1;
+	}
+	return -1;
+}
+
+// copy a range of SoA poses
+a3i32 a3spatialPoseSoACopy(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_SpatialPoseSoA *pose_in, const a3ui32 first_in, const a3ui32 count)
+{
+	if (pose_out && pose_out->data && pose_in && pose_in->data && 
+		first_out + count <= pose_out->count && first_in + count <= pose_in->count)
+	{
+		const size_t sz = sizeof(a3real) * count;
+		a3ui32 c;
+		for (c = 0; c < 4; ++c)
+			memmove(pose_out->orientation[c] + first_out, pose_in->orientation[c] + first_in, sz);
+		for (c = 0; c < 3; ++c)
+		{
+			memmove(pose_out->translation[c] + first_out, pose_in->translation[c] + first_in, sz);
+			memmove(pose_out->scale[c] + first_out, pose_in->scale[c] + first_in, sz);
+		}
+		return count;
+	}
+	return -1;
+}
+
+
+// convert a range of SoA poses to transformation matrices (scale, then 
+//	rotate, then translate)
+a3i32 a3spatialPoseSoAConvert(a3mat4 *mat_out, const a3_SpatialPoseSoA *pose, const a3ui32 first, const a3ui32 count)
+{
+	if (mat_out && pose && pose->data && first + count <= pose->count)
+	{
+		const a3real *const q[4] = { pose->orientation[0] + first, pose->orientation[1] + first, pose->orientation[2] + first, pose->orientation[3] + first };
+		const a3real *const t[3] = { pose->translation[0] + first, pose->translation[1] + first, pose->translation[2] + first };
+		const a3real *const s[3] = { pose->scale[0] + first, pose->scale[1] + first, pose->scale[2] + first };
+		a3quatBatchConvertToMat4(mat_out, q, t, s, count);
+		return count;
+	}
+	return -1;
+}
 
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,261 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_TrigBatch.c
+	Implementation of batched polynomial trig functions.
+*/
+
+#include "../a3_TrigBatch.h"
+
+
+//-----------------------------------------------------------------------------
+// vector operations for the selected instruction set
+
+#if (defined A3_TRIGBATCH_AVX)
+typedef __m256 a3trigBatchInternalVec;
+typedef __m256i a3trigBatchInternalVecInt;
+#define a3trigBatchInternalWidth			8
+#define a3trigBatchInternalSet1(x)			_mm256_set1_ps(x)
+#define a3trigBatchInternalLoad(p)			_mm256_loadu_ps(p)
+#define a3trigBatchInternalStore(p, a)		_mm256_storeu_ps(p, a)
+#define a3trigBatchInternalAdd(a, b)		_mm256_add_ps(a, b)
+#define a3trigBatchInternalSub(a, b)		_mm256_sub_ps(a, b)
+#define a3trigBatchInternalMul(a, b)		_mm256_mul_ps(a, b)
+#define a3trigBatchInternalDiv(a, b)		_mm256_div_ps(a, b)
+#define a3trigBatchInternalMin(a, b)		_mm256_min_ps(a, b)
+#define a3trigBatchInternalMax(a, b)		_mm256_max_ps(a, b)
+#define a3trigBatchInternalAnd(a, b)		_mm256_and_ps(a, b)
+#define a3trigBatchInternalAndNot(a, b)		_mm256_andnot_ps(a, b)
+#define a3trigBatchInternalOr(a, b)			_mm256_or_ps(a, b)
+#define a3trigBatchInternalXor(a, b)		_mm256_xor_ps(a, b)
+#define a3trigBatchInternalLess(a, b)		_mm256_cmp_ps(a, b, _CMP_LT_OQ)
+#define a3trigBatchInternalGreater(a, b)	_mm256_cmp_ps(a, b, _CMP_GT_OQ)
+#define a3trigBatchInternalRound(a)			_mm256_cvtps_epi32(a)
+#define a3trigBatchInternalToReal(i)		_mm256_cvtepi32_ps(i)
+#define a3trigBatchInternalCast(i)			_mm256_castsi256_ps(i)
+#define a3trigBatchInternalIntSet1(x)		_mm256_set1_epi32(x)
+#if (defined __AVX2__)
+#define a3trigBatchInternalIntAdd(i, j)		_mm256_add_epi32(i, j)
+#define a3trigBatchInternalIntAnd(i, j)		_mm256_and_si256(i, j)
+#define a3trigBatchInternalIntEqual(i, j)	_mm256_cmpeq_epi32(i, j)
+#define a3trigBatchInternalIntShift(i, n)	_mm256_slli_epi32(i, n)
+#else	// !__AVX2__
+// AVX has no 8-lane integer ops: do the quadrant bits in SSE2 halves
+#define a3trigBatchInternalIntLo(i)			_mm256_castsi256_si128(i)
+#define a3trigBatchInternalIntHi(i)			_mm256_extractf128_si256(i, 1)
+#define a3trigBatchInternalIntJoin(lo, hi)	_mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1)
+#define a3trigBatchInternalIntAdd(i, j)		a3trigBatchInternalIntJoin(_mm_add_epi32(a3trigBatchInternalIntLo(i), a3trigBatchInternalIntLo(j)), _mm_add_epi32(a3trigBatchInternalIntHi(i), a3trigBatchInternalIntHi(j)))
+#define a3trigBatchInternalIntAnd(i, j)		_mm256_castps_si256(_mm256_and_ps(_mm256_castsi256_ps(i), _mm256_castsi256_ps(j)))
+#define a3trigBatchInternalIntEqual(i, j)	a3trigBatchInternalIntJoin(_mm_cmpeq_epi32(a3trigBatchInternalIntLo(i), a3trigBatchInternalIntLo(j)), _mm_cmpeq_epi32(a3trigBatchInternalIntHi(i), a3trigBatchInternalIntHi(j)))
+#define a3trigBatchInternalIntShift(i, n)	a3trigBatchInternalIntJoin(_mm_slli_epi32(a3trigBatchInternalIntLo(i), n), _mm_slli_epi32(a3trigBatchInternalIntHi(i), n))
+#endif	// __AVX2__
+#elif (defined A3_TRIGBATCH_SSE)
+typedef __m128 a3trigBatchInternalVec;
+typedef __m128i a3trigBatchInternalVecInt;
+#define a3trigBatchInternalWidth			4
+#define a3trigBatchInternalSet1(x)			_mm_set1_ps(x)
+#define a3trigBatchInternalLoad(p)			_mm_loadu_ps(p)
+#define a3trigBatchInternalStore(p, a)		_mm_storeu_ps(p, a)
+#define a3trigBatchInternalAdd(a, b)		_mm_add_ps(a, b)
+#define a3trigBatchInternalSub(a, b)		_mm_sub_ps(a, b)
+#define a3trigBatchInternalMul(a, b)		_mm_mul_ps(a, b)
+#define a3trigBatchInternalDiv(a, b)		_mm_div_ps(a, b)
+#define a3trigBatchInternalMin(a, b)		_mm_min_ps(a, b)
+#define a3trigBatchInternalMax(a, b)		_mm_max_ps(a, b)
+#define a3trigBatchInternalAnd(a, b)		_mm_and_ps(a, b)
+#define a3trigBatchInternalAndNot(a, b)		_mm_andnot_ps(a, b)
+#define a3trigBatchInternalOr(a, b)			_mm_or_ps(a, b)
+#define a3trigBatchInternalXor(a, b)		_mm_xor_ps(a, b)
+#define a3trigBatchInternalLess(a, b)		_mm_cmplt_ps(a, b)
+#define a3trigBatchInternalGreater(a, b)	_mm_cmpgt_ps(a, b)
+#define a3trigBatchInternalRound(a)			_mm_cvtps_epi32(a)
+#define a3trigBatchInternalToReal(i)		_mm_cvtepi32_ps(i)
+#define a3trigBatchInternalCast(i)			_mm_castsi128_ps(i)
+#define a3trigBatchInternalIntSet1(x)		_mm_set1_epi32(x)
+#define a3trigBatchInternalIntAdd(i, j)		_mm_add_epi32(i, j)
+#define a3trigBatchInternalIntAnd(i, j)		_mm_and_si128(i, j)
+#define a3trigBatchInternalIntEqual(i, j)	_mm_cmpeq_epi32(i, j)
+#define a3trigBatchInternalIntShift(i, n)	_mm_slli_epi32(i, n)
+#else	// scalar
+#define a3trigBatchInternalWidth			0
+#endif	// AVX, SSE2
+
+// number of values handled by the vector loop
+#if (a3trigBatchInternalWidth)
+#define a3trigBatchInternalMad(a, b, c)		a3trigBatchInternalAdd(a3trigBatchInternalMul(a, b), c)
+#define a3trigBatchInternalSelect(m, a, b)	a3trigBatchInternalOr(a3trigBatchInternalAnd(m, a), a3trigBatchInternalAndNot(m, b))
+#define a3trigBatchInternalVectorCount(count)	((count) / a3trigBatchInternalWidth * a3trigBatchInternalWidth)
+#else	// !a3trigBatchInternalWidth
+#define a3trigBatchInternalVectorCount(count)	0
+#endif	// a3trigBatchInternalWidth
+
+
+//-----------------------------------------------------------------------------
+
+#if (a3trigBatchInternalWidth)
+
+// vector sine and cosine; same steps as a3trigBatchSinCosrScalar
+inline void a3trigBatchInternalSinCos(a3trigBatchInternalVec *sin_out, a3trigBatchInternalVec *cos_out, const a3trigBatchInternalVec x)
+{
+	const a3trigBatchInternalVecInt one = a3trigBatchInternalIntSet1(1), two = a3trigBatchInternalIntSet1(2);
+	const a3trigBatchInternalVecInt k = a3trigBatchInternalRound(a3trigBatchInternalMul(x, a3trigBatchInternalSet1(a3trigBatchInternalTwoOverPi)));
+	const a3trigBatchInternalVec kf = a3trigBatchInternalToReal(k);
+	a3trigBatchInternalVec r, r2, s, c, swap, sinSign, cosSign;
+
+	r = a3trigBatchInternalSub(x, a3trigBatchInternalMul(kf, a3trigBatchInternalSet1(a3trigBatchInternalHalfPi0)));
+	r = a3trigBatchInternalSub(r, a3trigBatchInternalMul(kf, a3trigBatchInternalSet1(a3trigBatchInternalHalfPi1)));
+	r = a3trigBatchInternalSub(r, a3trigBatchInternalMul(kf, a3trigBatchInternalSet1(a3trigBatchInternalHalfPi2)));
+	r2 = a3trigBatchInternalMul(r, r);
+
+	s = a3trigBatchInternalMad(r2, a3trigBatchInternalSet1(a3trigBatchInternalSin7), a3trigBatchInternalSet1(a3trigBatchInternalSin5));
+	s = a3trigBatchInternalMad(r2, s, a3trigBatchInternalSet1(a3trigBatchInternalSin3));
+	s = a3trigBatchInternalMad(a3trigBatchInternalMul(r, r2), s, r);
+	c = a3trigBatchInternalMad(r2, a3trigBatchInternalSet1(a3trigBatchInternalCos8), a3trigBatchInternalSet1(a3trigBatchInternalCos6));
+	c = a3trigBatchInternalMad(r2, c, a3trigBatchInternalSet1(a3trigBatchInternalCos4));
+	c = a3trigBatchInternalMad(a3trigBatchInternalMul(r2, r2), c, a3trigBatchInternalSub(a3trigBatchInternalSet1(a3real_one), a3trigBatchInternalMul(r2, a3trigBatchInternalSet1(a3real_half))));
+
+	// odd quadrants swap sine and cosine; bit 1 of k (and of k+1) is the sign
+	swap = a3trigBatchInternalCast(a3trigBatchInternalIntEqual(a3trigBatchInternalIntAnd(k, one), one));
+	sinSign = a3trigBatchInternalCast(a3trigBatchInternalIntShift(a3trigBatchInternalIntAnd(k, two), 30));
+	cosSign = a3trigBatchInternalCast(a3trigBatchInternalIntShift(a3trigBatchInternalIntAnd(a3trigBatchInternalIntAdd(k, one), two), 30));
+	*sin_out = a3trigBatchInternalXor(a3trigBatchInternalSelect(swap, c, s), sinSign);
+	*cos_out = a3trigBatchInternalXor(a3trigBatchInternalSelect(swap, s, c), cosSign);
+}
+
+// vector arctangent; same steps as a3trigBatchAtan2rScalar
+inline a3trigBatchInternalVec a3trigBatchInternalAtan2(const a3trigBatchInternalVec y, const a3trigBatchInternalVec x)
+{
+	const a3trigBatchInternalVec zero = a3trigBatchInternalSet1(a3real_zero), one = a3trigBatchInternalSet1(a3real_one);
+	const a3trigBatchInternalVec sign = a3trigBatchInternalSet1(-a3real_zero);
+	const a3trigBatchInternalVec ax = a3trigBatchInternalAndNot(sign, x), ay = a3trigBatchInternalAndNot(sign, y);
+	const a3trigBatchInternalVec lo = a3trigBatchInternalMin(ax, ay), hi = a3trigBatchInternalMax(ax, ay);
+	a3trigBatchInternalVec a, a2, p, r, octant;
+
+	// octant reduction
+	a = a3trigBatchInternalAnd(a3trigBatchInternalGreater(hi, zero), a3trigBatchInternalDiv(lo, hi));
+	octant = a3trigBatchInternalGreater(a, a3trigBatchInternalSet1(a3trigBatchInternalTanPi8));
+	a = a3trigBatchInternalSelect(octant, a3trigBatchInternalDiv(a3trigBatchInternalSub(a, one), a3trigBatchInternalAdd(a, one)), a);
+	r = a3trigBatchInternalAnd(octant, a3trigBatchInternalSet1(a3trigBatchInternalQuarterPi));
+	a2 = a3trigBatchInternalMul(a, a);
+	p = a3trigBatchInternalMad(a2, a3trigBatchInternalSet1(a3trigBatchInternalAtan9), a3trigBatchInternalSet1(a3trigBatchInternalAtan7));
+	p = a3trigBatchInternalMad(a2, p, a3trigBatchInternalSet1(a3trigBatchInternalAtan5));
+	p = a3trigBatchInternalMad(a2, p, a3trigBatchInternalSet1(a3trigBatchInternalAtan3));
+	r = a3trigBatchInternalAdd(r, a3trigBatchInternalMad(a3trigBatchInternalMul(a, a2), p, a));
+
+	// undo symmetry
+	r = a3trigBatchInternalSelect(a3trigBatchInternalGreater(ay, ax), a3trigBatchInternalSub(a3trigBatchInternalSet1(a3trigBatchInternalHalfPi), r), r);
+	r = a3trigBatchInternalSelect(a3trigBatchInternalLess(x, zero), a3trigBatchInternalSub(a3trigBatchInternalSet1(a3trigBatchInternalPi), r), r);
+	return a3trigBatchInternalXor(r, a3trigBatchInternalAnd(y, sign));
+}
+
+#endif	// a3trigBatchInternalWidth
+
+
+//-----------------------------------------------------------------------------
+
+// batch sine: sin_out[i] = sin(x[i])
+a3i32 a3trigBatchSinr(a3real *sin_out, const a3real *x, const a3ui32 count)
+{
+	if (sin_out && x)
+	{
+		const a3ui32 countVector = a3trigBatchInternalVectorCount(count);
+		a3real c;
+		a3ui32 i = 0;
+#if (a3trigBatchInternalWidth)
+		a3trigBatchInternalVec vs, vc;
+		for (; i < countVector; i += a3trigBatchInternalWidth)
+		{
+			a3trigBatchInternalSinCos(&vs, &vc, a3trigBatchInternalLoad(x + i));
+			a3trigBatchInternalStore(sin_out + i, vs);
+		}
+#endif	// a3trigBatchInternalWidth
+		for (; i < count; ++i)
+			a3trigBatchSinCosrScalar(sin_out + i, &c, x[i]);
+		return count;
+	}
+	return -1;
+}
+
+// batch cosine: cos_out[i] = cos(x[i])
+a3i32 a3trigBatchCosr(a3real *cos_out, const a3real *x, const a3ui32 count)
+{
+	if (cos_out && x)
+	{
+		const a3ui32 countVector = a3trigBatchInternalVectorCount(count);
+		a3real s;
+		a3ui32 i = 0;
+#if (a3trigBatchInternalWidth)
+		a3trigBatchInternalVec vs, vc;
+		for (; i < countVector; i += a3trigBatchInternalWidth)
+		{
+			a3trigBatchInternalSinCos(&vs, &vc, a3trigBatchInternalLoad(x + i));
+			a3trigBatchInternalStore(cos_out + i, vc);
+		}
+#endif	// a3trigBatchInternalWidth
+		for (; i < count; ++i)
+			a3trigBatchSinCosrScalar(&s, cos_out + i, x[i]);
+		return count;
+	}
+	return -1;
+}
+
+// batch sine and cosine; the two outputs must be different arrays
+a3i32 a3trigBatchSinCosr(a3real *sin_out, a3real *cos_out, const a3real *x, const a3ui32 count)
+{
+	if (sin_out && cos_out && sin_out != cos_out && x)
+	{
+		const a3ui32 countVector = a3trigBatchInternalVectorCount(count);
+		a3ui32 i = 0;
+#if (a3trigBatchInternalWidth)
+		a3trigBatchInternalVec vs, vc;
+		for (; i < countVector; i += a3trigBatchInternalWidth)
+		{
+			a3trigBatchInternalSinCos(&vs, &vc, a3trigBatchInternalLoad(x + i));
+			a3trigBatchInternalStore(sin_out + i, vs);
+			a3trigBatchInternalStore(cos_out + i, vc);
+		}
+#endif	// a3trigBatchInternalWidth
+		for (; i < count; ++i)
+			a3trigBatchSinCosrScalar(sin_out + i, cos_out + i, x[i]);
+		return count;
+	}
+	return -1;
+}
+
+// batch arctangent: out[i] = atan2(y[i], x[i])
+a3i32 a3trigBatchAtan2r(a3real *out, const a3real *y, const a3real *x, const a3ui32 count)
+{
+	if (out && y && x)
+	{
+		const a3ui32 countVector = a3trigBatchInternalVectorCount(count);
+		a3ui32 i = 0;
+#if (a3trigBatchInternalWidth)
+		for (; i < countVector; i += a3trigBatchInternalWidth)
+			a3trigBatchInternalStore(out + i, a3trigBatchInternalAtan2(a3trigBatchInternalLoad(y + i), a3trigBatchInternalLoad(x + i)));
+#endif	// a3trigBatchInternalWidth
+		for (; i < count; ++i)
+			out[i] = a3trigBatchAtan2rScalar(y[i], x[i]);
+		return count;
+	}
+	return -1;
+}
+
+
+//-----------------------------------------------------------------------------
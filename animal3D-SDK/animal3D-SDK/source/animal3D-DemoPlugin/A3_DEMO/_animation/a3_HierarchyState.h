@@ -68,6 +68,12 @@ struct a3_HierarchyPoseGroup
 {
 	// pointer to hierarchy
 	const a3_Hierarchy *hierarchy;
+
+	// local node poses for all hierarchy poses, stored pose-major
+	a3_SpatialPoseSoA pose;
+
+	// number of hierarchy poses
+	a3ui32 poseCount;
 };
 
 
@@ -94,6 +100,10 @@ a3i32 a3hierarchyPoseGroupGetPoseOffsetIndex(const a3_HierarchyPoseGroup *poseGr
 // get offset to single node pose in contiguous set
 a3i32 a3hierarchyPoseGroupGetNodePoseOffsetIndex(const a3_HierarchyPoseGroup *poseGroup, const a3ui32 poseIndex, const a3ui32 nodeIndex);
 
+// load hierarchy and pose group from HTR file; pose 0 is the base pose and 
+//	each frame follows as a full local pose; optionally get frame rate
+a3i32 a3hierarchyPoseGroupLoadHTR(a3_HierarchyPoseGroup *poseGroup_out, a3_Hierarchy *hierarchy_out, const a3byte *resourceFilePath, a3real *frameRate_out_opt);
+
 
 //-----------------------------------------------------------------------------
 
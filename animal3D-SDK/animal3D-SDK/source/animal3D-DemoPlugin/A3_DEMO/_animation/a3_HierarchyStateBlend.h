@@ -41,6 +41,27 @@ extern "C"
 
 //-----------------------------------------------------------------------------
 
+// interpolate a range of SoA poses: orientation uses normalized lerp along 
+//	the shortest arc, translation and scale use lerp
+a3i32 a3spatialPoseSoALerp(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_SpatialPoseSoA *pose0, const a3ui32 first0, const a3_SpatialPoseSoA *pose1, const a3ui32 first1, const a3ui32 count, const a3real u);
+
+// interpolate a range of SoA poses with a Catmull-Rom spline through four 
+//	consecutive keys; orientation uses normalized cubic interpolation with 
+//	each key aligned to the hemisphere of the previous one
+a3i32 a3spatialPoseSoACatmullRom(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_SpatialPoseSoA *posePrev, const a3ui32 firstPrev, const a3_SpatialPoseSoA *pose0, const a3ui32 first0, const a3_SpatialPoseSoA *pose1, const a3ui32 first1, const a3_SpatialPoseSoA *poseNext, const a3ui32 firstNext, const a3ui32 count, const a3real u);
+
+// interpolate a range of SoA poses with a cubic Hermite spline given key 
+//	tangents (derivatives per unit parameter, stored as poses); orientation 
+//	uses normalized cubic interpolation with the second key and its 
+//	tangent aligned to the hemisphere of the first key
+a3i32 a3spatialPoseSoAHermite(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_SpatialPoseSoA *pose0, const a3ui32 first0, const a3_SpatialPoseSoA *pose1, const a3ui32 first1, const a3_SpatialPoseSoA *tangent0, const a3ui32 firstTangent0, const a3_SpatialPoseSoA *tangent1, const a3ui32 firstTangent1, const a3ui32 count, const a3real u);
+
+// sample pose group between two key poses into a full hierarchy pose
+a3i32 a3hierarchyPoseGroupSample(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_HierarchyPoseGroup *poseGroup, const a3ui32 poseIndex0, const a3ui32 poseIndex1, const a3real u);
+
+// sample pose group with a Catmull-Rom spline between two key poses, using 
+//	the keys before and after as neighbors, into a full hierarchy pose
+a3i32 a3hierarchyPoseGroupSampleCubic(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_HierarchyPoseGroup *poseGroup, const a3ui32 poseIndexPrev, const a3ui32 poseIndex0, const a3ui32 poseIndex1, const a3ui32 poseIndexNext, const a3real u);
 
 
 //-----------------------------------------------------------------------------
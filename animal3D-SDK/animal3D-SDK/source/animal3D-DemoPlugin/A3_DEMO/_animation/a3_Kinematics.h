@@ -71,6 +71,40 @@ a3i32 a3kinematicsSolveInverse(const a3_HierarchyState *hierarchyState);
 a3i32 a3kinematicsSolveInversePartial(const a3_HierarchyState *hierarchyState, const a3ui32 firstIndex, const a3ui32 nodeCount);
 
 
+//-----------------------------------------------------------------------------
+
+// batch solvers operating directly on one hierarchy instance; node arrays 
+//	are indexed by node and parents always precede their children
+
+// forward kinematics from local SoA poses starting at 'first': converts 
+//	poses to local matrices and concatenates them to object-space
+a3i32 a3kinematicsSolveForwardSoA(const a3_Hierarchy *hierarchy, a3mat4 *objectMat_out, a3mat4 *localMat_out, const a3_SpatialPoseSoA *localPose, const a3ui32 first);
+
+// inverse kinematics from object-space matrices to local matrices
+a3i32 a3kinematicsSolveInverseMat(const a3_Hierarchy *hierarchy, a3mat4 *localMat_out, const a3mat4 *objectMat);
+
+// skinning palette: object-space * inverse object-space bind pose
+a3i32 a3kinematicsUpdateSkinPalette(a3mat4 *palette_out, const a3mat4 *objectMat, const a3mat4 *objectBindInverse, const a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+// dual quaternion solvers: rigid transforms only (scale is ignored); a 
+//	palette entry is 8 reals instead of 16, half the upload of a matrix
+
+// forward kinematics from local SoA poses starting at 'first' directly to 
+//	unit object-space dual quaternions
+a3i32 a3kinematicsSolveForwardDualQuatSoA(const a3_Hierarchy *hierarchy, a3dualquat *objectDQ_out, const a3_SpatialPoseSoA *localPose, const a3ui32 first);
+
+// dual quaternion skinning palette: object-space * inverse object-space bind 
+//	pose; real parts are made to share a hemisphere with their parent so 
+//	that blending across a joint never takes the long way around
+a3i32 a3kinematicsUpdateSkinPaletteDualQuat(const a3_Hierarchy *hierarchy, a3dualquat *palette_out, const a3dualquat *objectDQ, const a3dualquat *objectBindInverseDQ);
+
+// invert unit dual quaternions (e.g. object-space bind pose to its inverse)
+a3i32 a3kinematicsInvertDualQuat(a3dualquat *dq_out, const a3dualquat *dq, const a3ui32 count);
+
+
 //-----------------------------------------------------------------------------
 
 
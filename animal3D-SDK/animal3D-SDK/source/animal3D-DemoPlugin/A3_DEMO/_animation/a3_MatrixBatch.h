@@ -0,0 +1,94 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_MatrixBatch.h
+	SIMD 4x4 matrix products and transform inverses, single and batched.
+*/
+
+#ifndef __ANIMAL3D_MATRIXBATCH_H
+#define __ANIMAL3D_MATRIXBATCH_H
+
+
+// A3 math library
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+// instruction set is chosen at compile time: AVX when the compiler targets 
+//	it (e.g. /arch:AVX2), otherwise SSE2 (always on x64), otherwise the 
+//	scalar A3DM functions; only single precision reals are vectorized
+#if !(defined A3_REAL_F64 || defined A3_REAL_F128)
+#if (defined __AVX__ || defined __AVX2__)
+#define A3_MATRIXBATCH_AVX
+#include <immintrin.h>
+#endif	// AVX
+#if (defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__)
+#define A3_MATRIXBATCH_SSE
+#include <emmintrin.h>
+#endif	// SSE2
+#endif	// !(A3_REAL_F64 || A3_REAL_F128)
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// general product: m_out = mL * mR; output may alias either input
+a3i32 a3matrixProduct(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR);
+
+// product of affine transforms (bottom row is 0, 0, 0, 1): m_out = mL * mR; 
+//	output may alias either input
+a3i32 a3matrixProductTransform(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR);
+
+// inverse of affine transform with any scale; output may alias input
+a3i32 a3matrixTransformInverse(a3mat4 *m_out, const a3mat4 *m);
+
+// batch general products: m_out[i] = mL[i] * mR[i]
+a3i32 a3matrixProductBatch(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR, const a3ui32 count);
+
+// batch affine products: m_out[i] = mL[i] * mR[i]
+a3i32 a3matrixProductTransformBatch(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR, const a3ui32 count);
+
+// batch affine products with shared left matrix: m_out[i] = mL * mR[i]
+a3i32 a3matrixProductTransformBatchShared(a3mat4 *m_out, const a3mat4 *mL, const a3mat4 *mR, const a3ui32 count);
+
+// batch affine inverses: m_out[i] = inverse(m[i])
+a3i32 a3matrixTransformInverseBatch(a3mat4 *m_out, const a3mat4 *m, const a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_MatrixBatch.inl"
+
+
+#endif	// !__ANIMAL3D_MATRIXBATCH_H
@@ -0,0 +1,188 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_MorphTarget.h
+	Sparse morph targets (blend shapes): per-target deltas stored once, 
+		evaluated on the CPU or read by the GPU from a data texture; 
+		16-bit quantized form for storage.
+*/
+
+#ifndef __ANIMAL3D_MORPHTARGET_H
+#define __ANIMAL3D_MORPHTARGET_H
+
+
+// A3 math
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+// A3 geometry
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+// A3 file stream
+#include "animal3D/a3utility/a3_Stream.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_MorphTargetSet		a3_MorphTargetSet;
+typedef struct a3_MorphTargetPack		a3_MorphTargetPack;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// limits shared with the morphing vertex shader
+enum a3_MorphTargetMax
+{
+	a3morph_targetMax = 64,				// targets per set (MAX_MORPH_TARGETS)
+	a3morph_textureWidth = 1024,		// texels per row of the data texture
+};
+
+
+// set of morph targets sharing one base shape
+// each target stores only the vertices it moves, as (vertex index, delta) 
+//	entries relative to the base; entries are grouped by target so that 
+//	evaluation only touches targets with non-zero weight
+// all vectors are four reals wide (xyz, w unused) so that a vertex or 
+//	delta is a single SIMD load; normal and tangent streams are null if 
+//	the base shape has none
+struct a3_MorphTargetSet
+{
+	// base shape
+	a3real *basePosition, *baseNormal, *baseTangent;
+
+	// entry range per target: target t owns [targetFirst[t], targetFirst[t + 1])
+	a3ui32 *targetFirst;
+
+	// entries
+	a3ui32 *vertexIndex;
+	a3real *deltaPosition, *deltaNormal, *deltaTangent;
+
+	// counts
+	a3ui32 numVertices, numTargets, numEntries;
+
+	// single allocation backing all streams
+	void *data;
+};
+
+
+// quantized morph targets: the entries of a set with every delta stored 
+//	as three 16-bit values against bounds of its target and stream, 
+//	delta = min + q * step, so the error is at most half a step
+// streams are position, then normal and tangent if present; the base 
+//	shape is not included (it is ordinary geometry)
+struct a3_MorphTargetPack
+{
+	// per target and stream: min (xyz, 0) then step (xyz, 0)
+	a3f32 *bounds;
+
+	// entry range per target, as in the set
+	a3ui32 *targetFirst;
+
+	// entries: vertex index and three values per stream
+	a3ui32 *vertexIndex;
+	a3ui16 *delta;
+
+	// counts
+	a3ui32 numVertices, numTargets, numEntries, numStreams;
+
+	// single allocation backing all streams
+	void *data;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// create morph target set from a base shape and full-copy targets with the 
+//	same vertex count and order; a vertex is stored for a target only if 
+//	one of its position, normal or tangent components moves by more than 
+//	the threshold; returns total number of entries
+a3i32 a3morphTargetSetCreate(a3_MorphTargetSet *set_out, const a3_GeometryData *base, const a3_GeometryData *targets, const a3ui32 numTargets, const a3real threshold);
+
+// release morph target set
+a3i32 a3morphTargetSetRelease(a3_MorphTargetSet *set);
+
+// select active targets: those whose weight magnitude exceeds the threshold, 
+//	keeping at most the largest 'maxActive'; outputs target indices and 
+//	their weights ordered by decreasing magnitude; returns active count
+a3i32 a3morphTargetSelectActive(const a3_MorphTargetSet *set, const a3real *weights, const a3real threshold, const a3ui32 maxActive, a3ui32 *active_out, a3real *activeWeight_out);
+
+// add weighted deltas of active targets to vertex streams (four reals per 
+//	vertex); only vertices moved by an active target are touched, with SSE 
+//	where available; optional streams are skipped if null
+a3i32 a3morphTargetAccumulate(const a3_MorphTargetSet *set, const a3ui32 *active, const a3real *activeWeight, const a3ui32 activeCount, a3real *position_inout, a3real *normal_inout_opt, a3real *tangent_inout_opt);
+
+// evaluate morphed shape: copy base to outputs (four reals per vertex), 
+//	then accumulate active targets; normals and tangents are not 
+//	renormalized
+a3i32 a3morphTargetEvaluate(const a3_MorphTargetSet *set, const a3ui32 *active, const a3real *activeWeight, const a3ui32 activeCount, a3real *position_out, a3real *normal_out_opt, a3real *tangent_out_opt);
+
+// get number of rows needed for the data texture at the given width
+a3ui32 a3morphTargetGetTextureHeight(const a3_MorphTargetSet *set, const a3ui32 width);
+
+// fill RGBA float data texture (width * height texels) for the GPU path; 
+//	entries are regrouped by vertex so a vertex shader finds its own:
+//	-> texel v: first entry texel and entry count for vertex v
+//	-> three texels per entry: position delta and target index, normal 
+//		delta, tangent delta
+// returns number of texels used
+a3i32 a3morphTargetStoreTexture(const a3_MorphTargetSet *set, a3f32 *texels_out, const a3ui32 width);
+
+
+//-----------------------------------------------------------------------------
+
+// quantize sparse morph target set; returns number of entries
+a3i32 a3morphTargetPackCreate(a3_MorphTargetPack *pack_out, const a3_MorphTargetSet *set);
+
+// release quantized morph targets
+a3i32 a3morphTargetPackRelease(a3_MorphTargetPack *pack);
+
+// scatter-add weighted, dequantized deltas of active targets to vertex 
+//	streams (four reals per vertex), with SSE where available; optional 
+//	streams are skipped if null
+a3i32 a3morphTargetPackAccumulate(const a3_MorphTargetPack *pack, const a3ui32 *active, const a3real *activeWeight, const a3ui32 activeCount, a3real *position_inout, a3real *normal_inout_opt, a3real *tangent_inout_opt);
+
+// create sparse morph target set from base shape and quantized targets 
+//	(e.g. to build the data texture); base must match the pack's vertex 
+//	count and streams; returns number of entries
+a3i32 a3morphTargetSetCreatePack(a3_MorphTargetSet *set_out, const a3_GeometryData *base, const a3_MorphTargetPack *pack);
+
+// save quantized morph targets to binary file
+a3i32 a3morphTargetPackSaveBinary(const a3_MorphTargetPack *pack, const a3_FileStream *fileStream);
+
+// load quantized morph targets from binary file
+a3i32 a3morphTargetPackLoadBinary(a3_MorphTargetPack *pack_out, const a3_FileStream *fileStream);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_MorphTarget.inl"
+
+
+#endif	// !__ANIMAL3D_MORPHTARGET_H
@@ -0,0 +1,142 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_PathFollow.h
+	Spline paths with cached arc length tables and cursors that move along 
+		them at constant speed.
+*/
+
+#ifndef __ANIMAL3D_PATHFOLLOW_H
+#define __ANIMAL3D_PATHFOLLOW_H
+
+
+// A3 math library
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef enum a3_PathCurve				a3_PathCurve;
+typedef struct a3_Path					a3_Path;
+typedef struct a3_PathCursor			a3_PathCursor;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// curve type used by every segment of a path; describes control layout
+enum a3_PathCurve
+{
+	a3path_CatmullRom,		// points passed through; ends use the end points as neighbors
+	a3path_HermiteTangent,	// pairs of point followed by its tangent
+	a3path_Bezier3,			// cubic segments sharing end points: p0 c0 c1 p1 c2 c3 p2...
+};
+
+
+// path through control vectors
+// arc length is tabled when the path is created: each segment is sampled 
+//	at a fixed number of divisions and the tables are shared by all segments, 
+//	with the parameter table holding segment index plus local parameter
+struct a3_Path
+{
+	// copy of control vectors
+	a3vec3 *control;
+
+	// sample tables, (numSegments * numDivisions + 1) entries each
+	a3real3 *sampleTable;
+	a3real *paramTable;
+	a3real *arclenTable;
+
+	// total length
+	a3real length;
+
+	// curve type, whether the last point connects back to the first
+	a3_PathCurve curve;
+	a3boolean loop;
+
+	// counts
+	a3ui32 numControls;
+	a3ui32 numSegments;
+	a3ui32 numDivisions;
+	a3ui32 numSamples;
+
+	// single allocation backing all arrays
+	void *data;
+};
+
+
+// position along a path by distance
+// the cursor remembers the table index it last found, so moving by small 
+//	steps only walks a sample or two; looping paths wrap, others clamp
+struct a3_PathCursor
+{
+	// path followed
+	const a3_Path *path;
+
+	// distance from start of path
+	a3real distance;
+
+	// index of the sample ending the current table interval
+	a3ui32 index;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// create path from control vectors (see a3_PathCurve for layout); each 
+//	segment's arc length is tabled with the given number of divisions
+a3i32 a3pathCreate(a3_Path *path_out, const a3_PathCurve curve, const a3vec3 *controls, const a3ui32 numControls, const a3boolean loop, const a3ui32 numDivisions);
+
+// release path
+a3i32 a3pathRelease(a3_Path *path);
+
+// evaluate path at segment index plus local parameter
+a3i32 a3pathEvaluate(const a3_Path *path, a3real3p position_out, const a3real param);
+
+// get total length of path
+a3real a3pathGetLength(const a3_Path *path);
+
+// initialize cursor on path at distance
+a3i32 a3pathCursorInit(a3_PathCursor *cursor_out, const a3_Path *path, const a3real distance);
+
+// move cursor to distance and evaluate position and optional unit forward 
+//	direction of the path; returns segment index
+a3i32 a3pathCursorSetDistance(a3_PathCursor *cursor, const a3real distance, a3real3p position_out, a3real3p direction_out_opt);
+
+// move cursor by a (signed) distance and evaluate; returns segment index
+a3i32 a3pathCursorAdvance(a3_PathCursor *cursor, const a3real delta, a3real3p position_out, a3real3p direction_out_opt);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_PathFollow.inl"
+
+
+#endif	// !__ANIMAL3D_PATHFOLLOW_H
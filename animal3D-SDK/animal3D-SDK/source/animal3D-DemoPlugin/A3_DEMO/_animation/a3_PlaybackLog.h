@@ -0,0 +1,139 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_PlaybackLog.h
+	Record and replay of animation controller inputs for reproducing
+		playback offline.
+*/
+
+#ifndef __ANIMAL3D_PLAYBACKLOG_H
+#define __ANIMAL3D_PLAYBACKLOG_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3utility/a3_Stream.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef enum a3_PlaybackEventType		a3_PlaybackEventType;
+typedef struct a3_PlaybackEvent			a3_PlaybackEvent;
+typedef struct a3_PlaybackLog			a3_PlaybackLog;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// types of recorded inputs
+enum a3_PlaybackEventType
+{
+	a3playbackEvent_frame,				// start of frame with time step
+	a3playbackEvent_clip,				// controller switches clip
+	a3playbackEvent_rate,				// controller changes playback rate
+};
+
+
+// single recorded input (8 bytes with float reals); values are stored 
+//	bit-exact, and files hold them as f64 so logs are portable between 
+//	float and double builds
+struct a3_PlaybackEvent
+{
+	a3ubyte type;
+	a3ubyte reserved;
+	a3ui16 controllerIndex;
+	union {
+		a3real dt;
+		a3real rate;
+		a3ui32 clipIndex;
+	};
+};
+
+
+// log of inputs in order of recording
+// events that follow a frame event belong to that frame
+struct a3_PlaybackLog
+{
+	// events
+	a3_PlaybackEvent *event;
+	a3ui32 count;
+	a3ui32 capacity;
+
+	// replay position
+	a3ui32 cursor;
+
+	// number of frame events
+	a3ui32 numFrames;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// allocate log with initial capacity in events; grows when recording
+a3i32 a3playbackLogCreate(a3_PlaybackLog *log_out, const a3ui32 capacity);
+
+// release log
+a3i32 a3playbackLogRelease(a3_PlaybackLog *log);
+
+// record start of frame; returns number of frames, 0 if it could not be 
+//	stored
+a3i32 a3playbackLogRecordFrame(a3_PlaybackLog *log, const a3real dt);
+
+// record clip switch
+a3i32 a3playbackLogRecordClip(a3_PlaybackLog *log, const a3ui32 controllerIndex, const a3ui32 clipIndex);
+
+// record playback rate change
+a3i32 a3playbackLogRecordRate(a3_PlaybackLog *log, const a3ui32 controllerIndex, const a3real rate);
+
+// reset replay position to first event
+a3i32 a3playbackLogRewind(a3_PlaybackLog *log);
+
+// get next event in replay; returns 1 if event, 0 if done
+a3i32 a3playbackLogReplayEvent(a3_PlaybackLog *log, a3_PlaybackEvent *event_out);
+
+// advance replay by one frame: outputs the frame's time step, copies up to 
+//	'maxEvents' of its controller events and counts them; events beyond 
+//	the maximum are skipped; returns 1 if frame replayed, 0 if done
+a3i32 a3playbackLogReplayFrame(a3_PlaybackLog *log, a3real *dt_out, a3_PlaybackEvent *events_out_opt, a3ui32 *numEvents_out_opt, const a3ui32 maxEvents);
+
+// save log to binary file
+a3i32 a3playbackLogSaveBinary(const a3_PlaybackLog *log, const a3_FileStream *fileStream);
+
+// load log from binary file; rejects logs whose counts do not match the 
+//	file size or that contain unknown events
+a3i32 a3playbackLogLoadBinary(a3_PlaybackLog *log, const a3_FileStream *fileStream);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_PlaybackLog.inl"
+
+
+#endif	// !__ANIMAL3D_PLAYBACKLOG_H
@@ -0,0 +1,149 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_PoseCache.h
+	Cache of sampled local poses shared by characters playing the same clip
+		at the same (quantized) time.
+*/
+
+#ifndef __ANIMAL3D_POSECACHE_H
+#define __ANIMAL3D_POSECACHE_H
+
+
+// A3 hierarchy state
+#include "a3_HierarchyState.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_PoseCacheKey			a3_PoseCacheKey;
+typedef struct a3_PoseCacheEntry		a3_PoseCacheEntry;
+typedef struct a3_PoseCache				a3_PoseCache;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// identifies one sampled pose
+struct a3_PoseCacheKey
+{
+	// pose group the clip samples from
+	const a3_HierarchyPoseGroup *poseGroup;
+
+	// clip index in pool
+	a3ui32 clipIndex;
+
+	// sample time in ticks (see a3poseCacheQuantizeTime)
+	a3i32 timeTick;
+};
+
+
+// single cached pose; its node poses live in the cache's pose streams
+struct a3_PoseCacheEntry
+{
+	a3_PoseCacheKey key;
+
+	// last frame this entry was stored or read
+	volatile a3ui32 lastUsedFrame;
+};
+
+
+// pose cache
+// the cache has two phases per frame:
+//	-> a3poseCacheBeginFrame runs on a single thread and is the only place
+//		entries are evicted, oldest frames first (LRU per frame)
+//	-> while jobs run, any number of threads may call a3poseCacheLookup and
+//		a3poseCacheStore; lookups never lock or wait, and an entry is only
+//		published to the table after its pose has been written completely
+struct a3_PoseCache
+{
+	// entries and their pose storage: entry i owns nodes [i*numNodes, (i+1)*numNodes)
+	a3_PoseCacheEntry *entry;
+	a3_SpatialPoseSoA pose;
+
+	// open-addressed table of entry indices (-1 if empty); power of two size
+	volatile a3i32 *table;
+	a3ui32 tableMask;
+
+	// free entry indices, consumed from the front during the frame
+	a3i32 *freeList;
+	a3ui32 freeCount;
+	volatile a3i32 freeHead;
+
+	// capacity in poses and nodes per pose
+	a3ui32 capacity;
+	a3ui32 numNodes;
+
+	// time quantization and current frame
+	a3real ticksPerSecond;
+	a3ui32 frame;
+
+	// minimum number of entries kept free at the start of each frame
+	a3ui32 reserve;
+
+	// evictor's sort keys; first in the allocation, which keeps them aligned
+	a3ui64 *recent;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// create pose cache for a hierarchy given capacity in poses and time
+//	quantization rate (e.g. 120 ticks per second)
+a3i32 a3poseCacheCreate(a3_PoseCache *cache_out, const a3_Hierarchy *hierarchy, const a3ui32 capacity, const a3real ticksPerSecond);
+
+// release pose cache
+a3i32 a3poseCacheRelease(a3_PoseCache *cache);
+
+// advance frame, evicting least-recently-used entries so that the reserve
+//	is free; must not run concurrently with lookups or stores
+a3i32 a3poseCacheBeginFrame(a3_PoseCache *cache);
+
+// convert sample time to ticks
+a3i32 a3poseCacheQuantizeTime(const a3_PoseCache *cache, const a3real time);
+
+// make key
+a3i32 a3poseCacheKeyInit(a3_PoseCacheKey *key_out, const a3_HierarchyPoseGroup *poseGroup, const a3ui32 clipIndex, const a3i32 timeTick);
+
+// look up pose and copy it to the output streams at the first node index;
+//	returns 1 if found, 0 if not found
+a3i32 a3poseCacheLookup(const a3_PoseCache *cache, const a3_PoseCacheKey *key, a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out);
+
+// store pose read from the input streams at the first node index;
+//	returns 1 if stored, 0 if already present or cache is full this frame
+a3i32 a3poseCacheStore(a3_PoseCache *cache, const a3_PoseCacheKey *key, const a3_SpatialPoseSoA *pose_in, const a3ui32 first_in);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_PoseCache.inl"
+
+
+#endif	// !__ANIMAL3D_POSECACHE_H
@@ -0,0 +1,108 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_QuaternionBatch.h
+	Quaternion operations over arrays stored as separate x, y, z, w streams.
+*/
+
+#ifndef __ANIMAL3D_QUATERNIONBATCH_H
+#define __ANIMAL3D_QUATERNIONBATCH_H
+
+
+// A3 math library
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+// instruction set is chosen at compile time: AVX when the compiler targets 
+//	it (8 lanes), otherwise SSE2 (4 lanes, always on x64), otherwise scalar; 
+//	only single precision reals are vectorized
+#if !(defined A3_REAL_F64 || defined A3_REAL_F128)
+#if (defined __AVX__ || defined __AVX2__)
+#define A3_QUATERNIONBATCH_AVX
+#include <immintrin.h>
+#elif (defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__)
+#define A3_QUATERNIONBATCH_SSE
+#include <emmintrin.h>
+#endif	// AVX, SSE2
+#endif	// !(A3_REAL_F64 || A3_REAL_F128)
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// all kernels take quaternions as four component streams (x, y, z, w) and 
+//	process one vector of quaternions per step, with a scalar tail; 
+//	outputs may be the same streams as inputs
+// interpolating kernels take the shortest arc
+
+// product: q_out = qL * qR
+a3i32 a3quatBatchProduct(a3real *const q_out[4], const a3real *const qL[4], const a3real *const qR[4], const a3ui32 count);
+
+// normalized linear interpolation
+a3i32 a3quatBatchNlerp(a3real *const q_out[4], const a3real *const q0[4], const a3real *const q1[4], const a3ui32 count, const a3real u);
+
+// approximate spherical interpolation: normalized linear interpolation 
+//	with the parameter corrected for the angle between inputs (see 
+//	a3quatBatchCorrectParam); much cheaper than slerp and visually equivalent
+a3i32 a3quatBatchSlerpApprox(a3real *const q_out[4], const a3real *const q0[4], const a3real *const q1[4], const a3ui32 count, const a3real u);
+
+// spherical linear interpolation of unit quaternions; uses the stateless 
+//	trig functions in a3_TrigBatch.h
+a3i32 a3quatBatchSlerp(a3real *const q_out[4], const a3real *const q0[4], const a3real *const q1[4], const a3ui32 count, const a3real u);
+
+// convert unit quaternions to matrices with optional per-axis scale 
+//	(applied first) and optional translation (applied last)
+a3i32 a3quatBatchConvertToMat4(a3mat4 *m_out, const a3real *const q[4], const a3real *const translate_opt[3], const a3real *const scale_opt[3], const a3ui32 count);
+
+// convert Euler angles in degrees, given as x, y and z angle streams, to 
+//	quaternions; XYZ order rotates about X first, ZYX about Z first (same 
+//	as a3quatSetEulerXYZ and a3quatSetEulerZYX); outputs may be the same 
+//	streams as the angles
+a3i32 a3quatBatchSetEuler(a3real *const q_out[4], const a3real *const eulerDegrees[3], const a3ui32 count, const a3boolean orderZYX);
+
+// convert Euler angles in degrees to rotation matrices
+a3i32 a3quatBatchConvertEulerToMat4(a3mat4 *m_out, const a3real *const eulerDegrees[3], const a3ui32 count, const a3boolean orderZYX);
+
+// nlerp parameter correction for the absolute cosine of the angle between 
+//	two unit quaternions; keeps the error against slerp well under 0.001
+a3real a3quatBatchCorrectParam(const a3real cosAngle, const a3real u);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_QuaternionBatch.inl"
+
+
+#endif	// !__ANIMAL3D_QUATERNIONBATCH_H
@@ -0,0 +1,137 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_Retarget.h
+	Skeleton retargeting: maps the nodes of a source hierarchy onto a
+		target hierarchy and transfers poses between them.
+*/
+
+#ifndef __ANIMAL3D_RETARGET_H
+#define __ANIMAL3D_RETARGET_H
+
+
+// A3 hierarchy
+#include "a3_Hierarchy.h"
+
+// A3 spatial pose
+#include "a3_SpatialPose.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef enum a3_RetargetRuleType		a3_RetargetRuleType;
+typedef struct a3_RetargetRule			a3_RetargetRule;
+typedef struct a3_RetargetMap			a3_RetargetMap;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// types of name-matching rules
+enum a3_RetargetRuleType
+{
+	a3retargetRule_rename,				// source node named 'a' drives target node named 'b'
+	a3retargetRule_prefix,				// prefix 'a' is stripped from source names before matching
+	a3retargetRule_prefixTarget,		// prefix 'a' is stripped from target names before matching
+	a3retargetRule_ignore,				// target node named 'a' is never mapped (keeps rest pose)
+};
+
+
+// single name-matching rule; rules are applied in order before the
+//	default exact-name match
+struct a3_RetargetRule
+{
+	a3_RetargetRuleType type;
+	const a3byte *a;
+	const a3byte *b;
+};
+
+
+// retargeting map from source hierarchy to target hierarchy
+// all per-node corrections are computed once on creation so that the
+//	per-frame transfer is a single pass with no name lookups or matrix work
+struct a3_RetargetMap
+{
+	// hierarchies
+	const a3_Hierarchy *source;
+	const a3_Hierarchy *target;
+
+	// source node index per target node (-1 if unmapped)
+	a3i32 *sourceIndex;
+
+	// rotation corrections per target node (quaternion streams):
+	//	target = preRotation * source * postRotation
+	a3real *preRotation[4];
+	a3real *postRotation[4];
+
+	// rest translations per target node and its mapped source node
+	a3real *targetRestTranslation[3];
+	a3real *sourceRestTranslation[3];
+
+	// uniform scale applied to translation offsets from rest
+	a3real *translationRatio;
+
+	// scale ratio per target node (target rest / source rest)
+	a3real *scaleRatio[3];
+
+	// target rest orientation for unmapped nodes
+	a3real *targetRestOrientation[4];
+
+	// number of mapped nodes
+	a3ui32 numMapped;
+
+	// single allocation backing all streams
+	void *data;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// create retargeting map given both hierarchies, their rest (bind) poses
+//	in local space and an optional list of name-matching rules
+a3i32 a3retargetMapCreate(a3_RetargetMap *map_out, const a3_Hierarchy *target, const a3_SpatialPoseSoA *targetRest, const a3_Hierarchy *source, const a3_SpatialPoseSoA *sourceRest, const a3_RetargetRule *rules_opt, const a3ui32 ruleCount);
+
+// release retargeting map
+a3i32 a3retargetMapRelease(a3_RetargetMap *map);
+
+// get source node index mapped to target node
+a3i32 a3retargetMapGetSourceIndex(const a3_RetargetMap *map, const a3ui32 targetIndex);
+
+// transfer local poses from source to target for a number of characters;
+//	poses are stored pose-major, one full hierarchy per character
+a3i32 a3retargetPoseTransfer(const a3_RetargetMap *map, a3_SpatialPoseSoA const *pose_out, const a3_SpatialPoseSoA *pose_in, const a3ui32 poseCount);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_Retarget.inl"
+
+
+#endif	// !__ANIMAL3D_RETARGET_H
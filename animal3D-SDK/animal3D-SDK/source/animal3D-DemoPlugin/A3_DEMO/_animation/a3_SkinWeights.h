@@ -0,0 +1,115 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_SkinWeights.h
+	Compact skin weights: streaming import from Maya deformerWeight XML, 
+		top-k influence selection and 8-bit quantization.
+*/
+
+#ifndef __ANIMAL3D_SKINWEIGHTS_H
+#define __ANIMAL3D_SKINWEIGHTS_H
+
+
+#include "animal3D/a3/a3types_integer.h"
+#include "animal3D/a3/a3types_real.h"
+#include "animal3D/a3/a3macros.h"
+#include "animal3D/a3utility/a3_Stream.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_SkinWeights			a3_SkinWeights;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// maximum influences kept per vertex (one vec4 of weights and indices)
+enum a3_SkinWeightsInfluenceMax
+{
+	a3skinWeights_influenceMax = 4,
+};
+
+
+// per-vertex skin weights, 8 bytes per vertex: 4 quantized weights that 
+//	sum to 255 followed by 4 influence indices; unused slots have zero 
+//	weight and index zero; weights are sorted from largest to smallest
+// vertices are indexed as in the source file (Maya point index)
+struct a3_SkinWeights
+{
+	// weights and indices, 4 of each per vertex
+	a3ubyte *weight;
+	a3ubyte *index;
+
+	// vertex count and number of distinct influences
+	a3ui32 numVertices;
+	a3ui32 numInfluences;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// load weights from Maya deformerWeight XML; the file is streamed once, 
+//	keeping only the 'maxInfluences' (1-4) largest weights per vertex, which 
+//	are then renormalized and quantized
+// influence indices are the skin cluster layers unless a list of names 
+//	(e.g. hierarchy node names) is given, in which case each influence is 
+//	the index of its name in the list and unlisted influences are dropped
+// returns number of vertices, 0 if the file could not be read
+a3i32 a3skinWeightsLoadDeformerXML(a3_SkinWeights *weights_out, const a3byte *filePath, const a3ui32 maxInfluences, const a3byte *influenceNames_opt[], const a3ui32 numInfluenceNames);
+
+// release weights
+a3i32 a3skinWeightsRelease(a3_SkinWeights *weights);
+
+// expand to the geometry blending layout: 4 real weights per vertex and 
+//	4 integer indices per vertex
+a3i32 a3skinWeightsDecode(const a3_SkinWeights *weights, a3real *blendWeights_out, a3i32 *blendIndices_out);
+
+// check that every vertex's weights sum to 255 and are sorted from largest 
+//	to smallest, with index zero in unused slots
+// returns number of vertices, 0 if any vertex breaks the layout
+a3i32 a3skinWeightsValidate(const a3_SkinWeights *weights);
+
+// get weight of slot for vertex as real
+a3real a3skinWeightsGetWeight(const a3_SkinWeights *weights, const a3ui32 vertexIndex, const a3ui32 slot);
+
+// save weights to binary file (e.g. after geometry in the geometry cache)
+a3i32 a3skinWeightsSaveBinary(const a3_SkinWeights *weights, const a3_FileStream *fileStream);
+
+// load weights from binary file
+a3i32 a3skinWeightsLoadBinary(a3_SkinWeights *weights_out, const a3_FileStream *fileStream);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_SkinWeights.inl"
+
+
+#endif	// !__ANIMAL3D_SKINWEIGHTS_H
@@ -0,0 +1,128 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_Skinning.h
+	CPU skinning of geometry with blend weights and indices.
+*/
+
+#ifndef __ANIMAL3D_SKINNING_H
+#define __ANIMAL3D_SKINNING_H
+
+
+// A3 math
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+// A3 geometry
+#include "animal3D/a3geometry/a3_GeometryData.h"
+
+// A3 threads
+#include "animal3D/a3utility/a3_Thread.h"
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+typedef struct a3_SkinningJob			a3_SkinningJob;
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// maximum number of threads used by a single skinning call
+enum a3_SkinningThreadMax
+{
+	a3skinning_threadMax = 32
+};
+
+
+// linear blend skinning job: geometry with blending, matrix palette 
+//	(object-space * inverse bind, see a3kinematicsUpdateSkinPalette) and 
+//	caller-owned output streams
+// outputs are written 'outputStride' reals apart (3 for tightly packed 
+//	vec3, more to write straight into an interleaved vertex buffer); 
+//	normal, tangent and bitangent outputs are optional
+struct a3_SkinningJob
+{
+	// inputs
+	const a3real *position, *normal, *tangent, *bitangent;
+	const a3real *blendWeights;
+	const a3i32 *blendIndices;
+	a3ui32 numVertices;
+
+	// palette
+	const a3mat4 *palette;
+	a3ui32 paletteSize;
+
+	// outputs
+	a3real *position_out, *normal_out, *tangent_out, *bitangent_out;
+	a3ui32 outputStride;
+};
+
+
+//-----------------------------------------------------------------------------
+
+// initialize linear blend skinning job; geometry must have positions and 
+//	blending; outputs for attributes missing from the geometry are ignored
+a3i32 a3skinningJobInit(a3_SkinningJob *job_out, const a3_GeometryData *geom, const a3mat4 *palette, const a3ui32 paletteSize, a3real *position_out, a3real *normal_out_opt, a3real *tangent_out_opt, a3real *bitangent_out_opt, const a3ui32 outputStride);
+
+// linear blend skinning of a range of vertices on the calling thread; 
+//	ranges do not overlap in output, so any scheduler may run them in 
+//	parallel; vertices are processed with SSE where available
+// normals and tangents are transformed by the blended matrix and are not 
+//	renormalized; vertices without a valid influence keep their bind pose
+a3i32 a3skinningLinearBlendRange(const a3_SkinningJob *job, const a3ui32 first, const a3ui32 count);
+
+// linear blend skinning of all vertices, split into equal ranges over 
+//	up to a3skinning_threadMax threads (the calling thread runs the first)
+a3i32 a3skinningLinearBlend(const a3_SkinningJob *job, const a3ui32 numThreads);
+
+
+//-----------------------------------------------------------------------------
+
+// dual quaternion skinning reference: for each vertex, the palette entries 
+//	named by its blend indices are blended (DLB) and the result transforms 
+//	the position and rotates the tangent basis; outputs are tightly packed 
+//	vec3 streams, optional outputs are skipped if null or missing in input
+// geometry must have positions and blending; blend indices outside the 
+//	palette are ignored; returns number of vertices skinned
+a3i32 a3skinningDualQuatReference(a3real *position_out, a3real *normal_out_opt, a3real *tangent_out_opt, a3real *bitangent_out_opt, const a3_GeometryData *geom, const a3dualquat *palette, const a3ui32 paletteSize);
+
+// transform point by unit dual quaternion
+a3real *a3skinningDualQuatTransformPoint(a3real *p_out, const a3dualquat *dq, const a3real *p);
+
+// rotate vector by unit dual quaternion
+a3real *a3skinningDualQuatRotateVector(a3real *v_out, const a3dualquat *dq, const a3real *v);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_Skinning.inl"
+
+
+#endif	// !__ANIMAL3D_SKINNING_H
@@ -38,6 +38,7 @@ extern "C"
 #else	// !__cplusplus
 typedef enum a3_SpatialPoseChannel		a3_SpatialPoseChannel;
 typedef struct a3_SpatialPose			a3_SpatialPose;
+typedef struct a3_SpatialPoseSoA		a3_SpatialPoseSoA;
 #endif	// __cplusplus
 	
 
@@ -61,8 +62,46 @@ struct a3_SpatialPose
 };
 
 
+// structure-of-arrays pose storage for many node poses
+// each channel is split into one contiguous stream per component so that 
+//	batch operations can process consecutive poses with wide registers
+// poses for multiple hierarchies are stored pose-major: [pose][node]
+struct a3_SpatialPoseSoA
+{
+	// rotation as unit quaternion streams (x, y, z, w)
+	a3real *orientation[4];
+
+	// translation streams (x, y, z)
+	a3real *translation[3];
+
+	// scale streams (x, y, z)
+	a3real *scale[3];
+
+	// number of poses in each stream
+	a3ui32 count;
+
+	// single allocation backing all streams
+	a3real *data;
+};
+
+
 //-----------------------------------------------------------------------------
 
+// allocate SoA pose storage for a number of node poses, reset to identity
+a3i32 a3spatialPoseSoACreate(a3_SpatialPoseSoA *pose_out, const a3ui32 count);
+
+// release SoA pose storage
+a3i32 a3spatialPoseSoARelease(a3_SpatialPoseSoA *pose);
+
+// reset a range of SoA poses to identity
+a3i32 a3spatialPoseSoAReset(a3_SpatialPoseSoA const *pose, const a3ui32 first, const a3ui32 count);
+
+// copy a range of SoA poses
+a3i32 a3spatialPoseSoACopy(a3_SpatialPoseSoA const *pose_out, const a3ui32 first_out, const a3_SpatialPoseSoA *pose_in, const a3ui32 first_in, const a3ui32 count);
+
+// convert a range of SoA poses to transformation matrices (scale, then 
+//	rotate, then translate)
+a3i32 a3spatialPoseSoAConvert(a3mat4 *mat_out, const a3_SpatialPoseSoA *pose, const a3ui32 first, const a3ui32 count);
 
 
 //-----------------------------------------------------------------------------
@@ -0,0 +1,99 @@
+/*
+	Copyright 2011-2020 Daniel S. Buckstein
+
+	Licensed under the Apache License, Version 2.0 (the "License");
+	you may not use this file except in compliance with the License.
+	You may obtain a copy of the License at
+
+		http://www.apache.org/licenses/LICENSE-2.0
+
+	Unless required by applicable law or agreed to in writing, software
+	distributed under the License is distributed on an "AS IS" BASIS,
+	WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+	See the License for the specific language governing permissions and
+	limitations under the License.
+*/
+
+/*
+	animal3D SDK: Minimal 3D Animation Framework
+	By Daniel S. Buckstein
+	
+	a3_TrigBatch.h
+	Stateless polynomial sine, cosine and arctangent, single and batched.
+*/
+
+#ifndef __ANIMAL3D_TRIGBATCH_H
+#define __ANIMAL3D_TRIGBATCH_H
+
+
+// A3 math library
+#include "animal3D-A3DM/animal3D-A3DM.h"
+
+
+// instruction set is chosen at compile time: AVX when the compiler targets 
+//	it (8 lanes), otherwise SSE2 (4 lanes, always on x64), otherwise scalar; 
+//	only single precision reals are vectorized; same choice as the 
+//	quaternion and matrix batches, so a batch runs one width throughout
+#if !(defined A3_REAL_F64 || defined A3_REAL_F128)
+#if (defined __AVX__ || defined __AVX2__)
+#define A3_TRIGBATCH_AVX
+#include <immintrin.h>
+#elif (defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2) || defined __SSE2__)
+#define A3_TRIGBATCH_SSE
+#include <emmintrin.h>
+#endif	// AVX, SSE2
+#endif	// !(A3_REAL_F64 || A3_REAL_F128)
+
+
+//-----------------------------------------------------------------------------
+
+#ifdef __cplusplus
+extern "C"
+{
+#else	// !__cplusplus
+
+#endif	// __cplusplus
+
+
+//-----------------------------------------------------------------------------
+
+// these functions use no lookup tables or other shared state, so unlike the 
+//	A3DM trig functions they need no initialization, survive hot reloads 
+//	and are safe to call from any thread
+// all angles are in radians; outputs may be the same arrays as inputs
+// maximum error in single precision:
+//	-> sine and cosine: 1e-7 absolute for |x| <= 1000, growing to 1e-6 at 
+//		|x| = 1e5 as the argument itself loses precision
+//	-> arctangent: 3e-7 radians everywhere; atan2(0, 0) is 0
+
+// sine and cosine of one angle
+void a3trigBatchSinCosrScalar(a3real *sin_out, a3real *cos_out, const a3real x);
+
+// arctangent of y/x in [-pi, +pi] using the signs of both to pick the quadrant
+a3real a3trigBatchAtan2rScalar(const a3real y, const a3real x);
+
+// batch sine: sin_out[i] = sin(x[i])
+a3i32 a3trigBatchSinr(a3real *sin_out, const a3real *x, const a3ui32 count);
+
+// batch cosine: cos_out[i] = cos(x[i])
+a3i32 a3trigBatchCosr(a3real *cos_out, const a3real *x, const a3ui32 count);
+
+// batch sine and cosine; the two outputs must be different arrays
+a3i32 a3trigBatchSinCosr(a3real *sin_out, a3real *cos_out, const a3real *x, const a3ui32 count);
+
+// batch arctangent: out[i] = atan2(y[i], x[i])
+a3i32 a3trigBatchAtan2r(a3real *out, const a3real *y, const a3real *x, const a3ui32 count);
+
+
+//-----------------------------------------------------------------------------
+
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+
+#include "_inl/a3_TrigBatch.inl"
+
+
+#endif	// !__ANIMAL3D_TRIGBATCH_H
@@ -33,6 +33,8 @@
 //-----------------------------------------------------------------------------
 
 #include "_a3_demo_utilities/a3_DemoSceneObject.h"
+#include "_a3_demo_utilities/a3_DemoCulling.h"
+#include "_a3_demo_utilities/a3_DemoBVH.h"
 
 
 //-----------------------------------------------------------------------------
@@ -56,7 +58,7 @@ typedef enum a3_DemoMode0_Starter_TargetName				a3_DemoMode0_Starter_TargetName;
 	// maximum unique objects
 	enum a3_DemoMode0_Starter_ObjectMaxCount
 	{
-		starterMaxCount_sceneObject = 8,
+		starterMaxCount_sceneObject = 9,
 		starterMaxCount_cameraObject = 1,
 		starterMaxCount_projector = 1,
 	};
@@ -142,7 +144,8 @@ typedef enum a3_DemoMode0_Starter_TargetName				a3_DemoMode0_Starter_TargetName;
 					obj_capsule[1],
 					obj_torus[1];
 				a3_DemoSceneObject
-					obj_teapot[1];
+					obj_teapot[1],
+					obj_character[1];
 			};
 		};
 		union {
@@ -159,6 +162,19 @@ typedef enum a3_DemoMode0_Starter_TargetName				a3_DemoMode0_Starter_TargetName;
 					proj_camera_main[1];
 			};
 		};
+		// camera-relative matrices for scene objects, updated each frame
+		a3_DemoModelMatrixStack modelMatrixStack[starterMaxCount_sceneObject];
+
+		// bounds of culled objects (plane through torus) and the scene 
+		//	indices of those that passed the frustum test this frame
+		a3_DemoCullingBounds bounds_scene[1];
+		a3ui32 visible_scene[starterMaxCount_sceneObject];
+		a3ui32 visibleCount_scene;
+
+		// hierarchy over the same bounds for picking, and the scene index 
+		//	of the object last picked with the right mouse button (-1 none)
+		a3_DemoBVH bvh_scene[1];
+		a3i32 picked_scene;
 	};
 
 
@@ -86,22 +86,15 @@ void a3starter_input(a3_DemoState* demoState, a3_DemoMode0_Starter* demoMode, a3
 	// right click to ray pick
 	if (a3mouseGetState(demoState->mouse, a3mouse_right) == a3input_down)
 	{
-		// get window coordinates
-		a3i32 const x = a3mouseGetX(demoState->mouse) + demoState->frameBorder;
-		a3i32 const y = a3mouseGetY(demoState->mouse) + demoState->frameBorder;
-
-		// transform to NDC
-		a3vec4 coord = a3vec4_one;
-		coord.x = +((a3real)x * demoState->frameWidthInv * a3real_two - a3real_one);
-		coord.y = -((a3real)y * demoState->frameHeightInv * a3real_two - a3real_one);
-		coord.z = -a3real_one;
-
-		// transform to view space
-		a3real4Real4x4Mul(projector->projectionMatInv.m, coord.v);
-		a3real4DivS(coord.v, coord.w);
-
-		// transform to world space
-		a3real4Real4x4Mul(projector->sceneObject->modelMat.m, coord.v);
+		// world-space ray through the cursor, tested against the hierarchy 
+		//	over the culled objects (plane through torus)
+		a3vec3 origin, direction;
+		a3ui32 hit;
+		a3demo_getPickRay(origin.v, direction.v, demoState->mouse,
+			demoState->frameBorder, demoState->frameWidthInv, demoState->frameHeightInv,
+			projector->projectionMatInv.m, projector->sceneObject->modelMat.m);
+		demoMode->picked_scene = a3demo_queryBVHRay(&hit, 0, demoMode->bvh_scene, demoMode->bounds_scene, origin.v, direction.v) > 0
+			? (a3i32)(demoMode->obj_plane - demoMode->object_scene) + (a3i32)hit : -1;
 	}
 	
 	// move camera
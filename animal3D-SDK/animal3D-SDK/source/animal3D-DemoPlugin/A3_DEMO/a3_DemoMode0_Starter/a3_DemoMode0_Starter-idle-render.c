@@ -97,6 +97,17 @@ void a3starter_render_controls(a3_DemoState const* demoState, a3_DemoMode0_Start
 		targetText_composite,
 	};
 
+	// pickable object names (plane through torus)
+	a3byte const* pickedText[] = {
+		"plane",
+		"box",
+		"sphere",
+		"cylinder",
+		"capsule",
+		"torus",
+	};
+	a3i32 const picked = demoMode->picked_scene - (a3i32)(demoMode->obj_plane - demoMode->object_scene);
+
 	// pipeline and target
 	a3_DemoMode0_Starter_RenderProgramName const render = demoMode->render;
 	a3_DemoMode0_Starter_DisplayProgramName const display = demoMode->display;
@@ -121,6 +132,8 @@ void a3starter_render_controls(a3_DemoState const* demoState, a3_DemoMode0_Start
 		"    Display mode (%u / %u) ('J' | 'K'): %s", display + 1, starter_display_max, displayProgramName[display]);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"    Active camera (%u / %u) ('c' prev | next 'v'): %s", activeCamera + 1, starter_camera_max, cameraText[activeCamera]);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"    Picked object (right click): %s", demoMode->picked_scene >= 0 ? pickedText[picked] : "none");
 }
 
 
@@ -141,7 +154,7 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 	const a3_Framebuffer* currentReadFBO, * currentDisplayFBO;
 
 	// indices
-	a3ui32 i, j;
+	a3ui32 i, j, k;
 
 	// RGB
 	const a3vec4 rgba4[] = {
@@ -198,6 +211,7 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 		demoState->draw_unit_capsule,
 		demoState->draw_unit_torus,
 		demoState->draw_teapot,
+		demoState->draw_character_skin,
 	};
 
 	// temp texture pointers
@@ -210,6 +224,7 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 		demoState->tex_checker,
 		demoState->tex_checker,
 		demoState->tex_checker,
+		demoState->tex_checker,
 	};
 
 	// forward pipeline shader programs
@@ -356,16 +371,16 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 			//	- modelview
 			//	- modelview for normals
 			//	- per-object animation data
-			for (currentSceneObject = demoMode->obj_plane, endSceneObject = demoMode->obj_torus,
-				j = (a3ui32)(currentSceneObject - demoMode->object_scene);
-				currentSceneObject <= endSceneObject;
-				++j, ++currentSceneObject)
+			for (k = 0; k < demoMode->visibleCount_scene; ++k)
 			{
+				j = demoMode->visible_scene[k];
+				currentSceneObject = demoMode->object_scene + j;
+
 				// send data and draw
 				i = (j * 2 + 11) % hueCount;
 				currentDrawable = drawable[currentSceneObject - demoMode->obj_skybox];
 				a3textureActivate(texture_dm[j], a3tex_unit00);
-				a3real4x4Product(modelViewProjectionMat.m, viewProjectionMat.m, currentSceneObject->modelMat.m);
+				modelViewProjectionMat = demoMode->modelMatrixStack[j].modelViewProjectionMat;
 				a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMVP, 1, modelViewProjectionMat.mm);
 				a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor, 1, rgba4[i].v);
 				a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uIndex, 1, &j);
@@ -374,17 +389,17 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 			break;
 		case starter_renderLambert:
 		case starter_renderPhong:
-			for (currentSceneObject = demoMode->obj_plane, endSceneObject = demoMode->obj_torus,
-				j = (a3ui32)(currentSceneObject - demoMode->object_scene);
-				currentSceneObject <= endSceneObject;
-				++j, ++currentSceneObject)
+			for (k = 0; k < demoMode->visibleCount_scene; ++k)
 			{
+				j = demoMode->visible_scene[k];
+				currentSceneObject = demoMode->object_scene + j;
+
 				// send data and draw
 				i = (j * 2 + 11) % hueCount;
 				currentDrawable = drawable[currentSceneObject - demoMode->obj_skybox];
 				a3textureActivate(texture_dm[j], a3tex_unit00);
 				a3textureActivate(texture_dm[j], a3tex_unit01);
-				a3real4x4Product(modelViewMat.m, activeCameraObject->modelMatInv.m, currentSceneObject->modelMat.m);
+				modelViewMat = demoMode->modelMatrixStack[j].modelViewMat;
 				a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, modelViewMat.mm);
 				a3demo_quickInvertTranspose_internal(modelViewMat.m);
 				modelViewMat.v3 = a3vec4_zero;
@@ -397,12 +412,12 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 		}
 
 		// draw morphing object
-		currentDemoProgram = demoState->prog_drawPhong_morph5;
+		currentDemoProgram = demoState->prog_drawPhong_morph;
 		a3shaderProgramActivate(currentDemoProgram->program);
 		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uP, 1, activeCamera->projectionMat.mm);
 		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uAtlas, 1, a3mat4_identity.mm);
-		if (demoState->updateAnimation)
-			a3shaderUniformSendDouble(a3unif_single, currentDemoProgram->uTime, 1, &demoState->timer_display->totalTime);
+		a3shaderUniformSendFloat(a3unif_single, currentDemoProgram->uMorphWeight, a3morph_targetMax, demoState->morphWeight_teapot);
+		a3textureActivate(demoState->tex_morph_teapot, a3tex_unit07);
 		currentSceneObject = demoMode->obj_teapot;
 		j = (a3ui32)(currentSceneObject - demoMode->object_scene);
 		{
@@ -411,7 +426,31 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 			currentDrawable = demoState->draw_teapot_morph;
 			a3textureActivate(texture_dm[j], a3tex_unit00);
 			a3textureActivate(texture_dm[j], a3tex_unit01);
-			a3real4x4Product(modelViewMat.m, activeCameraObject->modelMatInv.m, currentSceneObject->modelMat.m);
+			modelViewMat = demoMode->modelMatrixStack[j].modelViewMat;
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, modelViewMat.mm);
+			a3demo_quickInvertTranspose_internal(modelViewMat.m);
+			modelViewMat.v3 = a3vec4_zero;
+			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV_nrm, 1, modelViewMat.mm);
+			a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor, 1, rgba4[i].v);
+			a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uIndex, 1, &j);
+			a3vertexDrawableActivateAndRender(currentDrawable);
+		}
+
+		// draw skinned object; palette is uploaded during update
+		currentDemoProgram = demoState->prog_drawPhong_skin;
+		a3shaderProgramActivate(currentDemoProgram->program);
+		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uP, 1, activeCamera->projectionMat.mm);
+		a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uAtlas, 1, a3mat4_identity.mm);
+		a3shaderUniformBufferActivate(demoState->ubo_transformBlend, 2);
+		currentSceneObject = demoMode->obj_character;
+		j = (a3ui32)(currentSceneObject - demoMode->object_scene);
+		{
+			// send data and draw
+			i = (j * 2 + 11) % hueCount;
+			currentDrawable = demoState->draw_character_skin;
+			a3textureActivate(texture_dm[j], a3tex_unit00);
+			a3textureActivate(texture_dm[j], a3tex_unit01);
+			modelViewMat = demoMode->modelMatrixStack[j].modelViewMat;
 			a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, modelViewMat.mm);
 			a3demo_quickInvertTranspose_internal(modelViewMat.m);
 			modelViewMat.v3 = a3vec4_zero;
@@ -442,7 +481,7 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 
 	// composite skybox
 	currentDemoProgram = demoState->displaySkybox ? demoState->prog_drawTexture : demoState->prog_drawColorUnif;
-	a3demo_drawModelTexturedColored_invertModel(modelViewProjectionMat.m, viewProjectionMat.m, demoMode->obj_skybox->modelMat.m, a3mat4_identity.m, currentDemoProgram, demoState->draw_unit_box, demoState->tex_skybox_clouds, a3vec4_one.v);
+	a3demo_drawModelTexturedColored_invertModel(modelViewProjectionMat.m, activeCamera->projectionMat.m, demoMode->modelMatrixStack[demoMode->obj_skybox - demoMode->object_scene].modelViewMat.m, a3mat4_identity.m, currentDemoProgram, demoState->draw_unit_box, demoState->tex_skybox_clouds, a3vec4_one.v);
 	a3demo_enableCompositeBlending();
 
 	// draw textured quad with previous pass image on it
@@ -585,15 +624,15 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 				a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uFlag, 1, flag);
 
 				// draw objects again
-				for (currentSceneObject = demoMode->obj_plane, endSceneObject = demoMode->obj_torus,
-					j = (a3ui32)(currentSceneObject - demoMode->object_scene);
-					currentSceneObject <= endSceneObject;
-					++j, ++currentSceneObject)
+				for (k = 0; k < demoMode->visibleCount_scene; ++k)
 				{
+					j = demoMode->visible_scene[k];
+					currentSceneObject = demoMode->object_scene + j;
+
 					// calculate per-object uniforms
 					i = (j * 2 + 23) % hueCount;
 					currentDrawable = drawable[currentSceneObject - demoMode->obj_skybox];
-					a3real4x4Product(modelViewMat.m, activeCameraObject->modelMatInv.m, currentSceneObject->modelMat.m);
+					modelViewMat = demoMode->modelMatrixStack[j].modelViewMat;
 					a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, modelViewMat.mm);
 					a3demo_quickInvertTranspose_internal(modelViewMat.m);
 					modelViewMat.v3 = a3vec4_zero;
@@ -604,21 +643,21 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 				}
 
 				// morphing bases
-				currentDemoProgram = demoState->prog_drawTangentBasis_morph5;
+				currentDemoProgram = demoState->prog_drawTangentBasis_morph;
 				a3shaderProgramActivate(currentDemoProgram->program);
 				a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uP, 1, activeCamera->projectionMat.mm);
 				a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor0, hueCount, rgba4->v);
 				a3shaderUniformSendFloat(a3unif_vec4, currentDemoProgram->uColor, 1, a3vec4_one.v);
 				a3shaderUniformSendFloat(a3unif_single, currentDemoProgram->uSize, 1, size);
 				a3shaderUniformSendInt(a3unif_single, currentDemoProgram->uFlag, 1, flag);
-				if (demoState->updateAnimation)
-					a3shaderUniformSendDouble(a3unif_single, currentDemoProgram->uTime, 1, &demoState->timer_display->totalTime);
+				a3shaderUniformSendFloat(a3unif_single, currentDemoProgram->uMorphWeight, a3morph_targetMax, demoState->morphWeight_teapot);
+				a3textureActivate(demoState->tex_morph_teapot, a3tex_unit07);
 				currentSceneObject = demoMode->obj_teapot;
 				j = (a3ui32)(currentSceneObject - demoMode->object_scene);
 				{
 					i = (j * 2 + 23) % hueCount;
 					currentDrawable = demoState->draw_teapot_morph;
-					a3real4x4Product(modelViewMat.m, activeCameraObject->modelMatInv.m, currentSceneObject->modelMat.m);
+					modelViewMat = demoMode->modelMatrixStack[j].modelViewMat;
 					a3shaderUniformSendFloatMat(a3unif_mat4, 0, currentDemoProgram->uMV, 1, modelViewMat.mm);
 					a3demo_quickInvertTranspose_internal(modelViewMat.m);
 					modelViewMat.v3 = a3vec4_zero;
@@ -668,11 +707,11 @@ void a3starter_render(a3_DemoState const* demoState, a3_DemoMode0_Starter const*
 		if (demoState->displayObjectAxes)
 		{
 			// scene objects
-			for (currentSceneObject = demoMode->obj_plane, endSceneObject = demoMode->obj_teapot,
+			for (currentSceneObject = demoMode->obj_plane, endSceneObject = demoMode->obj_character,
 				j = (a3ui32)(currentSceneObject - demoMode->object_scene);
 				currentSceneObject <= endSceneObject;
 				++j, ++currentSceneObject)
-				a3demo_drawModelSimple(modelViewProjectionMat.m, viewProjectionMat.m, currentSceneObject->modelMat.m, currentDemoProgram);
+				a3demo_drawModelSimple(modelViewProjectionMat.m, activeCamera->projectionMat.m, demoMode->modelMatrixStack[j].modelViewMat.m, currentDemoProgram);
 		}
 	}
 }
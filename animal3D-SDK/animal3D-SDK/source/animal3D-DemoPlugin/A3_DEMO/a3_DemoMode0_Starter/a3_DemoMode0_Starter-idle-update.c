@@ -35,6 +35,9 @@
 
 #include "../_a3_demo_utilities/a3_DemoMacros.h"
 
+#include "../_animation/a3_Kinematics.h"
+#include "../_animation/a3_HierarchyStateBlend.h"
+
 
 //-----------------------------------------------------------------------------
 // UPDATE
@@ -48,10 +51,51 @@ void a3demo_update_pointLight(a3_DemoSceneObject* obj_camera, a3_DemoPointLight*
 
 void a3demo_applyScale_internal(a3_DemoSceneObject* sceneObject, a3real4x4p s);
 
+// morph weights: play the base and each target in sequence at one shape per 
+//	second, blending between neighbours; only active targets keep a weight
+void a3demo_update_morphWeights(a3f32* weight_out, a3_MorphTargetSet const* morphSet, a3f64 const time)
+{
+	a3real weight[a3morph_targetMax] = { 0 }, activeWeight[a3morph_targetMax];
+	a3ui32 active[a3morph_targetMax];
+	a3ui32 const numShapes = morphSet->numTargets + 1;
+	a3ui32 const k0 = (a3ui32)time % numShapes, k1 = (k0 + 1) % numShapes;
+	a3real const u = (a3real)(time - (a3f64)(a3ui32)time);
+	a3i32 i, numActive;
+
+	// shape 0 is the base, which has no target
+	if (k0)
+		weight[k0 - 1] += a3real_one - u;
+	if (k1)
+		weight[k1 - 1] += u;
+
+	numActive = a3morphTargetSelectActive(morphSet, weight, (a3real)0.001, a3morph_targetMax, active, activeWeight);
+	for (i = 0; i < a3morph_targetMax; ++i)
+		weight_out[i] = 0.0f;
+	for (i = 0; i < numActive; ++i)
+		weight_out[active[i]] = (a3f32)activeWeight[i];
+}
+
+// skinned character: loop every frame after the base pose at the clip's 
+//	frame rate, then solve the dual quaternion palette and upload it
+void a3demo_update_skinPalette(a3_DemoState* demoState, a3f64 const time)
+{
+	a3_Hierarchy const* hierarchy = demoState->hierarchy_character;
+	a3_HierarchyPoseGroup const* poseGroup = demoState->poseGroup_character;
+	a3ui32 const numFrames = poseGroup->poseCount - 1;
+	a3ui32 const numJoints = hierarchy->numNodes < demoStateMaxCount_skinJoint ? hierarchy->numNodes : demoStateMaxCount_skinJoint;
+	a3f64 const frame = time * (a3f64)demoState->frameRate_character;
+	a3ui32 const k0 = (a3ui32)frame % numFrames, k1 = (k0 + 1) % numFrames;
+	a3real const u = (a3real)(frame - (a3f64)(a3ui32)frame);
+
+	a3hierarchyPoseGroupSample(demoState->pose_character, 0, poseGroup, k0 + 1, k1 + 1, u);
+	a3kinematicsSolveForwardDualQuatSoA(hierarchy, demoState->objectDQ_character, demoState->pose_character, 0);
+	a3kinematicsUpdateSkinPaletteDualQuat(hierarchy, demoState->skinDQ_character, demoState->objectDQ_character, demoState->bindInverseDQ_character);
+	a3bufferRefill(demoState->ubo_transformBlend, 0, sizeof(a3dualquat) * numJoints, demoState->skinDQ_character);
+}
+
 void a3starter_update(a3_DemoState* demoState, a3_DemoMode0_Starter* demoMode, a3f64 const dt)
 {
 	a3ui32 i;
-	a3_DemoModelMatrixStack matrixStack[starterMaxCount_sceneObject];
 
 	// active camera
 	a3_DemoProjector const* activeCamera = demoMode->projector + demoMode->activeCamera;
@@ -60,6 +104,22 @@ void a3starter_update(a3_DemoState* demoState, a3_DemoMode0_Starter* demoMode, a
 	// temp scale mat
 	a3mat4 scaleMat = a3mat4_identity;
 
+	// local half-size of each culled shape (unit plane, box, sphere, 
+	//	cylinder, capsule and torus); cylinder and capsule extend along x 
+	//	far enough to cover them whether they start or are centered at 
+	//	the origin
+	const a3vec3 bounds_local[] = {
+		{ 0.5f, 0.5f, 0.0f },
+		{ 0.5f, 0.5f, 0.5f },
+		{ 1.0f, 1.0f, 1.0f },
+		{ 1.0f, 1.0f, 1.0f },
+		{ 3.0f, 1.0f, 1.0f },
+		{ 0.25f, 1.25f, 1.25f },
+	};
+	const a3ui32 cullFirst = (a3ui32)(demoMode->obj_plane - demoMode->object_scene);
+	a3_DemoCullingFrustum frustum[1];
+	a3i32 numVisible;
+
 	a3demo_update_objects(demoState, dt,
 		demoMode->object_scene, starterMaxCount_sceneObject, 0, 0);
 	a3demo_update_objects(demoState, dt,
@@ -69,6 +129,12 @@ void a3starter_update(a3_DemoState* demoState, a3_DemoMode0_Starter* demoMode, a
 
 	a3demo_update_defaultAnimation(demoState, dt, demoMode->obj_box, 6, 2);
 
+	if (demoState->updateAnimation && demoState->morph_teapot->numTargets)
+		a3demo_update_morphWeights(demoState->morphWeight_teapot, demoState->morph_teapot, demoState->timer_display->totalTime);
+
+	if (demoState->updateAnimation && demoState->skinDQ_character && demoState->poseGroup_character->poseCount > 1)
+		a3demo_update_skinPalette(demoState, demoState->timer_display->totalTime);
+
 	// apply scales to starter objects
 	for (i = 0; i < starterMaxCount_sceneObject; ++i)
 		a3demo_applyScale_internal(demoMode->object_scene + i, scaleMat.m);
@@ -76,13 +142,27 @@ void a3starter_update(a3_DemoState* demoState, a3_DemoMode0_Starter* demoMode, a
 	// update skybox
 	a3demo_update_bindSkybox(demoMode->obj_camera_main, demoMode->obj_skybox);
 
-	// update matrix stack data
+	// update matrix stack data, relative to the camera's double position
 	for (i = 0; i < starterMaxCount_sceneObject; ++i)
 	{
-		a3demo_updateModelMatrixStack(matrixStack + i,
+		a3demo_updateModelMatrixStack(demoMode->modelMatrixStack + i,
 			activeCamera->projectionMat.m, activeCameraObject->modelMat.m, activeCameraObject->modelMatInv.m,
-			demoMode->object_scene[i].modelMat.m, a3mat4_identity.m);
+			demoMode->object_scene[i].modelMat.m, a3mat4_identity.m,
+			activeCameraObject->position.v, demoMode->object_scene[i].position.v);
+	}
+
+	// cull plane through torus against the active camera's frustum
+	for (i = 0; i < demoMode->bounds_scene->count; ++i)
+	{
+		a3demo_setCullingBoundsTransformed(demoMode->bounds_scene, i,
+			demoMode->object_scene[cullFirst + i].modelMat.m, a3vec3_zero.v, bounds_local[i].v);
 	}
+	a3demo_updateBVH(demoMode->bvh_scene, demoMode->bounds_scene, 1);
+	a3demo_extractCullingFrustum(frustum, activeCamera->viewProjectionMat.m);
+	numVisible = a3demo_cullBoxes(demoMode->visible_scene, demoMode->bounds_scene, frustum);
+	demoMode->visibleCount_scene = numVisible > 0 ? numVisible : 0;
+	for (i = 0; i < demoMode->visibleCount_scene; ++i)
+		demoMode->visible_scene[i] += cullFirst;
 }
 
 
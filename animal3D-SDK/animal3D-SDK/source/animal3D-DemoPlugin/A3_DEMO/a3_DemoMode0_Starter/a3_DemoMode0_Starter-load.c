@@ -72,11 +72,6 @@ void a3starter_load(a3_DemoState const* demoState, a3_DemoMode0_Starter* demoMod
 	// camera's starting orientation depends on "vertical" axis
 	// we want the exact same view in either case
 	const a3real sceneCameraAxisPos = 20.0f;
-	const a3vec3 sceneCameraStartPos = {
-		+sceneCameraAxisPos,
-		-sceneCameraAxisPos,
-		+sceneCameraAxisPos + 5.0f,
-	};
 	const a3vec3 sceneCameraStartEuler = {
 		+55.0f,
 		+0.0f,
@@ -110,33 +105,41 @@ void a3starter_load(a3_DemoState const* demoState, a3_DemoMode0_Starter* demoMod
 	currentSceneObject->scale.x = 5.0f;
 	currentSceneObject->scale.y = 4.0f;
 	currentSceneObject->scale.z = 3.0f;
-	a3real3Set(currentSceneObject->position.v, +1.0f * sceneObjectDistance, 0.0f, sceneObjectHeight);
+	a3demo_setSceneObjectPosition(currentSceneObject, +1.0f * sceneObjectDistance, 0.0f, sceneObjectHeight);
 
 	currentSceneObject = demoMode->obj_sphere;
 	currentSceneObject->scaleMode = 1;
 	currentSceneObject->scale.x = 2.0f;
-	a3real3Set(currentSceneObject->position.v, -1.0f * sceneObjectDistance, 0.0f, sceneObjectHeight);
+	a3demo_setSceneObjectPosition(currentSceneObject, -1.0f * sceneObjectDistance, 0.0f, sceneObjectHeight);
 
 	currentSceneObject = demoMode->obj_cylinder;
 	currentSceneObject->scaleMode = 2;
 	currentSceneObject->scale.x = 5.0f;
 	currentSceneObject->scale.y = 2.0f;
 	currentSceneObject->scale.z = 2.0f;
-	a3real3Set(currentSceneObject->position.v, +0.5f * sceneObjectDistance, +0.866f * sceneObjectDistance, sceneObjectHeight);
+	a3demo_setSceneObjectPosition(currentSceneObject, +0.5f * sceneObjectDistance, +0.866f * sceneObjectDistance, sceneObjectHeight);
 
 	currentSceneObject = demoMode->obj_capsule;
 	currentSceneObject->scaleMode = 1;
 	currentSceneObject->scale.x = 2.0f;
-	a3real3Set(currentSceneObject->position.v, -0.5f * sceneObjectDistance, -0.866f * sceneObjectDistance, sceneObjectHeight);
+	a3demo_setSceneObjectPosition(currentSceneObject, -0.5f * sceneObjectDistance, -0.866f * sceneObjectDistance, sceneObjectHeight);
 
 	currentSceneObject = demoMode->obj_torus;
 	currentSceneObject->scaleMode = 1;
 	currentSceneObject->scale.x = 2.5f;
-	a3real3Set(currentSceneObject->position.v, -0.5f * sceneObjectDistance, +0.866f * sceneObjectDistance, sceneObjectHeight);
+	a3demo_setSceneObjectPosition(currentSceneObject, -0.5f * sceneObjectDistance, +0.866f * sceneObjectDistance, sceneObjectHeight);
 
 	currentSceneObject = demoMode->obj_teapot;
 	currentSceneObject->scaleMode = 0;
-	a3real3Set(currentSceneObject->position.v, +0.5f * sceneObjectDistance, -0.866f * sceneObjectDistance, sceneObjectHeight);
+	a3demo_setSceneObjectPosition(currentSceneObject, +0.5f * sceneObjectDistance, -0.866f * sceneObjectDistance, sceneObjectHeight);
+
+	// skinned character stands on the plane; its skeleton is Y-up and 
+	//	about 175 units tall
+	currentSceneObject = demoMode->obj_character;
+	currentSceneObject->scaleMode = 1;
+	currentSceneObject->scale.x = 0.025f;
+	currentSceneObject->euler.x = +90.0f;
+	a3demo_setSceneObjectPosition(currentSceneObject, 0.0f, 0.0f, -sceneObjectHeight);
 
 
 	// set up cameras
@@ -148,7 +151,7 @@ void a3starter_load(a3_DemoState const* demoState, a3_DemoMode0_Starter* demoMod
 	projector->ctrlMoveSpeed = 10.0f;
 	projector->ctrlRotateSpeed = 5.0f;
 	projector->ctrlZoomSpeed = 5.0f;
-	projector->sceneObject->position = sceneCameraStartPos;
+	a3demo_setSceneObjectPosition(projector->sceneObject, +sceneCameraAxisPos, -sceneCameraAxisPos, +sceneCameraAxisPos + 5.0f);
 	projector->sceneObject->euler = sceneCameraStartEuler;
 
 
@@ -165,6 +168,14 @@ void a3starter_load(a3_DemoState const* demoState, a3_DemoMode0_Starter* demoMod
 
 	demoMode->targetCount[starter_passScene] = starter_target_scene_max;
 	demoMode->targetCount[starter_passComposite] = 1;
+
+	// culling bounds for plane through torus
+	a3demo_createCullingBounds(demoMode->bounds_scene, (a3ui32)(demoMode->obj_torus - demoMode->obj_plane) + 1);
+	demoMode->visibleCount_scene = 0;
+
+	// hierarchy over the same objects
+	a3demo_createBVH(demoMode->bvh_scene, demoMode->bounds_scene->count);
+	demoMode->picked_scene = -1;
 }
 
 
@@ -43,7 +43,8 @@ void a3starter_unloadValidate(a3_DemoState* demoState, a3_DemoMode0_Starter* dem
 
 void a3starter_unload(a3_DemoState const* demoState, a3_DemoMode0_Starter* demoMode)
 {
-
+	a3demo_releaseBVH(demoMode->bvh_scene);
+	a3demo_releaseCullingBounds(demoMode->bounds_scene);
 }
 
 
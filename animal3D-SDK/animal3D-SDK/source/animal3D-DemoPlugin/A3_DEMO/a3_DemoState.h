@@ -45,6 +45,9 @@
 
 #include "a3_DemoMode0_Starter.h"
 
+#include "_animation/a3_MorphTarget.h"
+#include "_animation/a3_HierarchyState.h"
+
 
 //-----------------------------------------------------------------------------
 
@@ -90,7 +93,7 @@ enum a3_DemoState_ObjectMaxCount
 {
 	demoStateMaxCount_timer = 1,
 
-	demoStateMaxCount_drawDataBuffer = 1,
+	demoStateMaxCount_drawDataBuffer = 2,
 	demoStateMaxCount_vertexArray = 8,
 	demoStateMaxCount_drawable = 16,
 
@@ -99,6 +102,8 @@ enum a3_DemoState_ObjectMaxCount
 	demoStateMaxCount_texture = 8,
 
 	demoStateMaxCount_framebuffer = 2,
+
+	demoStateMaxCount_skinJoint = 128,		// palette size in skinning shaders (MAX_JOINTS)
 };
 
 	
@@ -153,13 +158,18 @@ struct a3_DemoState
 	a3_KeyboardInput keyboard[1];
 	a3_XboxControllerInput xcontrol[4];
 
-	// pointer to fast trig table
+	// pointer to fast trig table (used by A3DM; animation code uses the 
+	//	stateless functions in a3_TrigBatch.h, which are safe on worker threads)
 	a3f32 trigTable[4096 * 4];
 
 	// more accurate time tracking
 	a3f64 t_timer, dt_timer, dt_timer_tot;
 	a3i64 n_timer;
 
+	// frame time telemetry: running statistics and 99th percentile
+	a3_StatsAccumulator dt_timer_stats[1];
+	a3_StatsQuantile dt_timer_p99[1];
+
 
 	//-------------------------------------------------------------------------
 	// scene variables and objects
@@ -203,6 +213,8 @@ struct a3_DemoState
 		struct {
 			a3_VertexBuffer
 				vbo_staticSceneObjectDrawBuffer[1];			// buffer to hold all data for static scene objects (e.g. grid)
+			a3_UniformBuffer
+				ubo_transformBlend[1];						// skinning palette as dual quaternions (ubTransformBlend)
 		};
 	};
 
@@ -211,8 +223,8 @@ struct a3_DemoState
 		a3_VertexArrayDescriptor vertexArray[demoStateMaxCount_vertexArray];
 		struct {
 			a3_VertexArrayDescriptor
-				vao_tangentbasis_texcoord_morph5[1],		// VAO for vertex format with partial tangent bases for 5-target morphing model, with texcoords
-			//	vao_tangentbasis_texcoord_skin[1],			// VAO for vertex format with complete tangent basis, with texcoords and skin weights
+				vao_tangentbasis_texcoord_morph[1],			// VAO for morphing model base shape; vertex IDs index the morph data texture
+				vao_tangentbasis_texcoord_skin[1],			// VAO for vertex format with complete tangent basis, with texcoords and skin weights
 				vao_tangentbasis_texcoord[1];				// VAO for vertex format with complete tangent basis, with texcoords
 			a3_VertexArrayDescriptor
 				vao_position_color[1],						// VAO for vertex format with position and color
@@ -238,7 +250,7 @@ struct a3_DemoState
 				draw_unit_torus[1],							// unit torus (major radius = 1)
 				draw_unit_plane_z[1];						// unit plane (width = height = 1) with Z normal
 			a3_VertexDrawable
-			//	draw_character_skin[1],						// can't not have a skinnable character
+				draw_character_skin[1],						// can't not have a skinnable character
 				draw_teapot_morph[1],						// can't not have a morphing Utah teapot
 				draw_teapot[1];								// can't not have a Utah teapot
 		};
@@ -266,15 +278,13 @@ struct a3_DemoState
 				prog_drawTexture[1];						// draw texture
 			a3_DemoStateShaderProgram
 			//	prog_drawPhong_skin_instanced[1],			// draw skinned model with instancing
-				prog_drawPhong_morph5_instanced[1],			// draw 5-target morphing model with instancing
-			//	prog_drawPhong_skin[1],						// draw skinned model
-				prog_drawPhong_morph5[1];					// draw 5-target morphing model
+				prog_drawPhong_skin[1],						// draw skinned model
+				prog_drawPhong_morph[1];					// draw sparse weighted morphing model
 			a3_DemoStateShaderProgram
 			//	prog_drawTangentBasis_skin_instanced[1],	// draw vertex/face tangent bases and wireframe for skinned model with instancing
-				prog_drawTangentBasis_morph5_instanced[1],	// draw vertex/face tangent bases and wireframe for 5-target morphing model with instancing
 				prog_drawTangentBasis_instanced[1],			// draw vertex/face tangent bases and wireframe with instancing
 			//	prog_drawTangentBasis_skin[1],				// draw vertex/face tangent bases and wireframe for skinned model
-				prog_drawTangentBasis_morph5[1],			// draw vertex/face tangent bases and wireframe for 5-target morphing model
+				prog_drawTangentBasis_morph[1],				// draw vertex/face tangent bases and wireframe for sparse weighted morphing model
 				prog_drawTangentBasis[1];					// draw vertex/face tangent bases and wireframe
 		};
 	};
@@ -291,6 +301,8 @@ struct a3_DemoState
 				tex_ramp_sm[1],
 				tex_testsprite[1],
 				tex_checker[1];
+			a3_Texture
+				tex_morph_teapot[1];						// sparse morph deltas for the teapot (see a3morphTargetStoreTexture)
 		};
 	};
 
@@ -307,6 +319,20 @@ struct a3_DemoState
 	};
 
 
+	// morph targets
+	a3_MorphTargetSet morph_teapot[1];						// sparse targets for the morphing teapot
+	a3f32 morphWeight_teapot[a3morph_targetMax];			// current weights sent to shaders, zero for inactive targets
+
+	// skinned character: skeleton and clip from HTR (pose 0 is the base 
+	//	pose, also used as the bind pose), current local pose, and per node 
+	//	object-space, inverse bind and palette dual quaternions
+	a3_Hierarchy hierarchy_character[1];
+	a3_HierarchyPoseGroup poseGroup_character[1];
+	a3_SpatialPoseSoA pose_character[1];
+	a3dualquat *objectDQ_character, *bindInverseDQ_character, *skinDQ_character;
+	a3real frameRate_character;
+
+
 	// managed objects, no touchie
 	a3_VertexDrawable dummyDrawable[1];
 
@@ -152,6 +152,9 @@ void a3demo_render_data(const a3_DemoState* demoState,
 		"fps_average = %07.4lf F/s", (a3f64)demoState->n_timer / (demoState->dt_timer_tot));//(a3f64)demoState->n_timer / demoState->timer_display->totalTime);//(a3f64)demoState->timer_display->ticks / demoState->timer_display->totalTime);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"dt_render = %07.4lf ms", (demoState->dt_timer) * 1000.0);//demoState->timer_display->previousTick * 1000.0);
+	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
+		"dt_render: sd = %07.4lf ms | p99 = %07.4lf ms | max = %07.4lf ms", a3statsAccumulatorStandardDeviation(demoState->dt_timer_stats) * 1000.0,
+		a3statsQuantileGet(demoState->dt_timer_p99) * 1000.0, (demoState->dt_timer_stats->count ? demoState->dt_timer_stats->max : 0.0) * 1000.0);
 	a3textDraw(text, textAlign, textOffset += textOffsetDelta, textDepth, col.r, col.g, col.b, col.a,
 		"t_render = %07.4lf s | n_render = %lu", demoState->timer_display->totalTime, demoState->n_timer);//demoState->timer_display->totalTime, demoState->timer_display->ticks);
 
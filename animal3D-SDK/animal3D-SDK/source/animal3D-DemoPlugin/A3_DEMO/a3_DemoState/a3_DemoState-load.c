@@ -63,6 +63,7 @@
 #define A3_DEMO_GLSL	A3_DEMO_RES_DIR"glsl/"
 #define A3_DEMO_TEX		A3_DEMO_RES_DIR"tex/"
 #define A3_DEMO_OBJ		A3_DEMO_RES_DIR"obj/"
+#define A3_DEMO_ANIM	A3_DEMO_RES_DIR"animdata/"
 
 // define resource subdirectories
 #define A3_DEMO_VS		A3_DEMO_GLSL"4x/vs/"
@@ -76,7 +77,15 @@
 
 #include "../a3_DemoState.h"
 
+#include "../_animation/a3_SkinWeights.h"
+#include "../_animation/a3_Kinematics.h"
+#include "../_a3_demo_utilities/a3_DemoModelLoader.h"
+#include "../_a3_demo_utilities/a3_DemoTangentBasis.h"
+#include "../_a3_demo_utilities/a3_DemoMeshOptimizer.h"
+#include "../_a3_demo_utilities/a3_DemoVertexFormat.h"
+
 #include <stdio.h>
+#include <stdlib.h>
 
 
 //-----------------------------------------------------------------------------
@@ -161,6 +170,14 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		+0.05f,  0.00f,  0.00f,  0.00f,
 		 0.00f,  0.00f,  0.00f, +1.00f,
 	};
+	// the character mesh is about 1/8 the size of its skeleton, whose 
+	//	translations the skinning palette uses as they are
+	static const a3mat4 upscale8x = {
+		+8.00f,  0.00f,  0.00f,  0.00f,
+		 0.00f, +8.00f,  0.00f,  0.00f,
+		 0.00f,  0.00f, +8.00f,  0.00f,
+		 0.00f,  0.00f,  0.00f, +1.00f,
+	};
 
 	// pointer to shared vbo/ibo
 	a3_VertexBuffer *vbo_ibo;
@@ -186,16 +203,65 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 	const a3ui32 morphTargetsPerModel = sizeof(*morphTargetsData) / sizeof(a3_GeometryData);
 	const a3ui32 morphModelsCount = sizeof(morphTargetsData) / sizeof(*morphTargetsData);
 
-	// morphing vertex format
-	a3_VertexFormatDescriptor morphFormat[1] = { 0 };
-	a3_VertexAttributeDescriptor morphAttrib[16] = { 0 };
-	a3ui32 const morphAttribCount = sizeof(morphAttrib) / sizeof(a3_VertexAttributeDescriptor);
+	// skin weights, quantized to 4 influences per vertex, and the skinned 
+	//	models using them (one each)
+	a3_SkinWeights skinWeightsData[1] = { 0 };
+	a3_GeometryData skinnedModelsData[1] = { 0 };
+	const a3ui32 skinWeightsCount = sizeof(skinWeightsData) / sizeof(a3_SkinWeights);
+	const a3ui32 skinnedModelsCount = sizeof(skinnedModelsData) / sizeof(a3_GeometryData);
+
+	// skeleton of the skinned character; skin influences are matched to 
+	//	its node names, so it is loaded before the weights
+	const a3byte *const characterSkeletonFile = A3_DEMO_ANIM"egnaro/egnaro_skel_anim.htr";
+	const a3byte **characterNodeNames = 0;
+	a3ui32 characterNodeCount = 0;
+
+	// known mismatch: egnaro_skin.xml was bound to a rig whose forearm 
+	//	twist joints end in '1'; the HTR has the same joints, between elbow 
+	//	and wrist, without it, so their weights are moved to those joints 
+	//	instead of being spread over the remaining influences
+	const a3byte characterSkinAlias[4][2][a3node_nameSize] = {
+		{ "R_lowerForearm1", "R_lowerForearm" },
+		{ "R_upperForearm1", "R_upperForearm" },
+		{ "L_lowerForearm1", "L_lowerForearm" },
+		{ "L_upperForearm1", "L_upperForearm" },
+	};
+	const a3ui32 characterSkinAliasCount = sizeof(characterSkinAlias) / sizeof(*characterSkinAlias);
+	a3i32 characterSkinAliasNode[4] = { 0 };
+
+	// threads parsing each model file and generating tangent bases
+	const a3ui32 modelLoaderThreads = 8;
+
+	// cache miss ratio allowed to grow by this factor to reduce overdraw
+	const a3f32 meshOverdrawThreshold = 1.05f;
+
+	// quantized sparse morph targets relative to each model's base shape;
+	//	only the base shape of each morphing model is stored as geometry
+	a3_MorphTargetPack morphTargetsPack[1] = { 0 };
 
 	// common index format
 	a3_IndexFormatDescriptor sceneCommonIndexFormat[1] = { 0 };
 	a3ui32 bufferOffset, *const bufferOffsetPtr = &bufferOffset;
 
 
+	// skinned character skeleton and clip; not cached in the stream
+	if (a3hierarchyPoseGroupLoadHTR(demoState->poseGroup_character, demoState->hierarchy_character, characterSkeletonFile, &demoState->frameRate_character) > 0)
+	{
+		// aliases are matched as extra names after the nodes
+		characterNodeCount = demoState->hierarchy_character->numNodes;
+		characterNodeNames = (const a3byte **)malloc(sizeof(a3byte *) * (characterNodeCount + characterSkinAliasCount));
+		if (characterNodeNames)
+		{
+			a3hierarchyGetNodeNames(characterNodeNames, demoState->hierarchy_character);
+			for (i = 0; i < characterSkinAliasCount; ++i)
+			{
+				characterNodeNames[characterNodeCount + i] = characterSkinAlias[i][0];
+				characterSkinAliasNode[i] = a3hierarchyGetNodeIndex(demoState->hierarchy_character, characterSkinAlias[i][1]);
+			}
+		}
+	}
+
+
 	// procedural scene objects
 	// attempt to load stream if requested
 	if (demoState->streaming && a3fileStreamOpenRead(fileStream, geometryStream))
@@ -214,10 +280,20 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		for (i = 0; i < loadedModelsCount; ++i)
 			a3fileStreamReadObject(fileStream, loadedModelsData + i, (a3_FileStreamReadFunc)a3geometryLoadDataBinary);
 
-		// morphing objects
+		// morphing objects: base shape followed by packed targets
 		for (i = 0; i < morphModelsCount; ++i)
-			for (j = 0; j < morphTargetsPerModel; ++j)
-				a3fileStreamReadObject(fileStream, morphTargetsData[i] + j, (a3_FileStreamReadFunc)a3geometryLoadDataBinary);
+		{
+			a3fileStreamReadObject(fileStream, morphTargetsData[i], (a3_FileStreamReadFunc)a3geometryLoadDataBinary);
+			a3fileStreamReadObject(fileStream, morphTargetsPack + i, (a3_FileStreamReadFunc)a3morphTargetPackLoadBinary);
+		}
+
+		// skin weights
+		for (i = 0; i < skinWeightsCount; ++i)
+			a3fileStreamReadObject(fileStream, skinWeightsData + i, (a3_FileStreamReadFunc)a3skinWeightsLoadBinary);
+
+		// skinned model objects
+		for (i = 0; i < skinnedModelsCount; ++i)
+			a3fileStreamReadObject(fileStream, skinnedModelsData + i, (a3_FileStreamReadFunc)a3geometryLoadDataBinary);
 
 		// done
 		a3fileStreamClose(fileStream);
@@ -240,6 +316,12 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 				{ A3_DEMO_OBJ"teapot/morph/teapot_scale_z.obj", downscale20x_y2z_x2y.mm, a3model_calculateVertexTangents },
 			},
 		};
+		const a3byte *skinWeightsFiles[1] = {
+			A3_DEMO_OBJ"egnaro/egnaro_skin.xml",
+		};
+		const a3_DemoStateLoadedModel skinnedShapes[1] = {
+			{ A3_DEMO_OBJ"egnaro/egnaro_mesh.obj", upscale8x.mm, a3model_calculateVertexTangents },
+		};
 
 		// static scene procedural objects
 		//	(axes, grid)
@@ -261,29 +343,90 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		for (i = 0; i < proceduralShapesCount; ++i)
 		{
 			a3proceduralGenerateGeometryData(proceduralShapesData + i, proceduralShapes + i, 0);
+			a3demo_generateTangentBasis(proceduralShapesData + i, modelLoaderThreads);
+			a3demo_optimizeGeometry(proceduralShapesData + i, 1, meshOverdrawThreshold);
 			a3fileStreamWriteObject(fileStream, proceduralShapesData + i, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
 		}
 
 		// objects loaded from mesh files
 		for (i = 0; i < loadedModelsCount; ++i)
 		{
-			a3modelLoadOBJ(loadedModelsData + i, loadedShapes[i].filePath, loadedShapes[i].flag, loadedShapes[i].transform);
+			a3demo_loadModelOBJ(loadedModelsData + i, loadedShapes[i].filePath, loadedShapes[i].flag, loadedShapes[i].transform, modelLoaderThreads);
+			a3demo_optimizeGeometry(loadedModelsData + i, 1, meshOverdrawThreshold);
 			a3fileStreamWriteObject(fileStream, loadedModelsData + i, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
 		}
 
-		// morphing objects
+		// morphing objects: targets are reduced to quantized sparse deltas 
+		//	against the base shape, then only the base shape is kept; all
+		//	shapes are reordered together so their vertices still match
 		for (i = 0; i < morphModelsCount; ++i)
+		{
+			a3_MorphTargetSet morphTargetsSet[1] = { 0 };
 			for (j = 0; j < morphTargetsPerModel; ++j)
+				a3demo_loadModelOBJ(morphTargetsData[i] + j, morphShapes[i][j].filePath, morphShapes[i][j].flag, morphShapes[i][j].transform, modelLoaderThreads);
+			a3demo_optimizeGeometry(morphTargetsData[i], morphTargetsPerModel, meshOverdrawThreshold);
+			a3morphTargetSetCreate(morphTargetsSet, morphTargetsData[i], morphTargetsData[i] + 1, morphTargetsPerModel - 1, (a3real)0.00001);
+			a3morphTargetPackCreate(morphTargetsPack + i, morphTargetsSet);
+			a3morphTargetSetRelease(morphTargetsSet);
+			for (j = 1; j < morphTargetsPerModel; ++j)
+				a3geometryReleaseData(morphTargetsData[i] + j);
+			a3fileStreamWriteObject(fileStream, morphTargetsData[i], (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
+			a3fileStreamWriteObject(fileStream, morphTargetsPack + i, (a3_FileStreamWriteFunc)a3morphTargetPackSaveBinary);
+		}
+
+		// skin weights: the XML is only parsed when the cache is rebuilt; 
+		//	influences are the character's node indices, with aliases 
+		//	replaced by the nodes they stand for
+		for (i = 0; i < skinWeightsCount; ++i)
+		{
+			a3skinWeightsLoadDeformerXML(skinWeightsData + i, skinWeightsFiles[i], a3skinWeights_influenceMax, characterNodeNames, characterNodeNames ? characterNodeCount + characterSkinAliasCount : 0);
+			for (j = 0; j < skinWeightsData[i].numVertices * a3skinWeights_influenceMax; ++j)
+				if (skinWeightsData[i].index[j] >= characterNodeCount && characterSkinAliasNode[skinWeightsData[i].index[j] - characterNodeCount] >= 0)
+					skinWeightsData[i].index[j] = (a3ubyte)characterSkinAliasNode[skinWeightsData[i].index[j] - characterNodeCount];
+			if (!a3skinWeightsValidate(skinWeightsData + i))
+				printf("\n A3 Warning: Skin weights in \"%s\" are not normalized and sorted.", skinWeightsFiles[i]);
+			a3fileStreamWriteObject(fileStream, skinWeightsData + i, (a3_FileStreamWriteFunc)a3skinWeightsSaveBinary);
+		}
+
+		// skinned objects: weights are expanded per position and become 
+		//	the blending attribute of each vertex sharing that position
+		for (i = 0; i < skinnedModelsCount; ++i)
+		{
+			const a3ui32 numBlendPositions = skinWeightsData[i].numVertices;
+			a3real *blendWeights = (a3real *)malloc(sizeof(a3real) * 4 * numBlendPositions);
+			a3i32 *blendIndices = (a3i32 *)malloc(sizeof(a3i32) * 4 * numBlendPositions);
+			if (blendWeights && blendIndices)
 			{
-				a3modelLoadOBJ(morphTargetsData[i] + j, morphShapes[i][j].filePath, morphShapes[i][j].flag, morphShapes[i][j].transform);
-				a3fileStreamWriteObject(fileStream, morphTargetsData[i] + j, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
+				a3skinWeightsDecode(skinWeightsData + i, blendWeights, blendIndices);
+				a3demo_loadModelOBJBlending(skinnedModelsData + i, skinnedShapes[i].filePath, skinnedShapes[i].flag, skinnedShapes[i].transform, modelLoaderThreads, blendWeights, blendIndices, numBlendPositions);
+				a3demo_optimizeGeometry(skinnedModelsData + i, 1, meshOverdrawThreshold);
 			}
+			free(blendWeights);
+			free(blendIndices);
+			a3fileStreamWriteObject(fileStream, skinnedModelsData + i, (a3_FileStreamWriteFunc)a3geometrySaveDataBinary);
+		}
 
 		// done
 		a3fileStreamClose(fileStream);
 	}
 
 
+	// packed vertex formats for upload; the cache keeps the float formats
+	//	- shapes sharing the tangent basis vertex array are read by shaders 
+	//		expecting plain vectors, so their unit vectors stay snorm16
+	//	- the morphing base shape is only read by the morph vertex shader, 
+	//		which decodes octahedral normals and tangents
+	//	- display shapes are small and left as they are
+	for (i = 0; i < proceduralShapesCount; ++i)
+		a3demo_packGeometryVertexFormat(proceduralShapesData + i, a3false);
+	for (i = 0; i < loadedModelsCount; ++i)
+		a3demo_packGeometryVertexFormat(loadedModelsData + i, a3false);
+	for (i = 0; i < morphModelsCount; ++i)
+		a3demo_packGeometryVertexFormat(morphTargetsData[i], a3true);
+	for (i = 0; i < skinnedModelsCount; ++i)
+		a3demo_packGeometryVertexFormat(skinnedModelsData + i, a3false);
+
+
 	// GPU data upload process: 
 	//	- determine storage requirements
 	//	- allocate buffer
@@ -307,29 +450,15 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		sharedVertexStorage += a3geometryGetVertexBufferSize(loadedModelsData + i);
 		numVerts += loadedModelsData[i].numVertices;
 	}
-
-
-	// morph targets setup
-	//	- add required data from each model to new data descriptor
+	for (i = 0; i < morphModelsCount; ++i)
 	{
-		a3_VertexAttributeDescriptor* morphAttribPtr;
-		a3_VertexAttributeName attribName;
-		a3ui32 morphModelIndex = 0;
-
-		for (i = 0, morphAttribPtr = morphAttrib, attribName = a3attrib_user00; i < morphTargetsPerModel; ++i)
-			for (j = 0; j < 3; ++j, ++morphAttribPtr, ++attribName)
-				// create descriptors for position, normal and tangent
-				a3vertexAttribCreateDescriptor(morphAttribPtr, (a3_VertexAttributeName)attribName, a3attrib_vec3);
-		// the final attribute will be for texture coordinates
-		a3vertexAttribCreateDescriptor(morphAttribPtr, a3attrib_user15, a3attrib_vec2);
-
-		// make format
-		a3vertexFormatCreateDescriptor(morphFormat, morphAttrib, morphAttribCount);
-		for (i = 0; i < morphModelsCount; ++i)
-		{
-			sharedVertexStorage += a3vertexFormatGetStorageSpaceRequired(morphFormat, morphTargetsData[i]->numVertices);
-			numVerts += morphTargetsData[i]->numVertices;
-		}
+		sharedVertexStorage += a3geometryGetVertexBufferSize(morphTargetsData[i]);
+		numVerts += morphTargetsData[i]->numVertices;
+	}
+	for (i = 0; i < skinnedModelsCount; ++i)
+	{
+		sharedVertexStorage += a3geometryGetVertexBufferSize(skinnedModelsData + i);
+		numVerts += skinnedModelsData[i].numVertices;
 	}
 
 
@@ -344,6 +473,8 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 		sharedIndexStorage += a3indexFormatGetStorageSpaceRequired(sceneCommonIndexFormat, loadedModelsData[i].numIndices);
 	for (i = 0; i < morphModelsCount; ++i)
 		sharedIndexStorage += a3indexFormatGetStorageSpaceRequired(sceneCommonIndexFormat, morphTargetsData[i]->numIndices);
+	for (i = 0; i < skinnedModelsCount; ++i)
+		sharedIndexStorage += a3indexFormatGetStorageSpaceRequired(sceneCommonIndexFormat, skinnedModelsData[i].numIndices);
 
 	// create shared buffer
 	vbo_ibo = demoState->vbo_staticSceneObjectDrawBuffer;
@@ -385,25 +516,43 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 	sharedVertexStorage += a3geometryGenerateDrawable(currentDrawable, loadedModelsData + 0, vao, vbo_ibo, sceneCommonIndexFormat, 0, 0);
 
 	// morphing models
-	vao = demoState->vao_tangentbasis_texcoord_morph5;
-	a3vertexArrayCreateDescriptor(vao, "vao:tb+tc+morph5", vbo_ibo, morphFormat, sharedVertexStorage);
+	//	- base shape gets its own vertex array so that vertex IDs start at 
+	//		zero and can index the morph data texture
+	vao = demoState->vao_tangentbasis_texcoord_morph;
+	a3geometryGenerateVertexArray(vao, "vao:tb+tc+morph", morphTargetsData[0], vbo_ibo, sharedVertexStorage);
+	currentDrawable = demoState->draw_teapot_morph;
+	sharedVertexStorage += a3geometryGenerateDrawable(currentDrawable, morphTargetsData[0], vao, vbo_ibo, sceneCommonIndexFormat, 0, 0);
+
+	// sparse morph targets unpacked relative to the base shape; the 
+	//	drawable above provides the base and the data texture the deltas
+	a3morphTargetSetCreatePack(demoState->morph_teapot, morphTargetsData[0], morphTargetsPack);
+
+	// skinned models
+	//	- blend weights and indices are read by the skinning vertex shader
+	vao = demoState->vao_tangentbasis_texcoord_skin;
+	a3geometryGenerateVertexArray(vao, "vao:tb+tc+skin", skinnedModelsData + 0, vbo_ibo, sharedVertexStorage);
+	currentDrawable = demoState->draw_character_skin;
+	sharedVertexStorage += a3geometryGenerateDrawable(currentDrawable, skinnedModelsData + 0, vao, vbo_ibo, sceneCommonIndexFormat, 0, 0);
+
+	// skinning palette: the inverse bind pose comes from the base pose, 
+	//	which is also the starting pose, so the palette starts as identity
+	if (characterNodeCount)
 	{
-		a3_VertexAttributeDataDescriptor morphAttribData[16] = { 0 }, * morphAttribDataPtr;
-		a3_VertexAttributeName attribName;
-		a3ui32 morphModelIndex = 0;
-
-		for (i = 0, morphAttribDataPtr = morphAttribData, attribName = a3attrib_user00; i < morphTargetsPerModel; ++i)
-			for (j = 0; j < 3; ++j, ++morphAttribDataPtr, ++attribName)
-				a3vertexAttribDataCreateDescriptor(morphAttribDataPtr, (a3_VertexAttributeName)attribName, morphTargetsData[morphModelIndex][i].attribData[j * j]);
-		a3vertexAttribDataCreateDescriptor(morphAttribDataPtr, a3attrib_user15, morphTargetsData[morphModelIndex]->attribData[a3attrib_geomTexcoord]);
-
-		a3vertexArrayStore(vao, morphAttribData, morphTargetsData[morphModelIndex]->numVertices, 0, 0);
-		a3indexBufferStore(vbo_ibo, sceneCommonIndexFormat, morphTargetsData[morphModelIndex]->indexData, morphTargetsData[morphModelIndex]->numIndices, 0, &i, 0);
-
-		currentDrawable = demoState->draw_teapot_morph;
-		a3vertexDrawableCreateIndexed(currentDrawable, vao, vbo_ibo, sceneCommonIndexFormat, morphTargetsData[morphModelIndex]->primType, i, morphTargetsData[morphModelIndex]->numIndices);
+		demoState->objectDQ_character = (a3dualquat *)malloc(sizeof(a3dualquat) * characterNodeCount * 3);
+		if (demoState->objectDQ_character && a3spatialPoseSoACreate(demoState->pose_character, characterNodeCount) > 0)
+		{
+			demoState->bindInverseDQ_character = demoState->objectDQ_character + characterNodeCount;
+			demoState->skinDQ_character = demoState->bindInverseDQ_character + characterNodeCount;
+			a3spatialPoseSoACopy(demoState->pose_character, 0, &demoState->poseGroup_character->pose, 0, characterNodeCount);
+			a3kinematicsSolveForwardDualQuatSoA(demoState->hierarchy_character, demoState->objectDQ_character, demoState->pose_character, 0);
+			a3kinematicsInvertDualQuat(demoState->bindInverseDQ_character, demoState->objectDQ_character, characterNodeCount);
+			a3kinematicsUpdateSkinPaletteDualQuat(demoState->hierarchy_character, demoState->skinDQ_character, demoState->objectDQ_character, demoState->bindInverseDQ_character);
+		}
 	}
-	
+	a3bufferCreate(demoState->ubo_transformBlend, "ubo:transform-blend", a3buffer_uniform, sizeof(a3dualquat) * demoStateMaxCount_skinJoint, 0);
+	if (demoState->skinDQ_character)
+		a3bufferRefill(demoState->ubo_transformBlend, 0, sizeof(a3dualquat) * (characterNodeCount < demoStateMaxCount_skinJoint ? characterNodeCount : demoStateMaxCount_skinJoint), demoState->skinDQ_character);
+
 
 	// release data when done
 	for (i = 0; i < displayShapesCount; ++i)
@@ -415,6 +564,13 @@ void a3demo_loadGeometry(a3_DemoState *demoState)
 	for (i = 0; i < morphModelsCount; ++i)
 		for (j = 0; j < morphTargetsPerModel; ++j)
 			a3geometryReleaseData(morphTargetsData[i] + j);
+	for (i = 0; i < morphModelsCount; ++i)
+		a3morphTargetPackRelease(morphTargetsPack + i);
+	for (i = 0; i < skinWeightsCount; ++i)
+		a3skinWeightsRelease(skinWeightsData + i);
+	for (i = 0; i < skinnedModelsCount; ++i)
+		a3geometryReleaseData(skinnedModelsData + i);
+	free(characterNodeNames);
 
 
 	// dummy
@@ -471,11 +627,10 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 			a3_DemoStateShader
 				passTexcoord_transform_vs[1],
 				passTangentBasis_transform_vs[1],
-				passTangentBasis_morph5_transform_vs[1],
-			//	passTangentBasis_skin_transform_vs[1],
+				passTangentBasis_morph_transform_vs[1],
+				passTangentBasis_skin_transform_vs[1],
 				passTexcoord_transform_instanced_vs[1],
-				passTangentBasis_transform_instanced_vs[1],
-				passTangentBasis_morph5_transform_instanced_vs[1];//,
+				passTangentBasis_transform_instanced_vs[1];//,
 			//	passTangentBasis_skin_transform_instanced_vs[1];
 
 			// geometry shaders
@@ -509,14 +664,10 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 			// 00-common
 			{ { { 0 },	"shdr-vs:pass-tex-trans",			a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/e/passTexcoord_transform_vs4x.glsl" } } },
 			{ { { 0 },	"shdr-vs:pass-tb-trans",			a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/e/passTangentBasis_transform_vs4x.glsl" } } },
-			{ { { 0 },	"shdr-vs:pass-tb-morph5-t",			a3shader_vertex  ,	2,{ A3_DEMO_VS"00-common/passTangentBasis_morph5_transform_vs4x.glsl",
-																					A3_DEMO_VS"00-common/utilCommon_vs4x.glsl",} } },
-		//	{ { { 0 },	"shdr-vs:pass-tb-skin-t",			a3shader_vertex  ,	2,{ A3_DEMO_VS"00-common/e/passTangentBasis_skin_transform_vs4x.glsl",
-		//																			A3_DEMO_VS"00-common/e/utilCommon_vs4x.glsl",} } },
+			{ { { 0 },	"shdr-vs:pass-tb-morph-t",			a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/passTangentBasis_morph_transform_vs4x.glsl" } } },
+			{ { { 0 },	"shdr-vs:pass-tb-skin-t",			a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/passTangentBasis_skin_transform_vs4x.glsl" } } },
 			{ { { 0 },	"shdr-vs:pass-tex-trans-inst",		a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/e/passTexcoord_transform_instanced_vs4x.glsl" } } },
 			{ { { 0 },	"shdr-vs:pass-tb-trans-inst",		a3shader_vertex  ,	1,{ A3_DEMO_VS"00-common/e/passTangentBasis_transform_instanced_vs4x.glsl" } } },
-			{ { { 0 },	"shdr-vs:pass-tb-morph5-t-inst",	a3shader_vertex  ,	2,{ A3_DEMO_VS"00-common/e/passTangentBasis_morph5_transform_instanced_vs4x.glsl",
-																					A3_DEMO_VS"00-common/e/utilCommon_vs4x.glsl",} } },
 		//	{ { { 0 },	"shdr-vs:pass-tb-skin-t-inst",		a3shader_vertex  ,	2,{ A3_DEMO_VS"00-common/e/passTangentBasis_skin_transform_instanced_vs4x.glsl",
 		//																			A3_DEMO_VS"00-common/e/utilCommon_vs4x.glsl",} } },
 
@@ -624,15 +775,15 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Phong-inst");
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_transform_instanced_vs->shader);
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawPhong_fs->shader);
-	// Phong for 5-target morphing
-	currentDemoProg = demoState->prog_drawPhong_morph5;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Phong-morph5");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_morph5_transform_vs->shader);
+	// Phong for sparse weighted morphing
+	currentDemoProg = demoState->prog_drawPhong_morph;
+	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Phong-morph");
+	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_morph_transform_vs->shader);
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawPhong_fs->shader);
-	// Phong for 5-target morphing with instancing
-	currentDemoProg = demoState->prog_drawPhong_morph5_instanced;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Phong-morph5-inst");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_morph5_transform_instanced_vs->shader);
+	// Phong for dual quaternion skinning
+	currentDemoProg = demoState->prog_drawPhong_skin;
+	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-Phong-skin");
+	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_skin_transform_vs->shader);
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawPhong_fs->shader);
 
 	// tangent basis
@@ -647,16 +798,10 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_transform_instanced_vs->shader);
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawTangentBasis_gs->shader);
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawColorAttrib_fs->shader);
-	// tangent basis for 5-target morphing
-	currentDemoProg = demoState->prog_drawTangentBasis_morph5;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-tb-morph5");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_morph5_transform_vs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawTangentBasis_gs->shader);
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawColorAttrib_fs->shader);
-	// tangent basis for 5-target morphing with instancing
-	currentDemoProg = demoState->prog_drawTangentBasis_morph5_instanced;
-	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-tb-morph5-inst");
-	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_morph5_transform_instanced_vs->shader);
+	// tangent basis for sparse weighted morphing
+	currentDemoProg = demoState->prog_drawTangentBasis_morph;
+	a3shaderProgramCreate(currentDemoProg->program, "prog:draw-tb-morph");
+	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.passTangentBasis_morph_transform_vs->shader);
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawTangentBasis_gs->shader);
 	a3shaderProgramAttachShader(currentDemoProg->program, shaderList.drawColorAttrib_fs->shader);
 
@@ -736,10 +881,14 @@ void a3demo_loadShaders(a3_DemoState *demoState)
 		a3demo_setUniformDefaultVec4(currentDemoProg, uColor0, a3vec4_one.v);
 		a3demo_setUniformDefaultVec4(currentDemoProg, uColor, a3vec4_one.v);
 
+		// animation
+		a3demo_setUniformDefaultFloat(currentDemoProg, uMorphWeight, defaultFloat);
+
 		// transformation uniform blocks
 		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformStack, 0);
 		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformMVP, 0);
 		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformMVPB, 1);
+		a3demo_setUniformDefaultBlock(currentDemoProg, ubTransformBlend, 2);
 	}
 
 
@@ -812,6 +961,25 @@ void a3demo_loadTextures(a3_DemoState* demoState)
 		a3textureChangeRepeatMode(a3tex_repeatClamp, a3tex_repeatClamp);	// clamp both axes
 	}
 
+	// morph target data: built from geometry, read with texel fetches
+	if (demoState->morph_teapot->numEntries)
+	{
+		a3_TexturePixelFormatDescriptor pixelFormat[1];
+		const a3ui32 width = a3morph_textureWidth, height = a3morphTargetGetTextureHeight(demoState->morph_teapot, width);
+		a3f32 *texels = (a3f32 *)malloc(sizeof(a3f32) * 4 * width * height);
+		if (texels)
+		{
+			a3morphTargetStoreTexture(demoState->morph_teapot, texels, width);
+			a3textureCreatePixelFormatDescriptor(pixelFormat, a3tex_rgba32F);
+			a3textureCreateFromData(demoState->tex_morph_teapot, "tex:morph-teapot", pixelFormat, width, height, texels, 0);
+			a3textureActivate(demoState->tex_morph_teapot, a3tex_unit00);
+			a3textureDefaultSettings();
+			a3textureChangeFilterMode(a3tex_filterNearest);
+			a3textureChangeRepeatMode(a3tex_repeatClamp, a3tex_repeatClamp);
+			free(texels);
+		}
+	}
+
 
 	// done
 	a3textureDeactivate(a3tex_unit00);
@@ -940,10 +1108,14 @@ void a3demo_loadValidate(a3_DemoState* demoState)
 	a3_refreshDrawable_internal(demoState->draw_unit_torus, currentVAO, currentBuff);
 	a3_refreshDrawable_internal(demoState->draw_teapot, currentVAO, currentBuff);
 
-	currentVAO = demoState->vao_tangentbasis_texcoord_morph5;
+	currentVAO = demoState->vao_tangentbasis_texcoord_morph;
 	currentVAO->vertexBuffer = currentBuff;
 	a3_refreshDrawable_internal(demoState->draw_teapot_morph, currentVAO, currentBuff);
 
+	currentVAO = demoState->vao_tangentbasis_texcoord_skin;
+	currentVAO->vertexBuffer = currentBuff;
+	a3_refreshDrawable_internal(demoState->draw_character_skin, currentVAO, currentBuff);
+
 	a3demo_initDummyDrawable_internal(demoState);
 }
 
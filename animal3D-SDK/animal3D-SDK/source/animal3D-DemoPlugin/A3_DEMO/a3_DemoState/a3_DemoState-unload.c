@@ -33,6 +33,7 @@
 #include "../a3_DemoState.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 
 
 //-----------------------------------------------------------------------------
@@ -56,6 +57,15 @@ void a3demo_unloadGeometry(a3_DemoState* demoState)
 		a3vertexArrayReleaseDescriptor(currentVAO++);
 	while (currentDraw < endDraw)
 		a3vertexDrawableRelease(currentDraw++);
+
+	a3morphTargetSetRelease(demoState->morph_teapot);
+
+	// skinned character: palette arrays are one allocation
+	free(demoState->objectDQ_character);
+	demoState->objectDQ_character = demoState->bindInverseDQ_character = demoState->skinDQ_character = 0;
+	a3spatialPoseSoARelease(demoState->pose_character);
+	a3hierarchyPoseGroupRelease(demoState->poseGroup_character);
+	a3hierarchyRelease(demoState->hierarchy_character);
 }
 
 // utility to unload shaders